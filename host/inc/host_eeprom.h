@@ -0,0 +1,30 @@
+/*
+ * host_eeprom.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include <setjmp.h>
+
+/*** HOST EEPROM macros ***/
+
+#define HOST_EEPROM_ENDURANCE_CYCLES	100000 // STM32L0 data EEPROM endurance (datasheet minimum at 85 degrees).
+
+/*** HOST EEPROM global variables ***/
+
+extern unsigned char* host_eeprom_data;
+
+/*** HOST EEPROM functions ***/
+
+int HOST_EEPROM_Open(const char* file_name, unsigned int size_bytes);
+void HOST_EEPROM_Close(void);
+void HOST_EEPROM_ArmTornWrite(unsigned long long program_index, jmp_buf* reset_point);
+unsigned long long HOST_EEPROM_GetProgramCount(void);
+unsigned short HOST_EEPROM_GetTornAddressOffset(void);
+unsigned int HOST_EEPROM_GetCycleCount(unsigned short address_offset);
+
+#endif /* HOST_EEPROM_H */
@@ -0,0 +1,52 @@
+/*
+ * host_radio.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef HOST_RADIO_H
+#define HOST_RADIO_H
+
+/*** HOST RADIO macros ***/
+
+#define HOST_RADIO_EVENT_LOG_LENGTH			8192
+#define HOST_RADIO_INTERRUPT_LOG_LENGTH		4096
+#define HOST_RADIO_SPI_BYTE_DURATION_NS		2500 // 4MHz SPI clock and polling of the data register.
+
+/*** HOST RADIO structures ***/
+
+// Signal changes recorded during a transmission.
+typedef enum {
+	HOST_RADIO_EVENT_FREQUENCY, // FRF LSB written (value is the FRF register, frequency is the exact synthesizer frequency).
+	HOST_RADIO_EVENT_DIO2, // SX1232 OOK data input.
+	HOST_RADIO_EVENT_UPDATE, // TIM2 overflow (symbol boundary).
+	HOST_RADIO_EVENT_STATE // RADIO_SetState call.
+} HOST_RADIO_EventType;
+
+typedef struct {
+	unsigned long long host_radio_event_time_ns;
+	HOST_RADIO_EventType host_radio_event_type;
+	unsigned int host_radio_event_value;
+	double host_radio_event_frequency_hz;
+} HOST_RADIO_Event;
+
+// TIM2 interrupt servicing.
+typedef struct {
+	unsigned char host_radio_interrupt_timing_idx; // Event which triggered the interrupt (TIM2_TIMINGS_ARRAY_xxx_IDX).
+	unsigned long long host_radio_interrupt_event_time_ns; // Flag set by the timer.
+	unsigned long long host_radio_interrupt_start_time_ns; // Handler entry.
+	unsigned long long host_radio_interrupt_end_time_ns; // Handler exit.
+} HOST_RADIO_Interrupt;
+
+/*** HOST RADIO functions ***/
+
+void HOST_RADIO_Init(unsigned int latency_min_us, unsigned int latency_max_us);
+void HOST_RADIO_ClearLogs(void);
+unsigned int HOST_RADIO_GetEventCount(void);
+const HOST_RADIO_Event* HOST_RADIO_GetEvents(void);
+unsigned int HOST_RADIO_GetInterruptCount(void);
+const HOST_RADIO_Interrupt* HOST_RADIO_GetInterrupts(void);
+unsigned char HOST_RADIO_GetOverflow(void);
+
+#endif /* HOST_RADIO_H */
@@ -0,0 +1,50 @@
+/*
+ * tim_reg.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef TIM_REG_H
+#define TIM_REG_H
+
+// Host substitute of inc/registers/tim_reg.h: TIM2 is emulated (every access synchronizes the counter
+// with the simulated time), TIM21 and TIM22 are plain variables.
+
+/*** TIMx registers ***/
+
+typedef struct {
+	volatile unsigned int CR1;    	// Control register 1.
+	volatile unsigned int CR2;    	// Control register 2.
+	volatile unsigned int SMCR;    	// Slave mode controler register (!)
+	volatile unsigned int DIER;    	// DMA interrupt enable register.
+	volatile unsigned int SR;    	// Status register.
+	volatile unsigned int EGR;    	// Event generation register.
+	volatile unsigned int CCMR1;    // Capture/compare mode register 1 (!).
+	volatile unsigned int CCMR2;    // Capture/compare mode register 2 (!).
+	volatile unsigned int CCER;    	// Capture/compare enable register (!).
+	volatile unsigned int CNT;    	// Counter register.
+	volatile unsigned int PSC;    	// Prescaler register.
+	volatile unsigned int ARR;    	// Auto-reload register.
+	unsigned int RESERVED0;    		// Reserved 0x30.
+	volatile unsigned int CCR1;    	// Capture/compare register 1 (!).
+	volatile unsigned int CCR2;    	// Capture/compare register 2 (!).
+	volatile unsigned int CCR3;    	// Capture/compare register 3 (!).
+	volatile unsigned int CCR4;    	// Capture/compare register 4 (!).
+	unsigned int RESERVED1;    		// Reserved 0x44
+	volatile unsigned int DCR;    	// DMA control register (!).
+	volatile unsigned int DMAR;    	// DMA address for full transfer register (!).
+	volatile unsigned int OR;    	// Option register (!).
+} TIM_BaseAddress;
+
+TIM_BaseAddress* HOST_RADIO_Tim2Access(void);
+extern TIM_BaseAddress host_tim21;
+extern TIM_BaseAddress host_tim22;
+
+/*** TIMx base addresses ***/
+
+#define TIM2	(HOST_RADIO_Tim2Access())
+#define TIM21	(&host_tim21)
+#define TIM22	(&host_tim22)
+
+#endif /* TIM_REG_H */
@@ -0,0 +1,135 @@
+/*
+ * aes_sim.c
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "crypto.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Host check of the software AES-128 CBC used when the AES peripheral is not available: crypto.c is checked
+// against the FIPS-197 appendix C.1 and SP800-38A appendix F.2.1 vectors, then its throughput is measured.
+
+/*** AES SIM macros ***/
+
+#define AES_SIM_DEFAULT_CALLS			200000
+#define AES_SIM_CBC_VECTOR_BLOCKS		4
+#define AES_SIM_BENCHMARK_BLOCKS_MAX	16
+
+/*** AES SIM structures ***/
+
+typedef struct {
+	const char* aes_sim_name;
+	unsigned char aes_sim_key[CRYPTO_AES_BLOCK_SIZE];
+	unsigned char aes_sim_init_vector[CRYPTO_AES_BLOCK_SIZE];
+	unsigned char aes_sim_number_of_blocks;
+	unsigned char aes_sim_plaintext[AES_SIM_CBC_VECTOR_BLOCKS * CRYPTO_AES_BLOCK_SIZE];
+	unsigned char aes_sim_ciphertext[AES_SIM_CBC_VECTOR_BLOCKS * CRYPTO_AES_BLOCK_SIZE];
+} AES_SIM_Vector;
+
+/*** AES SIM local global variables ***/
+
+static const AES_SIM_Vector aes_sim_vectors[] = {
+	// FIPS-197 appendix C.1 (one block with a null IV is the plain cipher).
+	{"FIPS-197 C.1",
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F},
+	{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+	1,
+	{0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF},
+	{0x69, 0xC4, 0xE0, 0xD8, 0x6A, 0x7B, 0x04, 0x30, 0xD8, 0xCD, 0xB7, 0x80, 0x70, 0xB4, 0xC5, 0x5A}},
+	// SP800-38A appendix F.2.1 (CBC-AES128.Encrypt).
+	{"SP800-38A F.2.1",
+	{0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C},
+	{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F},
+	4,
+	{0x6B, 0xC1, 0xBE, 0xE2, 0x2E, 0x40, 0x9F, 0x96, 0xE9, 0x3D, 0x7E, 0x11, 0x73, 0x93, 0x17, 0x2A,
+	 0xAE, 0x2D, 0x8A, 0x57, 0x1E, 0x03, 0xAC, 0x9C, 0x9E, 0xB7, 0x6F, 0xAC, 0x45, 0xAF, 0x8E, 0x51,
+	 0x30, 0xC8, 0x1C, 0x46, 0xA3, 0x5C, 0xE4, 0x11, 0xE5, 0xFB, 0xC1, 0x19, 0x1A, 0x0A, 0x52, 0xEF,
+	 0xF6, 0x9F, 0x24, 0x45, 0xDF, 0x4F, 0x9B, 0x17, 0xAD, 0x2B, 0x41, 0x7B, 0xE6, 0x6C, 0x37, 0x10},
+	{0x76, 0x49, 0xAB, 0xAC, 0x81, 0x19, 0xB2, 0x46, 0xCE, 0xE9, 0x8E, 0x9B, 0x12, 0xE9, 0x19, 0x7D,
+	 0x50, 0x86, 0xCB, 0x9B, 0x50, 0x72, 0x19, 0xEE, 0x95, 0xDB, 0x11, 0x3A, 0x91, 0x76, 0x78, 0xB2,
+	 0x73, 0xBE, 0xD6, 0xB8, 0xE3, 0xC1, 0x74, 0x3B, 0x71, 0x16, 0xE6, 0x9E, 0x22, 0x22, 0x95, 0x16,
+	 0x3F, 0xF1, 0xCA, 0xA1, 0x68, 0x1F, 0xAC, 0x09, 0x12, 0x0E, 0xCA, 0x30, 0x75, 0x86, 0xE1, 0xA7}}
+};
+
+/*** AES SIM local functions ***/
+
+/* CHECK ONE TEST VECTOR WITH SEPARATE AND IN-PLACE BUFFERS.
+ * @param vector:	Test vector.
+ * @return:			Number of failed checks.
+ */
+static unsigned int AES_SIM_CheckVector(const AES_SIM_Vector* vector) {
+	// Local variables.
+	unsigned char data_in[AES_SIM_CBC_VECTOR_BLOCKS * CRYPTO_AES_BLOCK_SIZE];
+	unsigned char data_out[AES_SIM_CBC_VECTOR_BLOCKS * CRYPTO_AES_BLOCK_SIZE];
+	unsigned char key[CRYPTO_AES_BLOCK_SIZE];
+	unsigned char init_vector[CRYPTO_AES_BLOCK_SIZE];
+	unsigned int size_bytes = vector -> aes_sim_number_of_blocks * CRYPTO_AES_BLOCK_SIZE;
+	unsigned int errors = 0;
+	memcpy(key, vector -> aes_sim_key, CRYPTO_AES_BLOCK_SIZE);
+	memcpy(init_vector, vector -> aes_sim_init_vector, CRYPTO_AES_BLOCK_SIZE);
+	// Separate buffers.
+	memcpy(data_in, vector -> aes_sim_plaintext, size_bytes);
+	CRYPTO_AesEncodeCbc(data_in, data_out, vector -> aes_sim_number_of_blocks, init_vector, key);
+	if (memcmp(data_out, vector -> aes_sim_ciphertext, size_bytes) != 0) errors++;
+	// In-place encryption (used by MCU_API_aes_128_cbc_encrypt).
+	CRYPTO_AesEncodeCbc(data_in, data_in, vector -> aes_sim_number_of_blocks, init_vector, key);
+	if (memcmp(data_in, vector -> aes_sim_ciphertext, size_bytes) != 0) errors++;
+	printf("%-16s %u block(s): %s\n", vector -> aes_sim_name, vector -> aes_sim_number_of_blocks, (errors == 0) ? "OK" : "FAILED");
+	return errors;
+}
+
+/* MEASURE THE THROUGHPUT OF THE SOFTWARE AES.
+ * @param number_of_blocks:	Number of blocks per call (key expansion is performed once per call).
+ * @param calls:			Number of calls.
+ * @return:					None.
+ */
+static void AES_SIM_Benchmark(unsigned char number_of_blocks, unsigned int calls) {
+	// Local variables.
+	unsigned char data[AES_SIM_BENCHMARK_BLOCKS_MAX * CRYPTO_AES_BLOCK_SIZE] = {0};
+	unsigned char key[CRYPTO_AES_BLOCK_SIZE] = {0};
+	unsigned char init_vector[CRYPTO_AES_BLOCK_SIZE] = {0};
+	struct timespec start_time;
+	struct timespec end_time;
+	unsigned int call_idx = 0;
+	double duration_s = 0.0;
+	// Output is encrypted again so that no call can be skipped.
+	clock_gettime(CLOCK_MONOTONIC, &start_time);
+	for (call_idx=0 ; call_idx<calls ; call_idx++) {
+		CRYPTO_AesEncodeCbc(data, data, number_of_blocks, init_vector, key);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end_time);
+	duration_s = (double) (end_time.tv_sec - start_time.tv_sec) + ((double) (end_time.tv_nsec - start_time.tv_nsec) / 1e9);
+	printf("%2u block(s) per call: %.0f blocks/s (%.0f ns per block, last byte 0x%02X).\n", number_of_blocks, ((double) calls * number_of_blocks) / duration_s, (duration_s * 1e9) / ((double) calls * number_of_blocks), data[(number_of_blocks * CRYPTO_AES_BLOCK_SIZE) - 1]);
+}
+
+/*** AES SIM main function ***/
+
+/* MAIN FUNCTION.
+ * @param argc:	Number of arguments.
+ * @param argv:	Options: -n <calls_per_benchmark>.
+ * @return:		0 if all checks passed, 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+	// Local variables.
+	unsigned int calls = AES_SIM_DEFAULT_CALLS;
+	unsigned int errors = 0;
+	unsigned int vector_idx = 0;
+	int arg_idx = 0;
+	// Parse options.
+	for (arg_idx=1 ; (arg_idx + 1)<argc ; arg_idx+=2) {
+		if (strcmp(argv[arg_idx], "-n") == 0) calls = atoi(argv[arg_idx + 1]);
+	}
+	// Known answer tests.
+	for (vector_idx=0 ; vector_idx<(sizeof(aes_sim_vectors) / sizeof(AES_SIM_Vector)) ; vector_idx++) {
+		errors += AES_SIM_CheckVector(&(aes_sim_vectors[vector_idx]));
+	}
+	// Throughput on the host CPU: single block calls (key expansion included in each block) and long buffers.
+	AES_SIM_Benchmark(1, calls);
+	AES_SIM_Benchmark(AES_SIM_BENCHMARK_BLOCKS_MAX, (calls / AES_SIM_BENCHMARK_BLOCKS_MAX));
+	return (errors == 0) ? 0 : 1;
+}
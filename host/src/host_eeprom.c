@@ -0,0 +1,221 @@
+/*
+ * host_eeprom.c
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "host_eeprom.h"
+
+#include "flash_reg.h"
+#include "rcc_reg.h"
+#include <fcntl.h>
+#include <setjmp.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/*** HOST EEPROM local macros ***/
+
+#define HOST_EEPROM_WORD_SIZE_BYTES		4
+#define HOST_EEPROM_CYCLES_FILE_SUFFIX	".cycles"
+
+/*** HOST EEPROM local structures ***/
+
+typedef struct {
+	int host_eeprom_fd;
+	unsigned int host_eeprom_size_bytes;
+	unsigned int host_eeprom_map_size_bytes;
+	char host_eeprom_cycles_file_name[256];
+	unsigned int* host_eeprom_cycles; // Program operations per word.
+	unsigned long long host_eeprom_program_count;
+	// Write detected by the protection fault and not committed yet.
+	unsigned char host_eeprom_write_pending;
+	unsigned int host_eeprom_write_word_idx;
+	unsigned int host_eeprom_write_old_word;
+	// Torn write injection.
+	unsigned long long host_eeprom_torn_program_index; // 0 means disabled.
+	unsigned short host_eeprom_torn_address_offset; // Word of the last torn write.
+	jmp_buf* host_eeprom_reset_point;
+} HOST_EEPROM_Context;
+
+/*** HOST EEPROM global variables ***/
+
+unsigned char* host_eeprom_data = NULL;
+RCC_BaseAddress host_rcc;
+
+/*** HOST EEPROM local global variables ***/
+
+static HOST_EEPROM_Context host_eeprom_ctx;
+static FLASH_BaseAddress host_flash;
+
+/*** HOST EEPROM local functions ***/
+
+/* PROTECT OR UNPROTECT EEPROM AGAINST WRITE ACCESS.
+ * @param writable:	1 to allow write access, 0 to detect the next write.
+ * @return:			None.
+ */
+static void HOST_EEPROM_SetWritable(unsigned char writable) {
+	mprotect(host_eeprom_data, host_eeprom_ctx.host_eeprom_map_size_bytes, (writable != 0) ? (PROT_READ | PROT_WRITE) : PROT_READ);
+}
+
+/* MEMORY PROTECTION FAULT HANDLER (CALLED ON THE FIRST WRITE OF A PROGRAM OPERATION).
+ * @param sig:		Signal number.
+ * @param info:		Fault information.
+ * @param context:	Unused.
+ * @return:			None.
+ */
+static void HOST_EEPROM_FaultHandler(int sig, siginfo_t* info, void* context) {
+	unsigned long address = (unsigned long) (info -> si_addr);
+	unsigned long start = (unsigned long) host_eeprom_data;
+	(void) context;
+	// Faults outside EEPROM are real errors.
+	if ((host_eeprom_data == NULL) || (address < start) || (address >= (start + host_eeprom_ctx.host_eeprom_size_bytes))) {
+		signal(sig, SIG_DFL);
+		return;
+	}
+	// Save word content before programming and let the instruction complete.
+	host_eeprom_ctx.host_eeprom_write_pending = 1;
+	host_eeprom_ctx.host_eeprom_write_word_idx = (address - start) / HOST_EEPROM_WORD_SIZE_BYTES;
+	host_eeprom_ctx.host_eeprom_write_old_word = ((unsigned int*) host_eeprom_data)[host_eeprom_ctx.host_eeprom_write_word_idx];
+	HOST_EEPROM_SetWritable(1);
+}
+
+/* LOAD OR SAVE PER WORD CYCLE COUNTS.
+ * @param save:	1 to save counts, 0 to load them.
+ * @return:		None.
+ */
+static void HOST_EEPROM_TransferCycles(unsigned char save) {
+	FILE* cycles_file = fopen(host_eeprom_ctx.host_eeprom_cycles_file_name, (save != 0) ? "wb" : "rb");
+	unsigned int number_of_words = host_eeprom_ctx.host_eeprom_size_bytes / HOST_EEPROM_WORD_SIZE_BYTES;
+	if (cycles_file == NULL) return;
+	if (save != 0) {
+		fwrite(host_eeprom_ctx.host_eeprom_cycles, sizeof(unsigned int), number_of_words, cycles_file);
+	}
+	else {
+		if (fread(host_eeprom_ctx.host_eeprom_cycles, sizeof(unsigned int), number_of_words, cycles_file) != number_of_words) {
+			memset(host_eeprom_ctx.host_eeprom_cycles, 0, number_of_words * sizeof(unsigned int));
+		}
+	}
+	fclose(cycles_file);
+}
+
+/*** HOST EEPROM functions ***/
+
+/* MAP EEPROM ON A FILE (CREATED ERASED IF IT DOES NOT EXIST).
+ * @param file_name:	EEPROM image file.
+ * @param size_bytes:	EEPROM size.
+ * @return status:		0 in case of success, -1 otherwise.
+ */
+int HOST_EEPROM_Open(const char* file_name, unsigned int size_bytes) {
+	// Local variables.
+	struct sigaction fault_action;
+	long page_size = sysconf(_SC_PAGESIZE);
+	// Init context.
+	memset(&host_eeprom_ctx, 0, sizeof(HOST_EEPROM_Context));
+	host_eeprom_ctx.host_eeprom_size_bytes = size_bytes;
+	host_eeprom_ctx.host_eeprom_map_size_bytes = ((size_bytes + page_size - 1) / page_size) * page_size;
+	snprintf(host_eeprom_ctx.host_eeprom_cycles_file_name, sizeof(host_eeprom_ctx.host_eeprom_cycles_file_name), "%s%s", file_name, HOST_EEPROM_CYCLES_FILE_SUFFIX);
+	// Erased EEPROM reads 0x00.
+	host_eeprom_ctx.host_eeprom_fd = open(file_name, (O_RDWR | O_CREAT), 0644);
+	if ((host_eeprom_ctx.host_eeprom_fd < 0) || (ftruncate(host_eeprom_ctx.host_eeprom_fd, size_bytes) != 0)) {
+		return -1;
+	}
+	host_eeprom_data = mmap(NULL, host_eeprom_ctx.host_eeprom_map_size_bytes, PROT_READ, MAP_SHARED, host_eeprom_ctx.host_eeprom_fd, 0);
+	if (host_eeprom_data == MAP_FAILED) {
+		host_eeprom_data = NULL;
+		return -1;
+	}
+	// Cycle counts.
+	host_eeprom_ctx.host_eeprom_cycles = calloc(size_bytes / HOST_EEPROM_WORD_SIZE_BYTES, sizeof(unsigned int));
+	HOST_EEPROM_TransferCycles(0);
+	// Detect program operations with write protection faults.
+	memset(&fault_action, 0, sizeof(fault_action));
+	fault_action.sa_sigaction = HOST_EEPROM_FaultHandler;
+	fault_action.sa_flags = SA_SIGINFO | SA_NODEFER;
+	sigemptyset(&fault_action.sa_mask);
+	sigaction(SIGSEGV, &fault_action, NULL);
+	// NVM interface is locked after reset.
+	host_flash.PECR = (0b1 << 0);
+	return 0;
+}
+
+/* SAVE CYCLE COUNTS AND UNMAP EEPROM.
+ * @param:	None.
+ * @return:	None.
+ */
+void HOST_EEPROM_Close(void) {
+	HOST_EEPROM_TransferCycles(1);
+	msync(host_eeprom_data, host_eeprom_ctx.host_eeprom_map_size_bytes, MS_SYNC);
+	munmap(host_eeprom_data, host_eeprom_ctx.host_eeprom_map_size_bytes);
+	close(host_eeprom_ctx.host_eeprom_fd);
+	free(host_eeprom_ctx.host_eeprom_cycles);
+	host_eeprom_data = NULL;
+}
+
+/* INTERRUPT A FUTURE PROGRAM OPERATION.
+ * @param program_index:	Index of the program operation to tear (compared to HOST_EEPROM_GetProgramCount, 0 to disable).
+ * @param reset_point:		Context restored after the torn write (emulates a MCU reset).
+ * @return:					None.
+ */
+void HOST_EEPROM_ArmTornWrite(unsigned long long program_index, jmp_buf* reset_point) {
+	host_eeprom_ctx.host_eeprom_torn_program_index = program_index;
+	host_eeprom_ctx.host_eeprom_reset_point = reset_point;
+}
+
+/* GET THE NUMBER OF PROGRAM OPERATIONS SINCE EEPROM WAS OPENED.
+ * @param:	None.
+ * @return:	Number of program operations.
+ */
+unsigned long long HOST_EEPROM_GetProgramCount(void) {
+	return host_eeprom_ctx.host_eeprom_program_count;
+}
+
+/* GET THE ADDRESS OF THE LAST TORN WRITE.
+ * @param:	None.
+ * @return:	Address offset of the word which was being programmed when reset occured.
+ */
+unsigned short HOST_EEPROM_GetTornAddressOffset(void) {
+	return host_eeprom_ctx.host_eeprom_torn_address_offset;
+}
+
+/* GET THE NUMBER OF PROGRAM OPERATIONS OF THE WORD CONTAINING AN ADDRESS.
+ * @param address_offset:	Address offset starting from EEPROM start address.
+ * @return:					Number of program operations (accumulated over all runs using the same file).
+ */
+unsigned int HOST_EEPROM_GetCycleCount(unsigned short address_offset) {
+	return host_eeprom_ctx.host_eeprom_cycles[address_offset / HOST_EEPROM_WORD_SIZE_BYTES];
+}
+
+/* FLASH REGISTERS ACCESS (COMMITS THE PENDING PROGRAM OPERATION).
+ * @param:	None.
+ * @return:	Emulated FLASH registers.
+ */
+FLASH_BaseAddress* HOST_EEPROM_FlashAccess(void) {
+	// Local variables.
+	unsigned int* word = NULL;
+	unsigned int mask = 0;
+	if (host_eeprom_ctx.host_eeprom_write_pending != 0) {
+		host_eeprom_ctx.host_eeprom_write_pending = 0;
+		host_eeprom_ctx.host_eeprom_cycles[host_eeprom_ctx.host_eeprom_write_word_idx]++;
+		host_eeprom_ctx.host_eeprom_program_count++;
+		if (host_eeprom_ctx.host_eeprom_program_count == host_eeprom_ctx.host_eeprom_torn_program_index) {
+			// Keep a random mix of old and new bits, then reset.
+			word = &(((unsigned int*) host_eeprom_data)[host_eeprom_ctx.host_eeprom_write_word_idx]);
+			mask = (unsigned int) rand();
+			(*word) = ((*word) & mask) | (host_eeprom_ctx.host_eeprom_write_old_word & ~mask);
+			host_eeprom_ctx.host_eeprom_torn_program_index = 0;
+			host_eeprom_ctx.host_eeprom_torn_address_offset = host_eeprom_ctx.host_eeprom_write_word_idx * HOST_EEPROM_WORD_SIZE_BYTES;
+			HOST_EEPROM_SetWritable(0);
+			host_flash.PECR = (0b1 << 0);
+			longjmp(*(host_eeprom_ctx.host_eeprom_reset_point), 1);
+		}
+		HOST_EEPROM_SetWritable(0);
+	}
+	// Program operations complete immediately.
+	host_flash.SR = 0;
+	return &host_flash;
+}
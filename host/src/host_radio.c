@@ -0,0 +1,516 @@
+/*
+ * host_radio.c
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "host_radio.h"
+
+#include "airtime.h"
+#include "exti.h"
+#include "gpio.h"
+#include "iwdg.h"
+#include "lptim.h"
+#include "mapping.h"
+#include "nvic.h"
+#include "nvm.h"
+#include "pwr.h"
+#include "radio.h"
+#include "rcc.h"
+#include "rcc_reg.h"
+#include "rtc.h"
+#include "spi.h"
+#include "sx1232_reg.h"
+#include "tim.h"
+#include "tim_reg.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*** HOST RADIO local macros ***/
+
+#define HOST_RADIO_SYSCLK_KHZ				16000
+#define HOST_RADIO_SX1232_REGISTERS_NUMBER	128
+#define HOST_RADIO_SX1232_FXOSC_HZ			32000000.0
+#define HOST_RADIO_TIM2_SR_MASK				0x0000001F
+#define HOST_RADIO_TIM2_CHANNELS_NUMBER		4
+#define HOST_RADIO_SLEEP_TIMEOUT_NS			60000000000ULL // No TIM2 interrupt within 1 minute means the frame is stuck.
+
+/*** HOST RADIO local structures ***/
+
+typedef struct {
+	// Simulated time.
+	unsigned long long host_radio_time_ns;
+	unsigned int host_radio_latency_min_us;
+	unsigned int host_radio_latency_max_us;
+	// TIM2 emulation (one tick per microsecond).
+	unsigned char host_radio_tim2_running;
+	unsigned long long host_radio_tim2_next_tick_ns;
+	unsigned long long host_radio_tim2_flag_time_ns[HOST_RADIO_TIM2_CHANNELS_NUMBER + 1];
+	unsigned char host_radio_tim2_nvic_enabled;
+	unsigned char host_radio_in_interrupt;
+	// SX1232 emulation (register file accessed through SPI bursts).
+	unsigned char host_radio_sx1232_registers[HOST_RADIO_SX1232_REGISTERS_NUMBER];
+	unsigned char host_radio_spi_selected;
+	unsigned char host_radio_spi_byte_idx;
+	unsigned char host_radio_spi_write;
+	unsigned char host_radio_spi_address;
+	// Logs.
+	HOST_RADIO_Event host_radio_events[HOST_RADIO_EVENT_LOG_LENGTH];
+	unsigned int host_radio_event_count;
+	HOST_RADIO_Interrupt host_radio_interrupts[HOST_RADIO_INTERRUPT_LOG_LENGTH];
+	unsigned int host_radio_interrupt_count;
+	unsigned char host_radio_overflow;
+	// Other drivers.
+	RADIO_State host_radio_state;
+	unsigned int host_radio_tx_residency_ms;
+} HOST_RADIO_Context;
+
+/*** HOST RADIO external functions ***/
+
+void TIM2_IRQHandler(void); // Defined in rf_api.c.
+
+/*** HOST RADIO global variables ***/
+
+RCC_BaseAddress host_rcc;
+TIM_BaseAddress host_tim21;
+TIM_BaseAddress host_tim22;
+
+/*** HOST RADIO local global variables ***/
+
+static HOST_RADIO_Context host_radio_ctx;
+static TIM_BaseAddress host_tim2;
+
+/*** HOST RADIO local functions ***/
+
+/* APPEND AN EVENT TO THE LOG.
+ * @param type:			Event type.
+ * @param value:		Event value.
+ * @param frequency_hz:	Synthesizer frequency (frequency events only).
+ * @return:				None.
+ */
+static void HOST_RADIO_RecordEvent(HOST_RADIO_EventType type, unsigned int value, double frequency_hz) {
+	HOST_RADIO_Event* event = NULL;
+	if (host_radio_ctx.host_radio_event_count >= HOST_RADIO_EVENT_LOG_LENGTH) {
+		host_radio_ctx.host_radio_overflow = 1;
+		return;
+	}
+	event = &(host_radio_ctx.host_radio_events[host_radio_ctx.host_radio_event_count]);
+	event -> host_radio_event_time_ns = host_radio_ctx.host_radio_time_ns;
+	event -> host_radio_event_type = type;
+	event -> host_radio_event_value = value;
+	event -> host_radio_event_frequency_hz = frequency_hz;
+	host_radio_ctx.host_radio_event_count++;
+}
+
+/* SYNCHRONIZE TIM2 STATE WITH ITS CONTROL REGISTER.
+ * @param:	None.
+ * @return:	None.
+ */
+static void HOST_RADIO_Tim2Synchronize(void) {
+	if ((host_tim2.CR1 & (0b1 << 0)) != 0) {
+		// Counter starts on the next timer clock after CEN is set.
+		if (host_radio_ctx.host_radio_tim2_running == 0) {
+			host_radio_ctx.host_radio_tim2_running = 1;
+			host_radio_ctx.host_radio_tim2_next_tick_ns = host_radio_ctx.host_radio_time_ns + ((host_tim2.PSC + 1) * 1000000ULL) / HOST_RADIO_SYSCLK_KHZ;
+		}
+	}
+	else {
+		host_radio_ctx.host_radio_tim2_running = 0;
+	}
+}
+
+/* PERFORM ONE TIM2 COUNTER CLOCK.
+ * @param:	None.
+ * @return:	None.
+ */
+static void HOST_RADIO_Tim2Tick(void) {
+	// Local variables.
+	unsigned char channel_idx = 0;
+	volatile unsigned int* ccr = &(host_tim2.CCR1);
+	// Upcounting mode: overflow when counter reaches ARR.
+	host_radio_ctx.host_radio_time_ns = host_radio_ctx.host_radio_tim2_next_tick_ns;
+	if ((host_tim2.CNT & 0xFFFF) >= host_tim2.ARR) {
+		host_tim2.CNT = 0;
+		host_tim2.SR |= (0b1 << TIM2_TIMINGS_ARRAY_ARR_IDX);
+		host_radio_ctx.host_radio_tim2_flag_time_ns[TIM2_TIMINGS_ARRAY_ARR_IDX] = host_radio_ctx.host_radio_time_ns;
+		HOST_RADIO_RecordEvent(HOST_RADIO_EVENT_UPDATE, 0, 0.0);
+	}
+	else {
+		host_tim2.CNT++;
+	}
+	// Compare events.
+	for (channel_idx=0 ; channel_idx<HOST_RADIO_TIM2_CHANNELS_NUMBER ; channel_idx++) {
+		if (host_tim2.CNT == ccr[channel_idx]) {
+			host_tim2.SR |= (0b1 << (TIM2_TIMINGS_ARRAY_CCR1_IDX + channel_idx));
+			host_radio_ctx.host_radio_tim2_flag_time_ns[TIM2_TIMINGS_ARRAY_CCR1_IDX + channel_idx] = host_radio_ctx.host_radio_time_ns;
+		}
+	}
+	host_radio_ctx.host_radio_tim2_next_tick_ns += ((host_tim2.PSC + 1) * 1000000ULL) / HOST_RADIO_SYSCLK_KHZ;
+}
+
+/* ADVANCE SIMULATED TIME.
+ * @param duration_ns:	Time spent by the CPU or the SPI.
+ * @return:				None.
+ */
+static void HOST_RADIO_Advance(unsigned long long duration_ns) {
+	unsigned long long target_time_ns = host_radio_ctx.host_radio_time_ns + duration_ns;
+	HOST_RADIO_Tim2Synchronize();
+	while ((host_radio_ctx.host_radio_tim2_running != 0) && (host_radio_ctx.host_radio_tim2_next_tick_ns <= target_time_ns)) {
+		HOST_RADIO_Tim2Tick();
+	}
+	host_radio_ctx.host_radio_time_ns = target_time_ns;
+}
+
+/* GET THE PENDING TIM2 INTERRUPT.
+ * @param:	None.
+ * @return:	Timing index of the highest priority pending event in the handler, TIM2_TIMINGS_ARRAY_LENGTH if none.
+ */
+static unsigned char HOST_RADIO_Tim2GetPending(void) {
+	unsigned int pending = (host_tim2.SR & host_tim2.DIER & HOST_RADIO_TIM2_SR_MASK);
+	unsigned char timing_idx = 0;
+	if (host_radio_ctx.host_radio_tim2_nvic_enabled == 0) return TIM2_TIMINGS_ARRAY_LENGTH;
+	for (timing_idx=0 ; timing_idx<TIM2_TIMINGS_ARRAY_LENGTH ; timing_idx++) {
+		if ((pending & (0b1 << timing_idx)) != 0) break;
+	}
+	return timing_idx;
+}
+
+/* SERVICE PENDING TIM2 INTERRUPTS (TAIL-CHAINED UNTIL NO FLAG IS PENDING).
+ * @param:	None.
+ * @return:	None.
+ */
+static void HOST_RADIO_Tim2Service(void) {
+	// Local variables.
+	unsigned char timing_idx = HOST_RADIO_Tim2GetPending();
+	HOST_RADIO_Interrupt* interrupt = NULL;
+	host_radio_ctx.host_radio_in_interrupt = 1;
+	while (timing_idx < TIM2_TIMINGS_ARRAY_LENGTH) {
+		if (host_radio_ctx.host_radio_interrupt_count < HOST_RADIO_INTERRUPT_LOG_LENGTH) {
+			interrupt = &(host_radio_ctx.host_radio_interrupts[host_radio_ctx.host_radio_interrupt_count]);
+			interrupt -> host_radio_interrupt_timing_idx = timing_idx;
+			interrupt -> host_radio_interrupt_event_time_ns = host_radio_ctx.host_radio_tim2_flag_time_ns[timing_idx];
+			interrupt -> host_radio_interrupt_start_time_ns = host_radio_ctx.host_radio_time_ns;
+			TIM2_IRQHandler();
+			interrupt -> host_radio_interrupt_end_time_ns = host_radio_ctx.host_radio_time_ns;
+			host_radio_ctx.host_radio_interrupt_count++;
+		}
+		else {
+			host_radio_ctx.host_radio_overflow = 1;
+			TIM2_IRQHandler();
+		}
+		timing_idx = HOST_RADIO_Tim2GetPending();
+	}
+	host_radio_ctx.host_radio_in_interrupt = 0;
+}
+
+/* CHECK IF A GPIO IS THE GIVEN PIN (MAPPING STRUCTURES ARE DUPLICATED IN EACH FILE).
+ * @param gpio:		GPIO to check.
+ * @param pin:		Reference pin.
+ * @return:			1 if the GPIO is the pin, 0 otherwise.
+ */
+static unsigned char HOST_RADIO_IsPin(const GPIO* gpio, const GPIO* pin) {
+	return (((gpio -> gpio_port_index) == (pin -> gpio_port_index)) && ((gpio -> gpio_num) == (pin -> gpio_num)));
+}
+
+/* TRANSFER ONE BYTE WITH THE SX1232.
+ * @param tx_data:	Byte sent by the MCU.
+ * @return:			Byte sent by the transceiver.
+ */
+static unsigned char HOST_RADIO_SpiTransfer(unsigned char tx_data) {
+	// Local variables.
+	unsigned char rx_data = 0;
+	unsigned char* registers = host_radio_ctx.host_radio_sx1232_registers;
+	unsigned int frf = 0;
+	HOST_RADIO_Advance(HOST_RADIO_SPI_BYTE_DURATION_NS);
+	if (host_radio_ctx.host_radio_spi_selected == 0) return 0;
+	if (host_radio_ctx.host_radio_spi_byte_idx == 0) {
+		// Command byte.
+		host_radio_ctx.host_radio_spi_write = ((tx_data & (0b1 << 7)) != 0);
+		host_radio_ctx.host_radio_spi_address = (tx_data & 0x7F);
+	}
+	else {
+		if (host_radio_ctx.host_radio_spi_write != 0) {
+			registers[host_radio_ctx.host_radio_spi_address] = tx_data;
+			// Frequency change is triggered by the LSB write.
+			if (host_radio_ctx.host_radio_spi_address == SX1232_REG_FRFLSB) {
+				frf = (registers[SX1232_REG_FRFMSB] << 16) | (registers[SX1232_REG_FRFMID] << 8) | (registers[SX1232_REG_FRFLSB]);
+				HOST_RADIO_RecordEvent(HOST_RADIO_EVENT_FREQUENCY, frf, (HOST_RADIO_SX1232_FXOSC_HZ * frf) / (1 << 19));
+			}
+		}
+		else {
+			rx_data = registers[host_radio_ctx.host_radio_spi_address];
+		}
+		// Address is automatically incremented (except for FIFO).
+		if (host_radio_ctx.host_radio_spi_address != 0) {
+			host_radio_ctx.host_radio_spi_address = (host_radio_ctx.host_radio_spi_address + 1) & 0x7F;
+		}
+	}
+	host_radio_ctx.host_radio_spi_byte_idx++;
+	return rx_data;
+}
+
+/*** HOST RADIO functions ***/
+
+/* RESET EMULATED PERIPHERALS.
+ * @param latency_min_us:	Minimum delay between a TIM2 event and the handler entry (wake-up from sleep and stacking).
+ * @param latency_max_us:	Maximum delay between a TIM2 event and the handler entry.
+ * @return:					None.
+ */
+void HOST_RADIO_Init(unsigned int latency_min_us, unsigned int latency_max_us) {
+	memset(&host_radio_ctx, 0, sizeof(HOST_RADIO_Context));
+	memset(&host_tim2, 0, sizeof(TIM_BaseAddress));
+	host_radio_ctx.host_radio_latency_min_us = latency_min_us;
+	host_radio_ctx.host_radio_latency_max_us = latency_max_us;
+	host_tim2.ARR = 0xFFFF;
+	host_radio_ctx.host_radio_state = RADIO_STATE_OFF;
+}
+
+/* CLEAR EVENT AND INTERRUPT LOGS.
+ * @param:	None.
+ * @return:	None.
+ */
+void HOST_RADIO_ClearLogs(void) {
+	host_radio_ctx.host_radio_event_count = 0;
+	host_radio_ctx.host_radio_interrupt_count = 0;
+	host_radio_ctx.host_radio_overflow = 0;
+}
+
+/* GET THE NUMBER OF RECORDED EVENTS.
+ * @param:	None.
+ * @return:	Number of events since last logs clear.
+ */
+unsigned int HOST_RADIO_GetEventCount(void) {
+	return host_radio_ctx.host_radio_event_count;
+}
+
+/* GET RECORDED EVENTS.
+ * @param:	None.
+ * @return:	Events in chronological order.
+ */
+const HOST_RADIO_Event* HOST_RADIO_GetEvents(void) {
+	return host_radio_ctx.host_radio_events;
+}
+
+/* GET THE NUMBER OF RECORDED INTERRUPTS.
+ * @param:	None.
+ * @return:	Number of TIM2 interrupts since last logs clear.
+ */
+unsigned int HOST_RADIO_GetInterruptCount(void) {
+	return host_radio_ctx.host_radio_interrupt_count;
+}
+
+/* GET RECORDED INTERRUPTS.
+ * @param:	None.
+ * @return:	TIM2 interrupts in chronological order.
+ */
+const HOST_RADIO_Interrupt* HOST_RADIO_GetInterrupts(void) {
+	return host_radio_ctx.host_radio_interrupts;
+}
+
+/* CHECK IF LOGS WERE TOO SMALL.
+ * @param:	None.
+ * @return:	1 if events or interrupts were lost since last logs clear, 0 otherwise.
+ */
+unsigned char HOST_RADIO_GetOverflow(void) {
+	return host_radio_ctx.host_radio_overflow;
+}
+
+/* TIM2 REGISTERS ACCESS (SYNCHRONIZES COUNTER WITH SIMULATED TIME).
+ * @param:	None.
+ * @return:	Emulated TIM2 registers.
+ */
+TIM_BaseAddress* HOST_RADIO_Tim2Access(void) {
+	HOST_RADIO_Tim2Synchronize();
+	return &host_tim2;
+}
+
+/*** Emulated drivers ***/
+
+void PWR_EnterSleepMode(void) {
+	// Local variables.
+	unsigned long long timeout_ns = host_radio_ctx.host_radio_time_ns + HOST_RADIO_SLEEP_TIMEOUT_NS;
+	unsigned int latency_us = host_radio_ctx.host_radio_latency_min_us;
+	// Run timer until an enabled event occurs.
+	HOST_RADIO_Tim2Synchronize();
+	while (HOST_RADIO_Tim2GetPending() >= TIM2_TIMINGS_ARRAY_LENGTH) {
+		if ((host_radio_ctx.host_radio_tim2_running == 0) || (host_radio_ctx.host_radio_time_ns > timeout_ns)) {
+			fprintf(stderr, "*** PWR_EnterSleepMode: no wake-up source.\r\n");
+			exit(1);
+		}
+		HOST_RADIO_Advance(host_radio_ctx.host_radio_tim2_next_tick_ns - host_radio_ctx.host_radio_time_ns);
+	}
+	// Wake-up and interrupt entry.
+	if (host_radio_ctx.host_radio_latency_max_us > host_radio_ctx.host_radio_latency_min_us) {
+		latency_us += rand() % (host_radio_ctx.host_radio_latency_max_us - host_radio_ctx.host_radio_latency_min_us + 1);
+	}
+	HOST_RADIO_Advance(latency_us * 1000ULL);
+	HOST_RADIO_Tim2Service();
+}
+
+void PWR_EnterStopMode(void) {
+	PWR_EnterSleepMode();
+}
+
+void NVIC_EnableInterrupt(NVIC_InterruptVector it_num) {
+	if (it_num == NVIC_IT_TIM2) {
+		host_radio_ctx.host_radio_tim2_nvic_enabled = 1;
+		// Flags which are already pending are serviced immediately.
+		if (host_radio_ctx.host_radio_in_interrupt == 0) {
+			HOST_RADIO_Tim2Service();
+		}
+	}
+}
+
+void NVIC_DisableInterrupt(NVIC_InterruptVector it_num) {
+	if (it_num == NVIC_IT_TIM2) {
+		host_radio_ctx.host_radio_tim2_nvic_enabled = 0;
+	}
+}
+
+void NVIC_SetPriority(NVIC_InterruptVector it_num, unsigned char priority) {
+	(void) it_num;
+	(void) priority;
+}
+
+void GPIO_Configure(const GPIO* gpio, GPIO_Mode mode, GPIO_OutputType output_type, GPIO_OutputSpeed output_speed, GPIO_PullResistor pull_resistor) {
+	(void) gpio;
+	(void) mode;
+	(void) output_type;
+	(void) output_speed;
+	(void) pull_resistor;
+}
+
+void GPIO_Write(const GPIO* gpio, unsigned char state) {
+	if (HOST_RADIO_IsPin(gpio, &GPIO_SX1232_DIO2) != 0) {
+		HOST_RADIO_RecordEvent(HOST_RADIO_EVENT_DIO2, state, 0.0);
+	}
+	if (HOST_RADIO_IsPin(gpio, &GPIO_SX1232_CS) != 0) {
+		// Falling edge starts a new SPI burst.
+		host_radio_ctx.host_radio_spi_selected = (state == 0);
+		host_radio_ctx.host_radio_spi_byte_idx = 0;
+	}
+}
+
+unsigned char GPIO_Read(const GPIO* gpio) {
+	(void) gpio;
+	return 0;
+}
+
+void EXTI_ConfigureGpio(const GPIO* gpio, EXTI_Trigger edge_trigger) {
+	(void) gpio;
+	(void) edge_trigger;
+}
+
+void EXTI_DisableGpio(const GPIO* gpio) {
+	(void) gpio;
+}
+
+#ifdef HW1_0
+void SPI1_SetClockPolarity(unsigned char polarity) {
+	(void) polarity;
+}
+#endif
+
+unsigned char SPI1_WriteByte(unsigned char tx_data) {
+	HOST_RADIO_SpiTransfer(tx_data);
+	return 1;
+}
+
+unsigned char SPI1_ReadByte(unsigned char tx_data, unsigned char* rx_data) {
+	(*rx_data) = HOST_RADIO_SpiTransfer(tx_data);
+	return 1;
+}
+
+unsigned char SPI1_TransferBytes(unsigned char* tx_data, unsigned char* rx_data, unsigned char length) {
+	unsigned char byte_idx = 0;
+	unsigned char rx_byte = 0;
+	for (byte_idx=0 ; byte_idx<length ; byte_idx++) {
+		rx_byte = HOST_RADIO_SpiTransfer((tx_data != 0) ? tx_data[byte_idx] : 0xFF);
+		if (rx_data != 0) {
+			rx_data[byte_idx] = rx_byte;
+		}
+	}
+	return 1;
+}
+
+unsigned int RCC_GetSysclkKhz(void) {
+	return HOST_RADIO_SYSCLK_KHZ;
+}
+
+void LPTIM1_DelayMilliseconds(unsigned int delay_ms, unsigned char stop_mode) {
+	if (stop_mode != 0) {
+		// TIM2 is not clocked in stop mode.
+		host_radio_ctx.host_radio_time_ns += (delay_ms * 1000000ULL);
+		host_radio_ctx.host_radio_tim2_next_tick_ns += (delay_ms * 1000000ULL);
+	}
+	else {
+		HOST_RADIO_Advance(delay_ms * 1000000ULL);
+		HOST_RADIO_Tim2Service();
+	}
+}
+
+unsigned char RADIO_SetState(RADIO_State state) {
+	// Account PA on time.
+	unsigned long long residency_ns = 0;
+	static unsigned long long tx_start_time_ns = 0;
+	if (host_radio_ctx.host_radio_state == RADIO_STATE_TX) {
+		residency_ns = host_radio_ctx.host_radio_time_ns - tx_start_time_ns;
+		host_radio_ctx.host_radio_tx_residency_ms += (unsigned int) (residency_ns / 1000000ULL);
+	}
+	if (state == RADIO_STATE_TX) {
+		tx_start_time_ns = host_radio_ctx.host_radio_time_ns;
+	}
+	host_radio_ctx.host_radio_state = state;
+	HOST_RADIO_RecordEvent(HOST_RADIO_EVENT_STATE, state, 0.0);
+	return 1;
+}
+
+RADIO_State RADIO_GetState(void) {
+	return host_radio_ctx.host_radio_state;
+}
+
+unsigned int RADIO_GetResidency(RADIO_State state) {
+	return ((state == RADIO_STATE_TX) ? host_radio_ctx.host_radio_tx_residency_ms : 0);
+}
+
+void AIRTIME_Record(unsigned int tx_duration_ms) {
+	(void) tx_duration_ms;
+}
+
+void IWDG_Reload(void) {
+}
+
+void NVM_Enable(void) {
+}
+
+void NVM_Disable(void) {
+}
+
+unsigned char NVM_GetTxPowerBackoff(void) {
+	return 0;
+}
+
+unsigned char NVM_SetTxPowerBackoff(unsigned char value) {
+	(void) value;
+	return 1;
+}
+
+unsigned int RTC_GetTimeOfDayMilliseconds(void) {
+	return (unsigned int) ((host_radio_ctx.host_radio_time_ns / 1000000ULL) % 86400000ULL);
+}
+
+void RTC_StartWakeUpTimer(unsigned int delay_seconds) {
+	(void) delay_seconds;
+}
+
+void RTC_StopWakeUpTimer(void) {
+}
+
+volatile unsigned char RTC_GetWakeUpTimerFlag(void) {
+	return 1;
+}
+
+void RTC_ClearWakeUpTimerFlag(void) {
+}
@@ -0,0 +1,427 @@
+/*
+ * nvm_sim.c
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "airtime.h"
+#include "host_eeprom.h"
+#include "flash_reg.h"
+#include "nvm.h"
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Host simulation of the NVM driver: replays the NVM accesses of the IM/CM hourly cycle on an EEPROM
+// image file, injects torn writes and checks that every value survives as its old or new version.
+
+/*** NVM SIM macros ***/
+
+#define NVM_SIM_DEFAULT_FILE_NAME				"eeprom.bin"
+#define NVM_SIM_DEFAULT_YEARS					10
+#define NVM_SIM_DEFAULT_TORN_PERIOD				0
+#define NVM_SIM_DEFAULT_FAILURE_PERCENT			5
+#define NVM_SIM_HOURS_PER_DAY					24
+#define NVM_SIM_DAYS_PER_YEAR					365
+#define NVM_SIM_START_YEAR						2026
+#define NVM_SIM_UPLINKS_PER_HOUR				2 // Monitoring and weather frames.
+#define NVM_SIM_BACKFILL_FRAMES_PER_HOUR_MAX	2
+#define NVM_SIM_CONFIG_UPDATE_PERIOD_DAYS		30 // Configuration downlink.
+// Journal record format (see nvm.c): | FIELD_ID (4) | SEQUENCE (4) | VALUE (16) | CRC8 (8) | then | CRC16 (16) | ~CRC16 (16) |.
+#define NVM_SIM_CRC8_POLYNOMIAL					0x07
+#define NVM_SIM_CRC16_POLYNOMIAL				0x1021
+
+/*** NVM SIM structures ***/
+
+// Values expected in NVM (everything that survives a reset).
+typedef struct {
+	unsigned short field[NVM_FIELD_LAST];
+	unsigned char sigfox[NVM_RECORD_SIGFOX_SIZE_BYTES];
+	unsigned char link[NVM_RECORD_LINK_SIZE_BYTES];
+	unsigned int backlog_count;
+} NVM_SIM_State;
+
+typedef struct {
+	// Parameters.
+	const char* nvm_sim_file_name;
+	unsigned int nvm_sim_years;
+	unsigned int nvm_sim_torn_period;
+	unsigned int nvm_sim_failure_percent;
+	// Simulation state.
+	NVM_SIM_State nvm_sim_committed; // Last completed operation.
+	NVM_SIM_State nvm_sim_target; // Operation in progress.
+	unsigned int nvm_sim_sequence; // Sigfox sequence number.
+	unsigned int nvm_sim_backlog_counter; // Last measurement pushed in backlog.
+	unsigned int nvm_sim_torn_writes;
+	unsigned int nvm_sim_crc_escapes; // Torn journal records accepted by the CRC checks.
+	unsigned int nvm_sim_errors;
+	jmp_buf nvm_sim_reset_point;
+} NVM_SIM_Context;
+
+/*** NVM SIM local global variables ***/
+
+static NVM_SIM_Context nvm_sim_ctx;
+
+/*** NVM SIM local functions ***/
+
+/* CONVERT AN HOUR INDEX TO A UTC TIMESTAMP.
+ * @param hour_idx:	Number of hours since simulation start.
+ * @param year:		Pointer to the year.
+ * @param month:	Pointer to the month (1-12).
+ * @param date:		Pointer to the date (1-31).
+ * @param hours:	Pointer to the hours (0-23).
+ * @return:			None.
+ */
+static void NVM_SIM_GetTimestamp(unsigned int hour_idx, unsigned short* year, unsigned char* month, unsigned char* date, unsigned char* hours) {
+	const unsigned char days_per_month[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+	unsigned int day_idx = hour_idx / NVM_SIM_HOURS_PER_DAY;
+	unsigned char month_duration = 0;
+	(*year) = NVM_SIM_START_YEAR;
+	(*month) = 1;
+	(*hours) = hour_idx % NVM_SIM_HOURS_PER_DAY;
+	while (1) {
+		month_duration = days_per_month[(*month) - 1] + ((((*month) == 2) && (((*year) % 4) == 0)) ? 1 : 0);
+		if (day_idx < month_duration) break;
+		day_idx -= month_duration;
+		(*month)++;
+		if ((*month) > 12) {
+			(*month) = 1;
+			(*year)++;
+		}
+	}
+	(*date) = day_idx + 1;
+}
+
+/* CHECK IF A FIELD VALUE COMES FROM A TORN JOURNAL RECORD WHICH PASSED THE CRC CHECKS.
+ * @param field:	Field index.
+ * @return:			1 if the record containing the torn word is a valid record of the field (its value or the field default value is used), 0 otherwise.
+ */
+static unsigned char NVM_SIM_IsCrcEscape(unsigned char field) {
+	// Local variables.
+	unsigned short address_offset = HOST_EEPROM_GetTornAddressOffset();
+	unsigned int record = 0;
+	unsigned int commit = 0;
+	unsigned char record_bytes[4];
+	unsigned char crc8 = 0xFF;
+	unsigned short crc16 = 0xFFFF;
+	unsigned char byte_idx = 0;
+	unsigned char bit_idx = 0;
+	if ((address_offset < NVM_JOURNAL_START_ADDRESS_OFFSET) || (address_offset >= NVM_JOURNAL_END_ADDRESS_OFFSET)) return 0;
+	// Decode the record containing the torn word.
+	address_offset -= ((address_offset - NVM_JOURNAL_START_ADDRESS_OFFSET) % NVM_JOURNAL_RECORD_SIZE_BYTES);
+	memcpy(&record, &(host_eeprom_data[address_offset]), sizeof(unsigned int));
+	memcpy(&commit, &(host_eeprom_data[address_offset + sizeof(unsigned int)]), sizeof(unsigned int));
+	for (byte_idx=0 ; byte_idx<4 ; byte_idx++) {
+		record_bytes[byte_idx] = (record >> (24 - (8 * byte_idx))) & 0xFF;
+	}
+	for (byte_idx=0 ; byte_idx<3 ; byte_idx++) {
+		crc8 ^= record_bytes[byte_idx];
+		for (bit_idx=0 ; bit_idx<8 ; bit_idx++) {
+			crc8 = (crc8 & 0x80) ? ((crc8 << 1) ^ NVM_SIM_CRC8_POLYNOMIAL) : (crc8 << 1);
+		}
+	}
+	for (byte_idx=0 ; byte_idx<4 ; byte_idx++) {
+		crc16 ^= (record_bytes[byte_idx] << 8);
+		for (bit_idx=0 ; bit_idx<8 ; bit_idx++) {
+			crc16 = (crc16 & 0x8000) ? ((crc16 << 1) ^ NVM_SIM_CRC16_POLYNOMIAL) : (crc16 << 1);
+		}
+	}
+	if ((crc8 != record_bytes[3]) || (commit != ((((unsigned int) crc16) << 16) | ((~crc16) & 0xFFFF)))) return 0;
+	// Journal fields are stored after configuration fields, in field order (field ID 0 is reserved).
+	return ((record_bytes[0] >> 4) == (field - NVM_FIELD_DAY_COUNT + 1)) ? 1 : 0;
+}
+
+/* READ THE STATE STORED IN NVM.
+ * @param state:	Pointer to the state to fill.
+ * @return:			None.
+ */
+static void NVM_SIM_ReadState(NVM_SIM_State* state) {
+	unsigned char field = 0;
+	for (field=0 ; field<NVM_FIELD_LAST ; field++) {
+		NVM_ReadField(field, &(state -> field[field]));
+	}
+	NVM_RecordRead(NVM_RECORD_SIGFOX, state -> sigfox);
+	NVM_RecordRead(NVM_RECORD_LINK, state -> link);
+	state -> backlog_count = NVM_BacklogGetCount();
+}
+
+/* BUILD BACKLOG ENTRY DATA FROM A MEASUREMENT COUNTER.
+ * @param counter:	Measurement counter.
+ * @param data:		Entry data.
+ * @return:			None.
+ */
+static void NVM_SIM_BuildBacklogData(unsigned int counter, unsigned char* data) {
+	unsigned char byte_idx = 0;
+	memcpy(data, &counter, sizeof(unsigned int));
+	for (byte_idx=sizeof(unsigned int) ; byte_idx<NVM_BACKLOG_DATA_SIZE_BYTES ; byte_idx++) {
+		data[byte_idx] = (counter * 31) + byte_idx;
+	}
+}
+
+/* CHECK NVM CONTENT AFTER A RESET.
+ * @param:	None.
+ * @return:	None.
+ */
+static void NVM_SIM_CheckRecovery(void) {
+	// Local variables.
+	NVM_SIM_State state;
+	NVM_SIM_State* committed = &nvm_sim_ctx.nvm_sim_committed;
+	NVM_SIM_State* target = &nvm_sim_ctx.nvm_sim_target;
+	unsigned char data[NVM_BACKLOG_DATA_SIZE_BYTES];
+	unsigned char expected_data[NVM_BACKLOG_DATA_SIZE_BYTES];
+	unsigned int counter = 0;
+	unsigned char field = 0;
+	// Reload NVM as at start-up.
+	NVM_Init();
+	NVM_SIM_ReadState(&state);
+	// Each value must be either the old or the new one.
+	for (field=0 ; field<NVM_FIELD_LAST ; field++) {
+		if ((state.field[field] != committed -> field[field]) && (state.field[field] != target -> field[field])) {
+			if (NVM_SIM_IsCrcEscape(field) != 0) {
+				nvm_sim_ctx.nvm_sim_crc_escapes++;
+				continue;
+			}
+			printf("Field %d: read %d, expected %d or %d.\n", field, state.field[field], committed -> field[field], target -> field[field]);
+			nvm_sim_ctx.nvm_sim_errors++;
+		}
+	}
+	if ((memcmp(state.sigfox, committed -> sigfox, NVM_RECORD_SIGFOX_SIZE_BYTES) != 0) && (memcmp(state.sigfox, target -> sigfox, NVM_RECORD_SIGFOX_SIZE_BYTES) != 0)) {
+		printf("Sigfox record corrupted.\n");
+		nvm_sim_ctx.nvm_sim_errors++;
+	}
+	if ((memcmp(state.link, committed -> link, NVM_RECORD_LINK_SIZE_BYTES) != 0) && (memcmp(state.link, target -> link, NVM_RECORD_LINK_SIZE_BYTES) != 0)) {
+		printf("Link record corrupted.\n");
+		nvm_sim_ctx.nvm_sim_errors++;
+	}
+	// Backlog: pending count moves by one entry at most and pending data is never corrupted.
+	if ((state.backlog_count + 1 < committed -> backlog_count) || (state.backlog_count > committed -> backlog_count + 1)) {
+		printf("Backlog count: read %d, expected %d.\n", state.backlog_count, committed -> backlog_count);
+		nvm_sim_ctx.nvm_sim_errors++;
+	}
+	if (NVM_BacklogPeek(data) != 0) {
+		memcpy(&counter, data, sizeof(unsigned int));
+		NVM_SIM_BuildBacklogData(counter, expected_data);
+		if (memcmp(data, expected_data, NVM_BACKLOG_DATA_SIZE_BYTES) != 0) {
+			printf("Backlog entry corrupted.\n");
+			nvm_sim_ctx.nvm_sim_errors++;
+		}
+	}
+	// Continue from the recovered state.
+	memcpy(committed, &state, sizeof(NVM_SIM_State));
+	memcpy(target, &state, sizeof(NVM_SIM_State));
+}
+
+/* ARM THE NEXT TORN WRITE.
+ * @param:	None.
+ * @return:	None.
+ */
+static void NVM_SIM_ArmTornWrite(void) {
+	if (nvm_sim_ctx.nvm_sim_torn_period != 0) {
+		HOST_EEPROM_ArmTornWrite((HOST_EEPROM_GetProgramCount() + 1 + (rand() % nvm_sim_ctx.nvm_sim_torn_period)), &nvm_sim_ctx.nvm_sim_reset_point);
+	}
+}
+
+/* WRITE A FIELD THROUGH ITS TYPED SETTER.
+ * @param field:	Field to write.
+ * @param value:	New value.
+ * @return:			None.
+ */
+static void NVM_SIM_WriteField(NVM_Field field, unsigned short value) {
+	nvm_sim_ctx.nvm_sim_target.field[field] = value;
+	switch (field) {
+	case NVM_FIELD_UPLINK_SLOT_JITTER:
+		NVM_SetUplinkSlotJitter(value);
+		break;
+	case NVM_FIELD_MONITORING_STATUS_BYTE:
+		NVM_SetMonitoringStatusByte(value);
+		break;
+	case NVM_FIELD_RTC_PWKUP_YEAR:
+		NVM_SetRtcPwkupYear(value);
+		break;
+	case NVM_FIELD_RTC_PWKUP_MONTH:
+		NVM_SetRtcPwkupMonth(value);
+		break;
+	case NVM_FIELD_RTC_PWKUP_DATE:
+		NVM_SetRtcPwkupDate(value);
+		break;
+	case NVM_FIELD_RTC_PWKUP_HOURS:
+		NVM_SetRtcPwkupHours(value);
+		break;
+	case NVM_FIELD_TX_POWER_BACKOFF:
+		NVM_SetTxPowerBackoff(value);
+		break;
+	case NVM_FIELD_AIRTIME_WINDOW:
+		NVM_SetAirtimeWindow(value);
+		break;
+	default:
+		NVM_WriteField(field, value);
+		break;
+	}
+	nvm_sim_ctx.nvm_sim_committed.field[field] = value;
+}
+
+/* EMULATE MCU_API_set_nv_mem AFTER AN UPLINK.
+ * @param:	None.
+ * @return:	None.
+ */
+static void NVM_SIM_Uplink(void) {
+	nvm_sim_ctx.nvm_sim_sequence = (nvm_sim_ctx.nvm_sim_sequence + 1) & 0x0FFF;
+	nvm_sim_ctx.nvm_sim_target.sigfox[2] = (nvm_sim_ctx.nvm_sim_sequence >> 8) & 0xFF;
+	nvm_sim_ctx.nvm_sim_target.sigfox[3] = (nvm_sim_ctx.nvm_sim_sequence >> 0) & 0xFF;
+	nvm_sim_ctx.nvm_sim_target.sigfox[0] = rand() & 0xFF;
+	nvm_sim_ctx.nvm_sim_target.sigfox[1] = rand() & 0xFF;
+	NVM_RecordWrite(NVM_RECORD_SIGFOX, nvm_sim_ctx.nvm_sim_target.sigfox);
+	memcpy(nvm_sim_ctx.nvm_sim_committed.sigfox, nvm_sim_ctx.nvm_sim_target.sigfox, NVM_RECORD_SIGFOX_SIZE_BYTES);
+}
+
+/* EMULATE THE NVM ACCESSES OF ONE WAKE-UP.
+ * @param hour_idx:	Number of hours since simulation start.
+ * @return:			None.
+ */
+static void NVM_SIM_Hour(unsigned int hour_idx) {
+	// Local variables.
+	unsigned short year = 0;
+	unsigned char month = 0;
+	unsigned char date = 0;
+	unsigned char hours = 0;
+	unsigned char data[NVM_BACKLOG_DATA_SIZE_BYTES];
+	unsigned char idx = 0;
+	unsigned char weather_sent = 0;
+	unsigned int day_idx = hour_idx / NVM_SIM_HOURS_PER_DAY;
+	// Previous wake-up timestamp.
+	NVM_SIM_GetTimestamp(hour_idx, &year, &month, &date, &hours);
+	NVM_SIM_WriteField(NVM_FIELD_RTC_PWKUP_YEAR, year);
+	NVM_SIM_WriteField(NVM_FIELD_RTC_PWKUP_MONTH, month);
+	NVM_SIM_WriteField(NVM_FIELD_RTC_PWKUP_DATE, date);
+	NVM_SIM_WriteField(NVM_FIELD_RTC_PWKUP_HOURS, hours);
+	if (hours == 0) {
+		// Daily link statistics summary.
+		for (idx=0 ; idx<NVM_RECORD_LINK_SIZE_BYTES ; idx++) nvm_sim_ctx.nvm_sim_target.link[idx] = rand() & 0xFF;
+		NVM_RecordWrite(NVM_RECORD_LINK, nvm_sim_ctx.nvm_sim_target.link);
+		memcpy(nvm_sim_ctx.nvm_sim_committed.link, nvm_sim_ctx.nvm_sim_target.link, NVM_RECORD_LINK_SIZE_BYTES);
+		// Daily downlink: output power control and configuration update.
+		NVM_SIM_WriteField(NVM_FIELD_TX_POWER_BACKOFF, rand() % (NVM_TX_POWER_BACKOFF_MAX_DB + 1));
+		if ((day_idx % NVM_SIM_CONFIG_UPDATE_PERIOD_DAYS) == 0) {
+			NVM_SIM_WriteField(NVM_FIELD_UPLINK_SLOT_JITTER, rand() & 0xFF);
+		}
+		// Daily geolocation frame.
+		NVM_SIM_Uplink();
+	}
+	// Monitoring and weather frames.
+	for (idx=0 ; idx<NVM_SIM_UPLINKS_PER_HOUR ; idx++) {
+		NVM_SIM_Uplink();
+	}
+	weather_sent = ((unsigned int) (rand() % 100) >= nvm_sim_ctx.nvm_sim_failure_percent) ? 1 : 0;
+	if (weather_sent == 0) {
+		// Store measurements in backlog.
+		nvm_sim_ctx.nvm_sim_backlog_counter++;
+		NVM_SIM_BuildBacklogData(nvm_sim_ctx.nvm_sim_backlog_counter, data);
+		NVM_BacklogPush(data);
+		nvm_sim_ctx.nvm_sim_committed.backlog_count = NVM_BacklogGetCount();
+	}
+	else {
+		// Backfill.
+		for (idx=0 ; idx<NVM_SIM_BACKFILL_FRAMES_PER_HOUR_MAX ; idx++) {
+			if (NVM_BacklogPeek(data) == 0) break;
+			NVM_SIM_Uplink();
+			NVM_BacklogPop();
+			nvm_sim_ctx.nvm_sim_committed.backlog_count = NVM_BacklogGetCount();
+		}
+	}
+	// Status byte (daily flags) and duty cycle ledger checkpoint.
+	NVM_SIM_WriteField(NVM_FIELD_MONITORING_STATUS_BYTE, (hours < 12) ? 0x03 : 0xF3);
+	NVM_SIM_WriteField(NVM_FIELD_AIRTIME_WINDOW, rand() % (AIRTIME_WINDOW_BUDGET_MS + 1));
+}
+
+/* PRINT PROGRAM STATISTICS OF AN EEPROM AREA.
+ * @param name:				Area name.
+ * @param area:				Area.
+ * @param start_offset:		First address of the area.
+ * @param end_offset:		Address following the area.
+ * @param years:			Simulated duration.
+ * @return:					None.
+ */
+static void NVM_SIM_PrintArea(const char* name, NVM_Area area, unsigned short start_offset, unsigned short end_offset, unsigned int years) {
+	unsigned int max_cycles = 0;
+	unsigned short address_offset = 0;
+	for (address_offset=start_offset ; address_offset<end_offset ; address_offset+=4) {
+		if (HOST_EEPROM_GetCycleCount(address_offset) > max_cycles) {
+			max_cycles = HOST_EEPROM_GetCycleCount(address_offset);
+		}
+	}
+	printf("%-8s %12u %12u", name, NVM_GetProgramCount(area), max_cycles);
+	if (max_cycles != 0) {
+		printf(" %12.1f\n", ((double) HOST_EEPROM_ENDURANCE_CYCLES * years) / max_cycles);
+	}
+	else {
+		printf(" %12s\n", "-");
+	}
+}
+
+/*** NVM SIM main function ***/
+
+/* MAIN FUNCTION.
+ * @param argc:	Number of arguments.
+ * @param argv:	Options: -f <eeprom_file> -y <years> -t <torn_write_period> -p <failure_percent> -s <seed>.
+ * @return:		0 if all checks passed, 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+	// Local variables.
+	unsigned int seed = 1;
+	unsigned int hour_idx = 0;
+	unsigned int number_of_hours = 0;
+	int arg_idx = 0;
+	clock_t start_time = 0;
+	// Parse options.
+	nvm_sim_ctx.nvm_sim_file_name = NVM_SIM_DEFAULT_FILE_NAME;
+	nvm_sim_ctx.nvm_sim_years = NVM_SIM_DEFAULT_YEARS;
+	nvm_sim_ctx.nvm_sim_torn_period = NVM_SIM_DEFAULT_TORN_PERIOD;
+	nvm_sim_ctx.nvm_sim_failure_percent = NVM_SIM_DEFAULT_FAILURE_PERCENT;
+	for (arg_idx=1 ; (arg_idx + 1)<argc ; arg_idx+=2) {
+		if (strcmp(argv[arg_idx], "-f") == 0) nvm_sim_ctx.nvm_sim_file_name = argv[arg_idx + 1];
+		else if (strcmp(argv[arg_idx], "-y") == 0) nvm_sim_ctx.nvm_sim_years = atoi(argv[arg_idx + 1]);
+		else if (strcmp(argv[arg_idx], "-t") == 0) nvm_sim_ctx.nvm_sim_torn_period = atoi(argv[arg_idx + 1]);
+		else if (strcmp(argv[arg_idx], "-p") == 0) nvm_sim_ctx.nvm_sim_failure_percent = atoi(argv[arg_idx + 1]);
+		else if (strcmp(argv[arg_idx], "-s") == 0) seed = atoi(argv[arg_idx + 1]);
+	}
+	srand(seed);
+	if (HOST_EEPROM_Open(nvm_sim_ctx.nvm_sim_file_name, EEPROM_SIZE) != 0) {
+		printf("Cannot map %s.\n", nvm_sim_ctx.nvm_sim_file_name);
+		return 1;
+	}
+	// Start-up.
+	start_time = clock();
+	NVM_Enable();
+	NVM_Init();
+	NVM_SIM_ReadState(&nvm_sim_ctx.nvm_sim_committed);
+	memcpy(&nvm_sim_ctx.nvm_sim_target, &nvm_sim_ctx.nvm_sim_committed, sizeof(NVM_SIM_State));
+	nvm_sim_ctx.nvm_sim_sequence = (nvm_sim_ctx.nvm_sim_committed.sigfox[2] << 8) | nvm_sim_ctx.nvm_sim_committed.sigfox[3];
+	// Hourly operation.
+	number_of_hours = nvm_sim_ctx.nvm_sim_years * NVM_SIM_DAYS_PER_YEAR * NVM_SIM_HOURS_PER_DAY;
+	NVM_SIM_ArmTornWrite();
+	for (hour_idx=0 ; hour_idx<number_of_hours ; hour_idx++) {
+		if (setjmp(nvm_sim_ctx.nvm_sim_reset_point) != 0) {
+			// Torn write: the rest of the wake-up is lost.
+			nvm_sim_ctx.nvm_sim_torn_writes++;
+			NVM_SIM_CheckRecovery();
+			NVM_SIM_ArmTornWrite();
+			continue;
+		}
+		NVM_SIM_Hour(hour_idx);
+	}
+	HOST_EEPROM_ArmTornWrite(0, NULL);
+	// Report.
+	printf("Simulated %u years (%u wake-ups) in %.1f s.\n", nvm_sim_ctx.nvm_sim_years, number_of_hours, ((double) (clock() - start_time)) / CLOCKS_PER_SEC);
+	printf("Torn writes: %u, recovery errors: %u, torn journal records accepted by CRC: %u.\n", nvm_sim_ctx.nvm_sim_torn_writes, nvm_sim_ctx.nvm_sim_errors, nvm_sim_ctx.nvm_sim_crc_escapes);
+	printf("%-8s %12s %12s %12s\n", "Area", "Programs", "Max/word", "Life (years)");
+	NVM_SIM_PrintArea("Fixed", NVM_AREA_FIXED, 0, NVM_JOURNAL_START_ADDRESS_OFFSET, nvm_sim_ctx.nvm_sim_years);
+	NVM_SIM_PrintArea("Journal", NVM_AREA_JOURNAL, NVM_JOURNAL_START_ADDRESS_OFFSET, NVM_JOURNAL_END_ADDRESS_OFFSET, nvm_sim_ctx.nvm_sim_years);
+	NVM_SIM_PrintArea("Records", NVM_AREA_RECORDS, NVM_JOURNAL_END_ADDRESS_OFFSET, NVM_BACKLOG_ADDRESS_OFFSET, nvm_sim_ctx.nvm_sim_years);
+	NVM_SIM_PrintArea("Backlog", NVM_AREA_BACKLOG, NVM_BACKLOG_ADDRESS_OFFSET, NVM_BACKLOG_END_ADDRESS_OFFSET, nvm_sim_ctx.nvm_sim_years);
+	NVM_Disable();
+	HOST_EEPROM_Close();
+	return (nvm_sim_ctx.nvm_sim_errors == 0) ? 0 : 1;
+}
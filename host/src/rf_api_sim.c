@@ -0,0 +1,271 @@
+/*
+ * rf_api_sim.c
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "host_radio.h"
+#include "rf_api.h"
+#include "sigfox_api.h"
+#include "tim.h"
+#include "tim_reg.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Host simulation of the uplink DBPSK modulation: rf_api.c, sx1232.c and tim.c are built against an emulated
+// TIM2 and an SX1232 register file. Frequency (FRF LSB write) and DIO2 changes are recorded with the simulated
+// time, the signal phase is reconstructed and checked against the bit stream of random frames.
+
+/*** RF API SIM macros ***/
+
+#define RF_API_SIM_DEFAULT_FRAMES				50
+#define RF_API_SIM_DEFAULT_LATENCY_MIN_US		2 // Wake-up from sleep mode and handler entry at 16MHz.
+#define RF_API_SIM_DEFAULT_LATENCY_MAX_US		10
+#define RF_API_SIM_DEFAULT_TOLERANCE_DEGREES	10
+#define RF_API_SIM_FRAME_LENGTH_BYTES_MIN		12
+#define RF_API_SIM_FRAME_LENGTH_BYTES_MAX		26
+#define RF_API_SIM_MACRO_CHANNEL_WIDTH_HZ		192000
+#define RF_API_SIM_RC1_FREQUENCY_HZ				868130000 // 100bps uplink.
+#define RF_API_SIM_RC2_FREQUENCY_HZ				902200000 // 600bps uplink.
+
+/*** RF API SIM structures ***/
+
+// Results of one modulation.
+typedef struct {
+	unsigned int rf_api_sim_frames;
+	unsigned int rf_api_sim_symbols;
+	double rf_api_sim_phase_error_max_degrees;
+	unsigned int rf_api_sim_phase_errors; // Symbols out of tolerance.
+	unsigned int rf_api_sim_amplitude_errors; // Signal off at a symbol boundary or on after ramp-down.
+	unsigned int rf_api_sim_splatters; // Frequency changed while signal was on.
+	unsigned int rf_api_sim_interrupt_count[TIM2_TIMINGS_ARRAY_CCR4_IDX];
+	unsigned long long rf_api_sim_latency_max_ns[TIM2_TIMINGS_ARRAY_CCR4_IDX];
+	unsigned long long rf_api_sim_completion_max_ns[TIM2_TIMINGS_ARRAY_CCR4_IDX];
+	long long rf_api_sim_margin_min_ns[TIM2_TIMINGS_ARRAY_CCR4_IDX];
+} RF_API_SIM_Result;
+
+typedef struct {
+	// Parameters.
+	unsigned int rf_api_sim_frames;
+	unsigned int rf_api_sim_latency_min_us;
+	unsigned int rf_api_sim_latency_max_us;
+	double rf_api_sim_tolerance_degrees;
+	// Simulation state.
+	unsigned int rf_api_sim_errors;
+} RF_API_SIM_Context;
+
+/*** RF API SIM local global variables ***/
+
+static RF_API_SIM_Context rf_api_sim_ctx;
+
+/*** RF API SIM local functions ***/
+
+/* CHECK THE RECORDED WAVEFORM OF A FRAME.
+ * @param stream:	Bit stream which was transmitted.
+ * @param size:		Stream length in bytes.
+ * @param result:	Pointer to the results of the modulation.
+ * @return:			None.
+ */
+static void RF_API_SIM_CheckWaveform(sfx_u8* stream, sfx_u8 size, RF_API_SIM_Result* result) {
+	// Local variables.
+	const HOST_RADIO_Event* events = HOST_RADIO_GetEvents();
+	unsigned int event_count = HOST_RADIO_GetEventCount();
+	unsigned int event_idx = 0;
+	unsigned int number_of_symbols = (8 * size);
+	unsigned int update_idx = 0;
+	unsigned char started = 0;
+	unsigned char signal_on = 0;
+	double nominal_frequency_hz = 0.0;
+	double frequency_hz = 0.0;
+	double phase = 0.0;
+	double previous_phase = 0.0;
+	double phase_error_degrees = 0.0;
+	unsigned long long time_ns = 0;
+	unsigned char bit = 0;
+	for (event_idx=0 ; event_idx<event_count ; event_idx++) {
+		// Integrate phase relative to the uplink frequency since previous event.
+		if (started != 0) {
+			phase += 2.0 * M_PI * (frequency_hz - nominal_frequency_hz) * ((double) (events[event_idx].host_radio_event_time_ns - time_ns)) * 1e-9;
+		}
+		time_ns = events[event_idx].host_radio_event_time_ns;
+		switch (events[event_idx].host_radio_event_type) {
+		case HOST_RADIO_EVENT_FREQUENCY:
+			frequency_hz = events[event_idx].host_radio_event_frequency_hz;
+			if ((started != 0) && (signal_on != 0)) {
+				result -> rf_api_sim_splatters++;
+			}
+			break;
+		case HOST_RADIO_EVENT_DIO2:
+			// First rising edge = start of CW on uplink frequency.
+			if ((started == 0) && (events[event_idx].host_radio_event_value != 0)) {
+				started = 1;
+				nominal_frequency_hz = frequency_hz;
+			}
+			signal_on = events[event_idx].host_radio_event_value;
+			break;
+		case HOST_RADIO_EVENT_UPDATE:
+			// Symbol boundaries: update N ends symbol N-1, update number_of_symbols starts ramp-down.
+			if (update_idx <= number_of_symbols) {
+				if (signal_on == 0) {
+					result -> rf_api_sim_amplitude_errors++;
+				}
+				if (update_idx > 0) {
+					bit = (stream[(update_idx - 1) >> 3] >> (7 - ((update_idx - 1) & 0x07))) & 0x01;
+					phase_error_degrees = fabs(remainder((phase - previous_phase) - ((bit == 0) ? M_PI : 0.0), 2.0 * M_PI)) * 180.0 / M_PI;
+					if (phase_error_degrees > (result -> rf_api_sim_phase_error_max_degrees)) {
+						result -> rf_api_sim_phase_error_max_degrees = phase_error_degrees;
+					}
+					if (phase_error_degrees > rf_api_sim_ctx.rf_api_sim_tolerance_degrees) {
+						result -> rf_api_sim_phase_errors++;
+					}
+				}
+				previous_phase = phase;
+			}
+			else if ((update_idx == (number_of_symbols + 1)) && (signal_on != 0)) {
+				result -> rf_api_sim_amplitude_errors++;
+			}
+			update_idx++;
+			break;
+		default:
+			break;
+		}
+	}
+	// All symbols and the ramp-down must have been generated.
+	if (update_idx < (number_of_symbols + 2)) {
+		result -> rf_api_sim_amplitude_errors++;
+	}
+	result -> rf_api_sim_symbols += number_of_symbols;
+}
+
+/* COMPUTE INTERRUPT TIMING MARGINS OF A FRAME.
+ * @param result:	Pointer to the results of the modulation.
+ * @return:			None.
+ */
+static void RF_API_SIM_CheckInterrupts(RF_API_SIM_Result* result) {
+	// Local variables.
+	const HOST_RADIO_Interrupt* interrupts = HOST_RADIO_GetInterrupts();
+	unsigned int interrupt_idx = 0;
+	unsigned char timing_idx = 0;
+	unsigned long long latency_ns = 0;
+	unsigned long long completion_ns = 0;
+	long long margin_ns = 0;
+	unsigned int next_event_us[TIM2_TIMINGS_ARRAY_CCR4_IDX];
+	// Time available before the next event of the symbol.
+	next_event_us[TIM2_TIMINGS_ARRAY_ARR_IDX] = (TIM2 -> CCR1);
+	next_event_us[TIM2_TIMINGS_ARRAY_CCR1_IDX] = (TIM2 -> CCR2) - (TIM2 -> CCR1);
+	next_event_us[TIM2_TIMINGS_ARRAY_CCR2_IDX] = (TIM2 -> CCR3) - (TIM2 -> CCR2);
+	next_event_us[TIM2_TIMINGS_ARRAY_CCR3_IDX] = (TIM2 -> ARR) - (TIM2 -> CCR3);
+	for (interrupt_idx=0 ; interrupt_idx<HOST_RADIO_GetInterruptCount() ; interrupt_idx++) {
+		timing_idx = interrupts[interrupt_idx].host_radio_interrupt_timing_idx;
+		if (timing_idx >= TIM2_TIMINGS_ARRAY_CCR4_IDX) continue;
+		latency_ns = interrupts[interrupt_idx].host_radio_interrupt_start_time_ns - interrupts[interrupt_idx].host_radio_interrupt_event_time_ns;
+		completion_ns = interrupts[interrupt_idx].host_radio_interrupt_end_time_ns - interrupts[interrupt_idx].host_radio_interrupt_event_time_ns;
+		margin_ns = ((long long) next_event_us[timing_idx] * 1000) - (long long) completion_ns;
+		if ((result -> rf_api_sim_interrupt_count[timing_idx] == 0) || (margin_ns < (result -> rf_api_sim_margin_min_ns[timing_idx]))) {
+			result -> rf_api_sim_margin_min_ns[timing_idx] = margin_ns;
+		}
+		if (latency_ns > (result -> rf_api_sim_latency_max_ns[timing_idx])) {
+			result -> rf_api_sim_latency_max_ns[timing_idx] = latency_ns;
+		}
+		if (completion_ns > (result -> rf_api_sim_completion_max_ns[timing_idx])) {
+			result -> rf_api_sim_completion_max_ns[timing_idx] = completion_ns;
+		}
+		result -> rf_api_sim_interrupt_count[timing_idx]++;
+	}
+}
+
+/* SEND RANDOM FRAMES WITH A GIVEN MODULATION AND PRINT RESULTS.
+ * @param name:			Modulation name.
+ * @param modulation:	Modulation type.
+ * @param frequency_hz:	Center of the macro channel.
+ * @return:				None.
+ */
+static void RF_API_SIM_Run(const char* name, sfx_modulation_type_t modulation, unsigned int frequency_hz) {
+	// Local variables.
+	const char* event_names[TIM2_TIMINGS_ARRAY_CCR4_IDX] = {"ARR", "CCR1", "CCR2", "CCR3"};
+	RF_API_SIM_Result result;
+	sfx_u8 stream[RF_API_SIM_FRAME_LENGTH_BYTES_MAX];
+	sfx_u8 size = 0;
+	unsigned int frame_idx = 0;
+	unsigned char byte_idx = 0;
+	unsigned char timing_idx = 0;
+	unsigned char failed = 0;
+	memset(&result, 0, sizeof(RF_API_SIM_Result));
+	for (frame_idx=0 ; frame_idx<rf_api_sim_ctx.rf_api_sim_frames ; frame_idx++) {
+		// Random frame on a random channel.
+		size = RF_API_SIM_FRAME_LENGTH_BYTES_MIN + (rand() % (RF_API_SIM_FRAME_LENGTH_BYTES_MAX - RF_API_SIM_FRAME_LENGTH_BYTES_MIN + 1));
+		for (byte_idx=0 ; byte_idx<size ; byte_idx++) {
+			stream[byte_idx] = (sfx_u8) rand();
+		}
+		RF_API_init(SFX_RF_MODE_TX);
+		RF_API_change_frequency(frequency_hz - (RF_API_SIM_MACRO_CHANNEL_WIDTH_HZ / 2) + (rand() % RF_API_SIM_MACRO_CHANNEL_WIDTH_HZ));
+		HOST_RADIO_ClearLogs();
+		if (RF_API_send(stream, modulation, size) != SFX_ERR_NONE) {
+			result.rf_api_sim_amplitude_errors++;
+		}
+		if (HOST_RADIO_GetOverflow() != 0) {
+			printf("*** Log overflow on frame %u.\n", frame_idx);
+			rf_api_sim_ctx.rf_api_sim_errors++;
+		}
+		RF_API_SIM_CheckWaveform(stream, size, &result);
+		RF_API_SIM_CheckInterrupts(&result);
+		RF_API_stop();
+		result.rf_api_sim_frames++;
+	}
+	// Print results.
+	printf("%s: %u frames, %u symbols, phase error max %.1f deg (tolerance %.1f), %u phase errors, %u amplitude errors, %u shifts with signal on.\n",
+		name, result.rf_api_sim_frames, result.rf_api_sim_symbols, result.rf_api_sim_phase_error_max_degrees, rf_api_sim_ctx.rf_api_sim_tolerance_degrees,
+		result.rf_api_sim_phase_errors, result.rf_api_sim_amplitude_errors, result.rf_api_sim_splatters);
+	printf("%-8s %10s %18s %18s %18s\n", "Event", "Count", "Latency max (us)", "Done max (us)", "Margin min (us)");
+	for (timing_idx=0 ; timing_idx<TIM2_TIMINGS_ARRAY_CCR4_IDX ; timing_idx++) {
+		printf("%-8s %10u %18.1f %18.1f %18.1f\n", event_names[timing_idx], result.rf_api_sim_interrupt_count[timing_idx],
+			result.rf_api_sim_latency_max_ns[timing_idx] / 1000.0, result.rf_api_sim_completion_max_ns[timing_idx] / 1000.0, result.rf_api_sim_margin_min_ns[timing_idx] / 1000.0);
+		if (result.rf_api_sim_margin_min_ns[timing_idx] < 0) {
+			failed = 1;
+		}
+	}
+	if ((result.rf_api_sim_phase_errors != 0) || (result.rf_api_sim_amplitude_errors != 0) || (result.rf_api_sim_splatters != 0)) {
+		failed = 1;
+	}
+	if (failed != 0) {
+		rf_api_sim_ctx.rf_api_sim_errors++;
+	}
+}
+
+/*** RF API SIM main function ***/
+
+/* MAIN FUNCTION.
+ * @param argc:	Number of arguments.
+ * @param argv:	Options: -n <frames_per_modulation> -l <latency_min_us> -L <latency_max_us> -e <phase_tolerance_degrees> -s <seed>.
+ * @return:		0 if all checks passed, 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+	// Local variables.
+	unsigned int seed = 1;
+	int arg_idx = 0;
+	// Parse options.
+	rf_api_sim_ctx.rf_api_sim_frames = RF_API_SIM_DEFAULT_FRAMES;
+	rf_api_sim_ctx.rf_api_sim_latency_min_us = RF_API_SIM_DEFAULT_LATENCY_MIN_US;
+	rf_api_sim_ctx.rf_api_sim_latency_max_us = RF_API_SIM_DEFAULT_LATENCY_MAX_US;
+	rf_api_sim_ctx.rf_api_sim_tolerance_degrees = RF_API_SIM_DEFAULT_TOLERANCE_DEGREES;
+	for (arg_idx=1 ; (arg_idx + 1)<argc ; arg_idx+=2) {
+		if (strcmp(argv[arg_idx], "-n") == 0) rf_api_sim_ctx.rf_api_sim_frames = atoi(argv[arg_idx + 1]);
+		else if (strcmp(argv[arg_idx], "-l") == 0) rf_api_sim_ctx.rf_api_sim_latency_min_us = atoi(argv[arg_idx + 1]);
+		else if (strcmp(argv[arg_idx], "-L") == 0) rf_api_sim_ctx.rf_api_sim_latency_max_us = atoi(argv[arg_idx + 1]);
+		else if (strcmp(argv[arg_idx], "-e") == 0) rf_api_sim_ctx.rf_api_sim_tolerance_degrees = atof(argv[arg_idx + 1]);
+		else if (strcmp(argv[arg_idx], "-s") == 0) seed = atoi(argv[arg_idx + 1]);
+	}
+	if (rf_api_sim_ctx.rf_api_sim_latency_max_us < rf_api_sim_ctx.rf_api_sim_latency_min_us) {
+		rf_api_sim_ctx.rf_api_sim_latency_max_us = rf_api_sim_ctx.rf_api_sim_latency_min_us;
+	}
+	srand(seed);
+	HOST_RADIO_Init(rf_api_sim_ctx.rf_api_sim_latency_min_us, rf_api_sim_ctx.rf_api_sim_latency_max_us);
+	// Both uplink modulations.
+	printf("Interrupt latency %u to %u us, SPI byte %u ns.\n", rf_api_sim_ctx.rf_api_sim_latency_min_us, rf_api_sim_ctx.rf_api_sim_latency_max_us, HOST_RADIO_SPI_BYTE_DURATION_NS);
+	RF_API_SIM_Run("DBPSK 100bps", SFX_DBPSK_100BPS, RF_API_SIM_RC1_FREQUENCY_HZ);
+	RF_API_SIM_Run("DBPSK 600bps", SFX_DBPSK_600BPS, RF_API_SIM_RC2_FREQUENCY_HZ);
+	return (rf_api_sim_ctx.rf_api_sim_errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,26 @@
+/*
+ * airtime.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef AIRTIME_H
+#define AIRTIME_H
+
+/*** AIRTIME macros ***/
+
+#define AIRTIME_WINDOW_BUDGET_MS	36000 // 1% of one hour (ETSI EN 300 220 868.0-868.6MHz sub-band).
+
+/*** AIRTIME functions ***/
+
+void AIRTIME_Init(void);
+void AIRTIME_Synchronize(void);
+void AIRTIME_Record(unsigned int tx_duration_ms);
+unsigned int AIRTIME_GetUplinkDuration(unsigned char payload_size_bytes, unsigned char bidirectional_flag);
+unsigned char AIRTIME_Admit(unsigned int tx_duration_ms);
+unsigned int AIRTIME_GetWindowDuration(void);
+unsigned int AIRTIME_GetTotalDuration(void);
+void AIRTIME_Checkpoint(void);
+
+#endif /* AIRTIME_H */
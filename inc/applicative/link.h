@@ -0,0 +1,41 @@
+/*
+ * link.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef LINK_H
+#define LINK_H
+
+#include "nvm.h"
+#include "sigfox_types.h"
+
+/*** LINK structures ***/
+
+// Daily radio link statistics (stored in NVM record).
+typedef union {
+	unsigned char raw[NVM_RECORD_LINK_SIZE_BYTES];
+	struct {
+		unsigned uplinks_attempted : 8;
+		unsigned uplinks_failed : 8;
+		unsigned top_error_code : 16; // Most frequent Sigfox library error code.
+		unsigned top_error_count : 8;
+		unsigned tx_duration_seconds : 16;
+		unsigned downlinks_requested : 8;
+		unsigned downlinks_received : 8;
+		unsigned rssi_min_dbm : 8; // RSSI values are stored as absolute values (0 if no downlink was received).
+		unsigned rssi_mean_dbm : 8;
+		unsigned rssi_max_dbm : 8;
+	} __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed)) field;
+} LINK_Statistics;
+
+/*** LINK functions ***/
+
+void LINK_Init(void);
+void LINK_RecordUplink(sfx_error_t sfx_error, unsigned char downlink_request);
+void LINK_GetCurrentDay(LINK_Statistics* link_statistics);
+unsigned char LINK_GetPreviousDay(LINK_Statistics* link_statistics);
+void LINK_Summarize(void);
+
+#endif /* LINK_H */
@@ -0,0 +1,19 @@
+/*
+ * crypto.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef CRYPTO_H
+#define CRYPTO_H
+
+/*** CRYPTO macros ***/
+
+#define CRYPTO_AES_BLOCK_SIZE	16 // 128-bits is 16 bytes.
+
+/*** CRYPTO functions ***/
+
+void CRYPTO_AesEncodeCbc(unsigned char* data_in, unsigned char* data_out, unsigned char number_of_blocks, unsigned char init_vector[CRYPTO_AES_BLOCK_SIZE], unsigned char key[CRYPTO_AES_BLOCK_SIZE]);
+
+#endif /* CRYPTO_H */
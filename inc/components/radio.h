@@ -0,0 +1,36 @@
+/*
+ * radio.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef RADIO_H
+#define RADIO_H
+
+/*** RADIO structures ***/
+
+// Radio power states (SX1232 transceiver, 32MHz TCXO and SKY13317 RF switch), by increasing consumption.
+typedef enum {
+	RADIO_STATE_OFF, // Everything off.
+	RADIO_STATE_SUPPLY, // Transceiver and external ADC supplied through the SPI bus, TCXO off (transceiver not usable).
+	RADIO_STATE_TCXO_WARM, // TCXO on, transceiver off.
+	RADIO_STATE_SLEEP, // TCXO on, transceiver powered in sleep mode (registers retained).
+	RADIO_STATE_STANDBY, // TCXO on, transceiver in standby mode.
+	RADIO_STATE_SYNTH_TX, // Synthesizer locked on TX frequency.
+	RADIO_STATE_SYNTH_RX, // Synthesizer locked on RX frequency.
+	RADIO_STATE_TX, // PA on, RF switch on TX path.
+	RADIO_STATE_RX, // LNA on, RF switch on RX path.
+	RADIO_STATE_LAST
+} RADIO_State;
+
+/*** RADIO functions ***/
+
+void RADIO_Init(void);
+void RADIO_DisableGpio(void);
+unsigned char RADIO_SetState(RADIO_State state);
+void RADIO_Synchronize(void);
+RADIO_State RADIO_GetState(void);
+unsigned int RADIO_GetResidency(RADIO_State state);
+
+#endif /* RADIO_H */
@@ -18,6 +18,13 @@
 #define SX1232_FXOSC_HZ							32000000
 #define SX1232_CLKOUT_PRESCALER					2
 #define SX1232_CLKOUT_FREQUENCY_KHZ				((SX1232_FXOSC_HZ) / (SX1232_CLKOUT_PRESCALER * 1000))
+#define SX1232_TCXO_WARM_UP_MS					100
+
+// RF frequency registers size.
+#define SX1232_FRF_SIZE_BYTES					3
+
+// Configuration register image size (see configuration spans in sx1232.c).
+#define SX1232_CONFIGURATION_IMAGE_SIZE			49
 
 // Output power ranges.
 #define SX1232_OUTPUT_POWER_RFO_MIN				0
@@ -103,10 +110,16 @@ void SX1232_DisableGpio(void);
 void SX1232_Tcxo(unsigned char tcxo_enable);
 
 // Common settings.
+void SX1232_ReadRegisterImage(unsigned char first_addr, unsigned char* image, unsigned char length);
+void SX1232_WriteRegisterImage(unsigned char first_addr, unsigned char* image, unsigned char length);
+void SX1232_SaveConfiguration(unsigned char image[SX1232_CONFIGURATION_IMAGE_SIZE]);
+unsigned char SX1232_RestoreConfiguration(unsigned char image[SX1232_CONFIGURATION_IMAGE_SIZE]);
 void SX1232_SetOscillator(SX1232_Oscillator oscillator);
 void SX1232_SetMode(SX1232_Mode mode);
 void SX1232_SetModulation(SX1232_Modulation modulation, SX1232_ModulationShaping modulation_shaping);
 void SX1232_SetRfFrequency(unsigned int rf_frequency_hz);
+void SX1232_ComputeFrf(unsigned int rf_frequency_hz, unsigned char frf[SX1232_FRF_SIZE_BYTES]);
+void SX1232_WriteFrf(unsigned char frf[SX1232_FRF_SIZE_BYTES]);
 void SX1232_EnableFastFrequencyHopping(void);
 unsigned int SX1232_GetRfFrequency(void);
 void SX1232_SetFskDeviation(unsigned short fsk_deviation_hz);
@@ -119,8 +132,6 @@ unsigned short SX1232_GetIrqFlags(void);
 void SX1232_SelectRfOutputPin(SX1232_RfOutputPin rf_output_pin);
 void SX1232_SetRfOutputPower(unsigned char rf_output_power_dbm);
 void SX1232_EnableLowPnPll(void);
-void SX1232_StartCw(void);
-void SX1232_StopCw(void);
 
 // RX functions.
 void SX1232_SetRxBandwidth(SX1232_RxBwMantissa rxbw_mantissa, unsigned char rxbw_exponent);
@@ -131,5 +142,14 @@ void SX1232_SetDataLength(unsigned char data_length_bytes);
 void SX1232_ConfigureRssi(signed char rssi_offset, SX1232_RssiSampling rssi_sampling);
 unsigned char SX1232_GetRssi(void);
 void SX1232_ReadFifo(unsigned char* rx_data, unsigned char rx_data_length);
+void SX1232_EnableDioInterrupts(void);
+void SX1232_DisableDioInterrupts(void);
+volatile unsigned char SX1232_GetDio0Flag(void);
+volatile unsigned char SX1232_GetDio2Flag(void);
+
+/*** SX1232 utility functions ***/
+
+void SX1232_Dio0EdgeCallback(void);
+void SX1232_Dio2EdgeCallback(void);
 
 #endif /* SX1232_H */
@@ -16,5 +16,6 @@ void ADC1_PerformAllMeasurements(void);
 void ADC1_GetMcuVoltage(unsigned int* supply_voltage_mv);
 void ADC1_GetMcuTemperatureComp2(signed char* mcu_temperature_degrees);
 void ADC1_GetMcuTemperatureComp1(unsigned char* mcu_temperature_degrees);
+unsigned char ADC1_GetMeasurementAge(unsigned int* measurement_age_ms);
 
 #endif /* ADC_H */
@@ -12,10 +12,24 @@
 
 #define AES_BLOCK_SIZE 	16 // 128-bits is 16 bytes.
 
+/*** AES structures ***/
+
+typedef enum {
+	AES_TRANSFER_CPU,
+	AES_TRANSFER_DMA,
+	AES_TRANSFER_ERROR,
+	AES_TRANSFER_LAST
+} AES_Transfer;
+
 /*** AES functions ***/
 
 void AES_Init(void);
 void AES_Disable(void);
+void AES_SetKey(unsigned char key[AES_BLOCK_SIZE]);
+void AES_SetInitVector(unsigned char init_vector[AES_BLOCK_SIZE]);
+unsigned char AES_EncodeBlock(unsigned char data_in[AES_BLOCK_SIZE], unsigned char data_out[AES_BLOCK_SIZE]);
+void AES_Stop(void);
 void AES_EncodeCbc(unsigned char data_in[AES_BLOCK_SIZE], unsigned char data_out[AES_BLOCK_SIZE], unsigned char init_vector[AES_BLOCK_SIZE], unsigned char key[AES_BLOCK_SIZE]);
+AES_Transfer AES_EncodeCbcBuffer(unsigned char* data_in, unsigned char* data_out, unsigned char number_of_blocks, unsigned char init_vector[AES_BLOCK_SIZE], unsigned char key[AES_BLOCK_SIZE], AES_Transfer transfer);
 
 #endif /* AES_H_ */
@@ -8,12 +8,28 @@
 #ifndef DMA_H
 #define DMA_H
 
+/*** DMA structures ***/
+
+typedef enum {
+	DMA_STATUS_RUNNING,
+	DMA_STATUS_COMPLETE,
+	DMA_STATUS_ERROR
+} DMA_Status;
+
 /*** DMA functions ***/
 
 void DMA1_InitChannel6(void);
 void DMA1_StartChannel6(void);
 void DMA1_StopChannel6(void);
 void DMA1_SetChannel6DestAddr(unsigned int dest_buf_addr, unsigned short dest_buf_size);
+void DMA1_InitChannels2_3(void);
+void DMA1_StartChannels2_3(unsigned int tx_buf_addr, unsigned char increment_tx, unsigned int rx_buf_addr, unsigned char increment_rx, unsigned short size);
+DMA_Status DMA1_GetChannels2_3Status(void);
+void DMA1_StopChannels2_3(void);
+void DMA1_InitChannels1_2(void);
+void DMA1_StartChannels1_2(unsigned int in_buf_addr, unsigned int out_buf_addr, unsigned short number_of_words);
+DMA_Status DMA1_GetChannels1_2Status(void);
+void DMA1_StopChannels1_2(void);
 void DMA1_Disable(void);
 
 #endif /* DMA_H */
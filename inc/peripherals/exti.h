@@ -37,6 +37,7 @@ typedef enum {
 
 void EXTI_Init(void);
 void EXTI_ConfigureGpio(const GPIO* gpio, EXTI_Trigger edge_trigger);
+void EXTI_DisableGpio(const GPIO* gpio);
 void EXTI_ConfigureLine(EXTI_Line line, EXTI_Trigger edge_trigger);
 void EXTI_ClearAllFlags(void);
 
@@ -8,6 +8,8 @@
 #ifndef NVM_H
 #define NVM_H
 
+#include "mode.h"
+
 /*** NVM macros ***/
 
 // Sigfox device parameters.
@@ -17,6 +19,8 @@
 #define NVM_SIGFOX_SEQ_ADDRESS_OFFSET				22
 #define NVM_SIGFOX_FH_ADDRESS_OFFSET				24
 #define NVM_SIGFOX_RL_ADDRESS_OFFSET				26
+#define NVM_SIGFOX_ID_LENGTH_BYTES					4
+#define NVM_SIGFOX_KEY_LENGTH_BYTES					16
 // Device configuration (mapped on downlink frame).
 #define NVM_CONFIG_START_ADDRESS_OFFSET				27
 #define NVM_CONFIG_LOCAL_UTC_OFFSET_ADDRESS_OFFSET	27
@@ -31,6 +35,113 @@
 #define NVM_RTC_PWKUP_MONTH_ADDRESS_OFFSET			40
 #define NVM_RTC_PWKUP_DATE_ADDRESS_OFFSET			41
 #define NVM_RTC_PWKUP_HOURS_ADDRESS_OFFSET			42
+// Radio.
+#define NVM_TX_POWER_BACKOFF_ADDRESS_OFFSET			43
+#define NVM_TX_POWER_BACKOFF_MAX_DB					10 // Maximum reduction applied by the uplink output power control.
+// Journal (wear-levelled storage of the fields rewritten every hour).
+#define NVM_JOURNAL_START_ADDRESS_OFFSET			64
+#define NVM_JOURNAL_RECORD_SIZE_BYTES				8 // Data word and commit word.
+#ifdef HW1_0
+#define NVM_JOURNAL_SIZE_RECORDS					60 // Must not be a multiple of 16 (sequence number wrap-around).
+#endif
+#ifdef HW2_0
+#define NVM_JOURNAL_SIZE_RECORDS					250 // Must not be a multiple of 16 (sequence number wrap-around).
+#endif
+#define NVM_JOURNAL_END_ADDRESS_OFFSET				(NVM_JOURNAL_START_ADDRESS_OFFSET + (NVM_JOURNAL_SIZE_RECORDS * NVM_JOURNAL_RECORD_SIZE_BYTES))
+// Records (power-fail atomic blocks: | VERSION (1) | SEQUENCE (1) | CRC16 (2) | DATA |, written on the oldest copy).
+#define NVM_RECORD_HEADER_SIZE_BYTES				4
+#define NVM_RECORD_CONFIG_ADDRESS_OFFSET			NVM_JOURNAL_END_ADDRESS_OFFSET
+#define NVM_RECORD_CONFIG_SIZE_BYTES				8
+#define NVM_RECORD_CONFIG_NUMBER_OF_COPIES			2
+#define NVM_RECORD_SIGFOX_ADDRESS_OFFSET			(NVM_RECORD_CONFIG_ADDRESS_OFFSET + (NVM_RECORD_CONFIG_NUMBER_OF_COPIES * (NVM_RECORD_HEADER_SIZE_BYTES + NVM_RECORD_CONFIG_SIZE_BYTES)))
+#define NVM_RECORD_SIGFOX_SIZE_BYTES				8 // PN, SEQ, FH and RL (Sigfox library NV memory block) + padding.
+#ifdef HW1_0
+#define NVM_RECORD_SIGFOX_NUMBER_OF_COPIES			8 // Record is written on each uplink.
+#endif
+#ifdef HW2_0
+#define NVM_RECORD_SIGFOX_NUMBER_OF_COPIES			32 // Record is written on each uplink.
+#endif
+#define NVM_RECORD_LINK_ADDRESS_OFFSET				(NVM_RECORD_SIGFOX_ADDRESS_OFFSET + (NVM_RECORD_SIGFOX_NUMBER_OF_COPIES * (NVM_RECORD_HEADER_SIZE_BYTES + NVM_RECORD_SIGFOX_SIZE_BYTES)))
+#define NVM_RECORD_LINK_SIZE_BYTES					12 // Radio link statistics of the previous day.
+#define NVM_RECORD_LINK_NUMBER_OF_COPIES			2 // Record is written once a day.
+#define NVM_RECORD_END_ADDRESS_OFFSET				(NVM_RECORD_LINK_ADDRESS_OFFSET + (NVM_RECORD_LINK_NUMBER_OF_COPIES * (NVM_RECORD_HEADER_SIZE_BYTES + NVM_RECORD_LINK_SIZE_BYTES)))
+// Backlog (ring of measurements which could not be sent: | SEQUENCE (1) | STATUS (1) | CRC16 (2) | DATA |).
+#define NVM_BACKLOG_ADDRESS_OFFSET					NVM_RECORD_END_ADDRESS_OFFSET
+#define NVM_BACKLOG_HEADER_SIZE_BYTES				4
+#ifdef IM
+#define NVM_BACKLOG_DATA_SIZE_BYTES					8 // Weather data and UTC timestamp (must be a multiple of 4).
+#else
+#define NVM_BACKLOG_DATA_SIZE_BYTES					12 // Weather data and UTC timestamp (must be a multiple of 4).
+#endif
+#ifdef HW1_0
+#ifdef IM
+#define NVM_BACKLOG_SIZE_ENTRIES					27 // Must be lower than 128 (sequence number comparison).
+#else
+#define NVM_BACKLOG_SIZE_ENTRIES					20 // Must be lower than 128 (sequence number comparison).
+#endif
+#endif
+#ifdef HW2_0
+#define NVM_BACKLOG_SIZE_ENTRIES					120 // Must be lower than 128 (sequence number comparison).
+#endif
+#define NVM_BACKLOG_END_ADDRESS_OFFSET				(NVM_BACKLOG_ADDRESS_OFFSET + (NVM_BACKLOG_SIZE_ENTRIES * (NVM_BACKLOG_HEADER_SIZE_BYTES + NVM_BACKLOG_DATA_SIZE_BYTES)))
+
+/*** NVM structures ***/
+
+// Typed fields (see descriptor table in nvm.c for storage, default value and range).
+typedef enum {
+	// Device configuration (mapped on downlink frame).
+	NVM_FIELD_LOCAL_UTC_OFFSET,
+	NVM_FIELD_UPLINK_FRAMES,
+	NVM_FIELD_GPS_TIMEOUT,
+	NVM_FIELD_UPLINK_SLOT_WINDOW,
+	NVM_FIELD_UPLINK_SLOT_JITTER,
+	// Period management and status.
+	NVM_FIELD_DAY_COUNT,
+	NVM_FIELD_HOURS_COUNT,
+	NVM_FIELD_MONITORING_STATUS_BYTE,
+	// RTC.
+	NVM_FIELD_RTC_PWKUP_YEAR,
+	NVM_FIELD_RTC_PWKUP_MONTH,
+	NVM_FIELD_RTC_PWKUP_DATE,
+	NVM_FIELD_RTC_PWKUP_HOURS,
+	// Radio.
+	NVM_FIELD_TX_POWER_BACKOFF,
+	NVM_FIELD_AIRTIME_WINDOW,
+	NVM_FIELD_LAST
+} NVM_Field;
+
+typedef enum {
+	NVM_RECORD_CONFIG,
+	NVM_RECORD_SIGFOX,
+	NVM_RECORD_LINK,
+	NVM_RECORD_LAST
+} NVM_Record;
+
+// Typed accessors: NVM_Get<Name>() and NVM_Set<Name>(value) are generated from this list.
+#define NVM_TYPED_FIELDS \
+	NVM_TYPED_FIELD(LocalUtcOffset, NVM_FIELD_LOCAL_UTC_OFFSET, unsigned char) \
+	NVM_TYPED_FIELD(UplinkFrames, NVM_FIELD_UPLINK_FRAMES, unsigned char) \
+	NVM_TYPED_FIELD(GpsTimeout, NVM_FIELD_GPS_TIMEOUT, unsigned char) \
+	NVM_TYPED_FIELD(UplinkSlotWindow, NVM_FIELD_UPLINK_SLOT_WINDOW, unsigned char) \
+	NVM_TYPED_FIELD(UplinkSlotJitter, NVM_FIELD_UPLINK_SLOT_JITTER, unsigned char) \
+	NVM_TYPED_FIELD(DayCount, NVM_FIELD_DAY_COUNT, unsigned char) \
+	NVM_TYPED_FIELD(HoursCount, NVM_FIELD_HOURS_COUNT, unsigned char) \
+	NVM_TYPED_FIELD(MonitoringStatusByte, NVM_FIELD_MONITORING_STATUS_BYTE, unsigned char) \
+	NVM_TYPED_FIELD(RtcPwkupYear, NVM_FIELD_RTC_PWKUP_YEAR, unsigned short) \
+	NVM_TYPED_FIELD(RtcPwkupMonth, NVM_FIELD_RTC_PWKUP_MONTH, unsigned char) \
+	NVM_TYPED_FIELD(RtcPwkupDate, NVM_FIELD_RTC_PWKUP_DATE, unsigned char) \
+	NVM_TYPED_FIELD(RtcPwkupHours, NVM_FIELD_RTC_PWKUP_HOURS, unsigned char) \
+	NVM_TYPED_FIELD(TxPowerBackoff, NVM_FIELD_TX_POWER_BACKOFF, unsigned char) \
+	NVM_TYPED_FIELD(AirtimeWindow, NVM_FIELD_AIRTIME_WINDOW, unsigned short)
+
+// EEPROM areas (used for program operations statistics).
+typedef enum {
+	NVM_AREA_FIXED,
+	NVM_AREA_JOURNAL,
+	NVM_AREA_RECORDS,
+	NVM_AREA_BACKLOG,
+	NVM_AREA_LAST
+} NVM_Area;
 
 /*** NVM functions ***/
 
@@ -39,5 +150,24 @@ void NVM_Disable(void);
 void NVM_ReadByte(unsigned short address_offset, unsigned char* byte_to_read);
 void NVM_WriteByte(unsigned short address_offset, unsigned char byte_to_store);
 void NVM_ResetDefault(void);
+void NVM_Init(void);
+void NVM_ReadField(NVM_Field field, unsigned short* value);
+unsigned char NVM_WriteField(NVM_Field field, unsigned short value);
+#define NVM_TYPED_FIELD(name, field, type) \
+	type NVM_Get##name(void); \
+	unsigned char NVM_Set##name(type value);
+NVM_TYPED_FIELDS
+#undef NVM_TYPED_FIELD
+void NVM_ReadSigfoxId(unsigned char id[NVM_SIGFOX_ID_LENGTH_BYTES]);
+void NVM_WriteSigfoxId(unsigned char id[NVM_SIGFOX_ID_LENGTH_BYTES]);
+void NVM_ReadSigfoxKey(unsigned char key[NVM_SIGFOX_KEY_LENGTH_BYTES]);
+void NVM_WriteSigfoxKey(unsigned char key[NVM_SIGFOX_KEY_LENGTH_BYTES]);
+unsigned char NVM_RecordRead(NVM_Record record, unsigned char* data);
+void NVM_RecordWrite(NVM_Record record, unsigned char* data);
+void NVM_BacklogPush(unsigned char* data);
+unsigned char NVM_BacklogPeek(unsigned char* data);
+void NVM_BacklogPop(void);
+unsigned char NVM_BacklogGetCount(void);
+unsigned int NVM_GetProgramCount(NVM_Area area);
 
 #endif /* NVM_H */
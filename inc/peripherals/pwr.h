@@ -11,6 +11,7 @@
 /*** PWR functions ***/
 
 void PWR_Init(void);
+void PWR_EnterSleepMode(void);
 void PWR_EnterLowPowerSleepMode(void);
 void PWR_EnterStopMode(void);
 
@@ -17,6 +17,7 @@ void RTC_Reset(void);
 void RTC_Init(unsigned char* rtc_use_lse, unsigned int lsi_freq_hz);
 void RTC_Calibrate(Timestamp* gps_timestamp);
 void RTC_GetTimestamp(Timestamp* rtc_timestamp);
+unsigned int RTC_GetTimeOfDayMilliseconds(void);
 
 void RTC_EnableAlarmAInterrupt(void);
 void RTC_DisableAlarmAInterrupt(void);
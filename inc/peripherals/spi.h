@@ -20,6 +20,7 @@ void SPI1_SetClockPolarity(unsigned char polarity);
 #endif
 unsigned char SPI1_WriteByte(unsigned char tx_data);
 unsigned char SPI1_ReadByte(unsigned char tx_data, unsigned char* rx_data);
+unsigned char SPI1_TransferBytes(unsigned char* tx_data, unsigned char* rx_data, unsigned char length);
 #ifdef HW1_0
 unsigned char SPI1_WriteShort(unsigned short tx_data);
 unsigned char SPI1_ReadShort(unsigned short tx_data, unsigned short* rx_data);
@@ -0,0 +1,25 @@
+/*
+ * systick.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef SYSTICK_H
+#define SYSTICK_H
+
+/*** SYSTICK macros ***/
+
+#define SYSTICK_CYCLE_COUNT_MAX		0x00FFFFFF // 24-bits down counter.
+
+/*** SYSTICK functions ***/
+
+// Cycle count and timeout share the timer: they must not be nested.
+
+void SYSTICK_StartCycleCount(void);
+unsigned int SYSTICK_StopCycleCount(void);
+void SYSTICK_StartTimeout(unsigned int timeout_cycles);
+unsigned char SYSTICK_GetTimeoutFlag(void);
+void SYSTICK_StopTimeout(void);
+
+#endif /* SYSTICK_H */
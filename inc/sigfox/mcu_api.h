@@ -106,6 +106,16 @@
 
 /** @}*/
 
+/*!
+ * \enum MCU_API_AesBackend
+ * \brief AES-128 implementation used by MCU_API_aes_128_cbc_encrypt.
+ */
+typedef enum {
+	MCU_API_AES_BACKEND_HARDWARE = 0,   /*!< STM32 AES peripheral */
+	MCU_API_AES_BACKEND_SOFTWARE,       /*!< Portable software implementation (bit-identical) */
+	MCU_API_AES_BACKEND_LAST
+} MCU_API_AesBackend;
+
 
 /*!******************************************************************
  * \fn sfx_u8 MCU_API_malloc(sfx_u16 size, sfx_u8 **returned_pointer)
@@ -362,4 +372,28 @@ sfx_u8 MCU_API_get_msg_counter_rollover(e_sfx_msg_counter_rollover* msgCounterRo
  *******************************************************************/
 sfx_u8 MCU_API_get_initial_pac(sfx_u8 initial_pac[PAC_LENGTH]);
 
+/*!******************************************************************
+ * \fn void MCU_API_GetAesStatistics(sfx_u32* calls_count, sfx_u8* number_of_blocks, sfx_u32* cycle_count)
+ * \brief Get the benchmark of the last MCU_API_aes_128_cbc_encrypt call.
+ *
+ * \param[in] none
+ * \param[out] sfx_u32* calls_count             Number of encryptions performed since start-up
+ * \param[out] sfx_u8* number_of_blocks         Number of blocks encrypted during the last call
+ * \param[out] sfx_u32* cycle_count             Duration of the last call in CPU cycles
+ *
+ * \retval none
+ *******************************************************************/
+void MCU_API_GetAesStatistics(sfx_u32* calls_count, sfx_u8* number_of_blocks, sfx_u32* cycle_count);
+
+/*!******************************************************************
+ * \fn void MCU_API_SetAesBackend(MCU_API_AesBackend aes_backend)
+ * \brief Select the AES-128 implementation used by MCU_API_aes_128_cbc_encrypt.
+ *
+ * \param[in] MCU_API_AesBackend aes_backend    Hardware peripheral (default) or software implementation
+ * \param[out] none
+ *
+ * \retval none
+ *******************************************************************/
+void MCU_API_SetAesBackend(MCU_API_AesBackend aes_backend);
+
 #endif /* MCU_API_H */
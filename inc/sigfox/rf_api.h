@@ -200,6 +200,7 @@ sfx_u8 RF_API_change_frequency(sfx_u32 frequency);
  *                                            if a frame has been received, as defined in sigfox_api.h file.
  *
  * \retval SFX_ERR_NONE:                      No error
+ * \retval RF_ERR_API_WAIT_FRAME:             Timeout or transceiver did not reach RX mode
  *******************************************************************/
 sfx_u8 RF_API_wait_frame(sfx_u8* frame, sfx_s16* rssi, sfx_rx_state_enum_t* state);
 
@@ -221,6 +222,7 @@ sfx_u8 RF_API_wait_frame(sfx_u8* frame, sfx_s16* rssi, sfx_rx_state_enum_t* stat
  *                                            as per defined in sigfox_api.h file.
  *
  * \retval SFX_ERR_NONE:                      No error
+ * \retval RF_ERR_API_WAIT_CLEAR_CHANNEL:     Transceiver did not reach RX or standby mode
  *******************************************************************/
 sfx_u8 RF_API_wait_for_clear_channel(sfx_u8 cs_min, sfx_s8 cs_threshold, sfx_rx_state_enum_t* state);
 
@@ -247,4 +249,78 @@ sfx_u8 RF_API_get_version(sfx_u8** version, sfx_u8* size);
  *******************************************************************/
 void RF_API_SetIrqFlag(void);
 
+/*!******************************************************************
+ * \fn void RF_API_SetCarrierSenseWindow(sfx_u16 window_ms)
+ * \brief Set maximum carrier sense window used by RF_API_wait_for_clear_channel.
+ *
+ * \param[in] sfx_u16 window_ms                 Window duration in milliseconds
+ * \param[out] none
+ *
+ * \retval none
+ *******************************************************************/
+void RF_API_SetCarrierSenseWindow(sfx_u16 window_ms);
+
+/*!******************************************************************
+ * \fn void RF_API_GetCarrierSenseStatistics(sfx_u32* check_count, sfx_u32* last_duration_ms, sfx_u32* total_duration_ms)
+ * \brief Get the time spent in RX for clear channel assessment since start-up.
+ *
+ * \param[in] none
+ * \param[out] sfx_u32* check_count             Number of clear channel assessments
+ * \param[out] sfx_u32* last_duration_ms        Duration of the last assessment in milliseconds
+ * \param[out] sfx_u32* total_duration_ms       Cumulated duration of all assessments in milliseconds
+ *
+ * \retval none
+ *******************************************************************/
+void RF_API_GetCarrierSenseStatistics(sfx_u32* check_count, sfx_u32* last_duration_ms, sfx_u32* total_duration_ms);
+
+/*!******************************************************************
+ * \fn void RF_API_SetDownlinkSniffing(sfx_u16 rx_slot_ms, sfx_u16 sleep_slot_ms)
+ * \brief Set duty ratio of the transceiver during the downlink window.
+ *
+ * \param[in] sfx_u16 rx_slot_ms                RX slot duration in milliseconds (30ms minimum: RX start-up and preamble detection)
+ * \param[in] sfx_u16 sleep_slot_ms             Sleep slot duration in milliseconds (16ms maximum to catch the preamble, 0 to listen continuously)
+ * \param[out] none
+ *
+ * \retval none
+ *******************************************************************/
+void RF_API_SetDownlinkSniffing(sfx_u16 rx_slot_ms, sfx_u16 sleep_slot_ms);
+
+/*!******************************************************************
+ * \fn void RF_API_GetConfigurationStatistics(sfx_u8* image_restored, sfx_u8* registers_written, sfx_u16* duration_us)
+ * \brief Get the benchmark of the last transceiver configuration performed by RF_API_init.
+ *
+ * \param[in] none
+ * \param[out] sfx_u8* image_restored          0 if all parameters were programmed, 1 if the cached register image was restored
+ * \param[out] sfx_u8* registers_written       Number of registers written during the restore
+ * \param[out] sfx_u16* duration_us            Configuration duration in microseconds
+ *
+ * \retval none
+ *******************************************************************/
+void RF_API_GetConfigurationStatistics(sfx_u8* image_restored, sfx_u8* registers_written, sfx_u16* duration_us);
+
+/*!******************************************************************
+ * \fn void RF_API_GetDownlinkRssi(sfx_u8* rssi_retrieved, sfx_s16* rssi)
+ * \brief Get the RSSI of the frame received during the last downlink window.
+ *
+ * \param[in] none
+ * \param[out] sfx_u8* rssi_retrieved          1 if a frame was received with a valid RSSI, 0 otherwise
+ * \param[out] sfx_s16* rssi                   RSSI in dBm
+ *
+ * \retval none
+ *******************************************************************/
+void RF_API_GetDownlinkRssi(sfx_u8* rssi_retrieved, sfx_s16* rssi);
+
+/*!******************************************************************
+ * \fn void RF_API_UpdateOutputPower(sfx_u8 downlink_received)
+ * \brief Update the uplink output power reduction stored in NVM according to
+ * the result of the last downlink. Must be called once the Sigfox library has
+ * returned, so that only authenticated frames decrease the output power.
+ *
+ * \param[in] sfx_u8 downlink_received          1 if the downlink frame was authenticated, 0 if it was lost
+ * \param[out] none
+ *
+ * \retval none
+ *******************************************************************/
+void RF_API_UpdateOutputPower(sfx_u8 downlink_received);
+
 #endif /* RF_API_H */
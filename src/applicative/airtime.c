@@ -0,0 +1,157 @@
+/*
+ * airtime.c
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "airtime.h"
+
+#include "nvm.h"
+#include "rtc.h"
+
+/*** AIRTIME local macros ***/
+
+// Sliding window: ring of 5 minutes buckets, one more than an hour so that the whole last hour is always covered.
+#define AIRTIME_BUCKET_DURATION_MS				300000
+#define AIRTIME_WINDOW_NUMBER_OF_BUCKETS		13
+#define AIRTIME_BUCKETS_PER_DAY					(86400000 / AIRTIME_BUCKET_DURATION_MS)
+// Sigfox uplink frame duration estimation (RC1).
+#define AIRTIME_UPLINK_BIT_DURATION_MS			10 // 100bps.
+#define AIRTIME_UPLINK_OVERHEAD_BYTES			14 // Preamble, frame type, header, device ID, authentication and CRC.
+#define AIRTIME_UPLINK_NUMBER_OF_FRAMES			3 // Initial frame and 2 repetitions.
+#define AIRTIME_UPLINK_ACK_PAYLOAD_SIZE_BYTES	8 // Downlink confirmation control frame (sent once).
+
+/*** AIRTIME local structures ***/
+
+typedef struct {
+	unsigned int airtime_bucket_ms[AIRTIME_WINDOW_NUMBER_OF_BUCKETS];
+	unsigned int airtime_window_ms; // Sum of all buckets.
+	unsigned char airtime_head_idx; // Bucket of the current slot.
+	unsigned short airtime_head_slot; // Index of the current slot since midnight.
+	unsigned int airtime_total_ms; // Cumulated airtime since start-up.
+} AIRTIME_Context;
+
+/*** AIRTIME local global variables ***/
+
+static AIRTIME_Context airtime_ctx;
+
+/*** AIRTIME local functions ***/
+
+/* GET CURRENT SLOT INDEX.
+ * @param:	None.
+ * @return:	Index of the current bucket slot since midnight.
+ */
+static unsigned short AIRTIME_GetCurrentSlot(void) {
+	return (RTC_GetTimeOfDayMilliseconds() / AIRTIME_BUCKET_DURATION_MS);
+}
+
+/* SLIDE WINDOW UP TO CURRENT TIME.
+ * @param:	None.
+ * @return:	None.
+ */
+static void AIRTIME_Update(void) {
+	// Compute number of elapsed slots (with midnight roll-over).
+	unsigned short current_slot = AIRTIME_GetCurrentSlot();
+	unsigned short elapsed_slots = (current_slot + AIRTIME_BUCKETS_PER_DAY - airtime_ctx.airtime_head_slot) % AIRTIME_BUCKETS_PER_DAY;
+	// Expire oldest buckets (bounded by the window size).
+	if (elapsed_slots > AIRTIME_WINDOW_NUMBER_OF_BUCKETS) {
+		elapsed_slots = AIRTIME_WINDOW_NUMBER_OF_BUCKETS;
+	}
+	while (elapsed_slots > 0) {
+		airtime_ctx.airtime_head_idx = (airtime_ctx.airtime_head_idx + 1) % AIRTIME_WINDOW_NUMBER_OF_BUCKETS;
+		airtime_ctx.airtime_window_ms -= airtime_ctx.airtime_bucket_ms[airtime_ctx.airtime_head_idx];
+		airtime_ctx.airtime_bucket_ms[airtime_ctx.airtime_head_idx] = 0;
+		elapsed_slots--;
+	}
+	airtime_ctx.airtime_head_slot = current_slot;
+}
+
+/*** AIRTIME functions ***/
+
+/* INIT AIRTIME LEDGER (MUST BE CALLED AFTER NVM AND RTC INIT).
+ * @param:	None.
+ * @return:	None.
+ */
+void AIRTIME_Init(void) {
+	// Reset window.
+	unsigned char bucket_idx = 0;
+	for (bucket_idx=0 ; bucket_idx<AIRTIME_WINDOW_NUMBER_OF_BUCKETS ; bucket_idx++) {
+		airtime_ctx.airtime_bucket_ms[bucket_idx] = 0;
+	}
+	airtime_ctx.airtime_head_idx = 0;
+	airtime_ctx.airtime_head_slot = AIRTIME_GetCurrentSlot();
+	airtime_ctx.airtime_total_ms = 0;
+	// Elapsed time since last checkpoint is unknown after a reset: charge it on the current slot.
+	airtime_ctx.airtime_bucket_ms[airtime_ctx.airtime_head_idx] = NVM_GetAirtimeWindow();
+	airtime_ctx.airtime_window_ms = airtime_ctx.airtime_bucket_ms[airtime_ctx.airtime_head_idx];
+}
+
+/* RE-ANCHOR WINDOW AFTER AN RTC TIME UPDATE.
+ * @param:	None.
+ * @return:	None.
+ */
+void AIRTIME_Synchronize(void) {
+	// Keep recorded airtime in the window whatever the time jump.
+	airtime_ctx.airtime_head_slot = AIRTIME_GetCurrentSlot();
+}
+
+/* RECORD THE DURATION OF A TRANSMISSION.
+ * @param tx_duration_ms:	Effective transmission duration in ms.
+ * @return:					None.
+ */
+void AIRTIME_Record(unsigned int tx_duration_ms) {
+	AIRTIME_Update();
+	airtime_ctx.airtime_bucket_ms[airtime_ctx.airtime_head_idx] += tx_duration_ms;
+	airtime_ctx.airtime_window_ms += tx_duration_ms;
+	airtime_ctx.airtime_total_ms += tx_duration_ms;
+}
+
+/* ESTIMATE THE AIRTIME OF A SIGFOX UPLINK MESSAGE.
+ * @param payload_size_bytes:	Uplink payload size in bytes.
+ * @param bidirectional_flag:	1 if a downlink is requested (confirmation frame is added), 0 otherwise.
+ * @return:						Airtime of the message including repetitions in ms.
+ */
+unsigned int AIRTIME_GetUplinkDuration(unsigned char payload_size_bytes, unsigned char bidirectional_flag) {
+	unsigned int tx_duration_ms = AIRTIME_UPLINK_NUMBER_OF_FRAMES * (8 * AIRTIME_UPLINK_BIT_DURATION_MS) * (AIRTIME_UPLINK_OVERHEAD_BYTES + payload_size_bytes);
+	if (bidirectional_flag != 0) {
+		tx_duration_ms += (8 * AIRTIME_UPLINK_BIT_DURATION_MS) * (AIRTIME_UPLINK_OVERHEAD_BYTES + AIRTIME_UPLINK_ACK_PAYLOAD_SIZE_BYTES);
+	}
+	return tx_duration_ms;
+}
+
+/* CHECK IF A TRANSMISSION FITS IN THE REMAINING DUTY CYCLE BUDGET.
+ * @param tx_duration_ms:	Expected transmission duration in ms.
+ * @return admitted:		1 if the transmission is allowed, 0 otherwise.
+ */
+unsigned char AIRTIME_Admit(unsigned int tx_duration_ms) {
+	AIRTIME_Update();
+	return ((airtime_ctx.airtime_window_ms + tx_duration_ms) <= AIRTIME_WINDOW_BUDGET_MS) ? 1 : 0;
+}
+
+/* GET AIRTIME OF THE LAST HOUR.
+ * @param:	None.
+ * @return:	Airtime in ms.
+ */
+unsigned int AIRTIME_GetWindowDuration(void) {
+	AIRTIME_Update();
+	return airtime_ctx.airtime_window_ms;
+}
+
+/* GET AIRTIME SINCE START-UP.
+ * @param:	None.
+ * @return:	Airtime in ms.
+ */
+unsigned int AIRTIME_GetTotalDuration(void) {
+	return airtime_ctx.airtime_total_ms;
+}
+
+/* SAVE WINDOW AIRTIME IN NVM (NVM MUST BE ENABLED).
+ * @param:	None.
+ * @return:	None.
+ */
+void AIRTIME_Checkpoint(void) {
+	AIRTIME_Update();
+	// Saturate to the budget (NVM field range): the window is then considered full after reset, which is conservative.
+	NVM_SetAirtimeWindow((airtime_ctx.airtime_window_ms > AIRTIME_WINDOW_BUDGET_MS) ? AIRTIME_WINDOW_BUDGET_MS : airtime_ctx.airtime_window_ms);
+}
@@ -10,18 +10,22 @@
 #include "adc.h"
 #include "addon_sigfox_rf_protocol_api.h"
 #include "aes.h"
+#include "airtime.h"
 #include "dps310.h"
-#include "flash_reg.h"
 #include "i2c.h"
+#include "link.h"
 #include "lpuart.h"
 #include "lptim.h"
 #include "mapping.h"
 #include "max11136.h"
+#include "mcu_api.h"
 #include "mode.h"
 #include "neom8n.h"
 #include "nvic.h"
 #include "nvm.h"
+#include "radio.h"
 #include "rain.h"
+#include "rcc.h"
 #include "rf_api.h"
 #include "rtc.h"
 #include "sht3x.h"
@@ -29,6 +33,7 @@
 #include "sigfox_api.h"
 #include "sky13317.h"
 #include "spi.h"
+#include "systick.h"
 #include "sx1232.h"
 #include "tim.h"
 #include "usart.h"
@@ -63,6 +68,14 @@
 #define AT_IN_COMMAND_ID								"AT$ID?"
 #define AT_IN_COMMAND_KEY								"AT$KEY?"
 #define AT_IN_COMMAND_NVMR								"AT$NVMR"
+#define AT_IN_COMMAND_NVMW								"AT$NVMW?"
+#define AT_IN_COMMAND_CS								"AT$CS?"
+#define AT_IN_COMMAND_RFC								"AT$RFC?"
+#define AT_IN_COMMAND_RADIO								"AT$RADIO?"
+#define AT_IN_COMMAND_AIR								"AT$AIR?"
+#define AT_IN_COMMAND_LINK								"AT$LINK?"
+#define AT_IN_COMMAND_AES								"AT$AES?"
+#define AT_IN_COMMAND_AEST								"AT$AEST?"
 #define AT_IN_COMMAND_SF								"AT$SF"
 #define AT_IN_COMMAND_OOB								"AT$SO"
 #define AT_IN_COMMAND_RC								"AT$RC?"
@@ -72,7 +85,7 @@
 #define AT_IN_HEADER_GPS								"AT$GPS=" 		// AT$GPS=<timeout_seconds><CR>.
 #define AT_IN_HEADER_WIND								"AT$WIND="		// AT$WIND=<enable><CR>.
 #define AT_IN_HEADER_RAIN								"AT$RAIN="		// AT$RAIN=<enable><CR>.
-#define AT_IN_HEADER_NVM								"AT$NVM="		// AT$NVM=<address_offset><CR>
+#define AT_IN_HEADER_NVM								"AT$NVM="		// AT$NVM=<field><CR>
 #define AT_IN_HEADER_ID									"AT$ID="		// AT$ID=<id><CR>.
 #define AT_IN_HEADER_KEY								"AT$KEY="		// AT$KEY=<key><CR>.
 #define AT_IN_HEADER_SF									"AT$SF="		// AT$SF=<uplink_data>,<downlink_request><CR>.
@@ -81,6 +94,8 @@
 #define AT_IN_HEADER_RSSI								"AT$RSSI="		// AT$RSSI=<frequency_hz><CR>.
 #define AT_IN_HEADER_TM									"AT$TM="		// AT$TM=<rc>,<test_mode><CR>.
 #define AT_IN_HEADER_RC									"AT$RC="		// AT$RC=<rc><CR>
+#define AT_IN_HEADER_DLS								"AT$DLS="		// AT$DLS=<rx_slot_ms>,<sleep_slot_ms><CR>
+#define AT_IN_HEADER_AESB								"AT$AESB="		// AT$AESB=<number_of_blocks><CR>
 
 // Output commands without data.
 #define AT_OUT_COMMAND_OK								"OK"
@@ -105,17 +120,22 @@
 
 // Parameters errors
 #define AT_OUT_ERROR_TIMEOUT_OVERFLOW					0x80			// Timeout is too large.
-#define AT_OUT_ERROR_NVM_ADDRESS_OVERFLOW				0x81			// Address offset exceeds NVM size.
+#define AT_OUT_ERROR_NVM_FIELD_OVERFLOW					0x81			// Unknown NVM field.
 #define AT_OUT_ERROR_RF_FREQUENCY_UNDERFLOW				0x82			// RF frequency is too low.
 #define AT_OUT_ERROR_RF_FREQUENCY_OVERFLOW				0x83			// RF frequency is too high.
 #define AT_OUT_ERROR_RF_OUTPUT_POWER_OVERFLOW			0x84			// RF output power is too high.
 #define AT_OUT_ERROR_UNKNOWN_RC							0x85			// Unknown RC.
 #define AT_OUT_ERROR_UNKNOWN_TEST_MODE					0x86			// Unknown test mode.
 #define AT_OUT_ERROR_FORBIDDEN_COMMAND					0x87			// Forbidden command.
+#define AT_OUT_ERROR_AES_BLOCKS_OVERFLOW				0x88			// Number of AES blocks is too large.
+#define AT_OUT_ERROR_AES_TRANSFER						0x89			// AES peripheral or DMA transfer failure.
 
 // Components errors
 #define AT_OUT_ERROR_NEOM8N_TIMEOUT						0x87			// GPS timeout.
 
+// AES benchmark buffers size.
+#define AT_AES_BENCHMARK_NUMBER_OF_BLOCKS_MAX			8
+
 // Duration of RSSI command.
 #define AT_RSSI_REPORT_PERIOD_MS						500
 #define AT_RSSI_REPORT_DURATION_MS						60000
@@ -156,6 +176,14 @@ typedef struct {
 /*** AT local global variables ***/
 
 static AT_Context at_ctx;
+#ifdef AT_COMMANDS_NVM
+// FIPS-197 appendix C.1 test vector (single block with null IV).
+static const unsigned char at_aes_test_key[AES_BLOCK_SIZE] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F};
+static const unsigned char at_aes_test_plaintext[AES_BLOCK_SIZE] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF};
+static const unsigned char at_aes_test_ciphertext[AES_BLOCK_SIZE] = {0x69, 0xC4, 0xE0, 0xD8, 0x6A, 0x7B, 0x04, 0x30, 0xD8, 0xCD, 0xB7, 0x80, 0x70, 0xB4, 0xC5, 0x5A};
+static char* at_aes_backend_name[MCU_API_AES_BACKEND_LAST] = {"Hw", "Sw"};
+static char* at_radio_state_name[RADIO_STATE_LAST] = {"OFF", "SUPPLY", "TCXO", "SLEEP", "STANDBY", "FSTX", "FSRX", "TX", "RX"};
+#endif
 #ifdef AT_COMMANDS_RC
 static const sfx_u32 rc2_sm_config[AT_SIGFOX_RC_STD_CONFIG_SIZE] = RC2_SM_CONFIG;
 static const sfx_u32 rc4_sm_config[AT_SIGFOX_RC_STD_CONFIG_SIZE] = RC4_SM_CONFIG;
@@ -654,6 +682,41 @@ static void AT_PrintDownlinkData(sfx_u8* sfx_downlink_data) {
 	USARTx_SendString("\n");
 }
 
+#ifdef AT_COMMANDS_NVM
+/* PRINT RADIO LINK STATISTICS ON USART.
+ * @param link_statistics:	Statistics to print.
+ * @return:					None.
+ */
+static void AT_PrintLinkStatistics(LINK_Statistics* link_statistics) {
+	USARTx_SendString("Uplinks=");
+	USARTx_SendValue((link_statistics -> field).uplinks_attempted, USART_FORMAT_DECIMAL, 0);
+	USARTx_SendString(" Failed=");
+	USARTx_SendValue((link_statistics -> field).uplinks_failed, USART_FORMAT_DECIMAL, 0);
+	if ((link_statistics -> field).top_error_count != 0) {
+		USARTx_SendString(" Error=");
+		USARTx_SendValue((link_statistics -> field).top_error_code, USART_FORMAT_HEXADECIMAL, 1);
+		USARTx_SendString("x");
+		USARTx_SendValue((link_statistics -> field).top_error_count, USART_FORMAT_DECIMAL, 0);
+	}
+	USARTx_SendString(" Tx=");
+	USARTx_SendValue((link_statistics -> field).tx_duration_seconds, USART_FORMAT_DECIMAL, 0);
+	USARTx_SendString("s Downlinks=");
+	USARTx_SendValue((link_statistics -> field).downlinks_received, USART_FORMAT_DECIMAL, 0);
+	USARTx_SendString("/");
+	USARTx_SendValue((link_statistics -> field).downlinks_requested, USART_FORMAT_DECIMAL, 0);
+	if ((link_statistics -> field).downlinks_received != 0) {
+		USARTx_SendString(" Rssi=-");
+		USARTx_SendValue((link_statistics -> field).rssi_min_dbm, USART_FORMAT_DECIMAL, 0);
+		USARTx_SendString("/-");
+		USARTx_SendValue((link_statistics -> field).rssi_mean_dbm, USART_FORMAT_DECIMAL, 0);
+		USARTx_SendString("/-");
+		USARTx_SendValue((link_statistics -> field).rssi_max_dbm, USART_FORMAT_DECIMAL, 0);
+		USARTx_SendString("dBm");
+	}
+	USARTx_SendString("\n");
+}
+#endif
+
 /* PARSE THE CURRENT AT COMMAND BUFFER.
  * @param:	None.
  * @return:	None.
@@ -753,7 +816,7 @@ static void AT_DecodeRxBuffer(void) {
 			if (at_ctx.wind_measurement_flag == 0) {
 				// Trigger external ADC convertions.
 #ifdef HW1_0
-				SPI1_PowerOn();
+				RADIO_SetState(RADIO_STATE_SUPPLY); // External ADC is supplied by the radio SPI bus.
 #endif
 #ifdef HW2_0
 				SPI2_PowerOn();
@@ -761,7 +824,7 @@ static void AT_DecodeRxBuffer(void) {
 				// Run external ADC conversions.
 				MAX11136_PerformMeasurements();
 #ifdef HW1_0
-				SPI1_PowerOff();
+				RADIO_SetState(RADIO_STATE_OFF);
 #endif
 #ifdef HW2_0
 				SPI2_PowerOff();
@@ -900,7 +963,7 @@ static void AT_DecodeRxBuffer(void) {
 				// Perform measurements.
 				I2C1_PowerOn();
 #ifdef HW1_0
-				SPI1_PowerOn();
+				RADIO_SetState(RADIO_STATE_SUPPLY); // External ADC is supplied by the radio SPI bus.
 #endif
 #ifdef HW2_0
 				SPI2_PowerOn();
@@ -908,7 +971,7 @@ static void AT_DecodeRxBuffer(void) {
 				// Run external ADC conversions.
 				MAX11136_PerformMeasurements();
 #ifdef HW1_0
-				SPI1_PowerOff();
+				RADIO_SetState(RADIO_STATE_OFF);
 #endif
 #ifdef HW2_0
 				SPI2_PowerOff();
@@ -1033,44 +1096,222 @@ static void AT_DecodeRxBuffer(void) {
 			NVM_Disable();
 			AT_ReplyOk();
 		}
-		// NVM read command AT$NVM=<address_offset><CR>.
+		// NVM wear command AT$NVMW?<CR>.
+		else if (AT_CompareCommand(AT_IN_COMMAND_NVMW) == AT_NO_ERROR) {
+			// Print number of program operations of each area since start-up.
+			USARTx_SendString("Fixed=");
+			USARTx_SendValue(NVM_GetProgramCount(NVM_AREA_FIXED), USART_FORMAT_DECIMAL, 0);
+			USARTx_SendString(" Journal=");
+			USARTx_SendValue(NVM_GetProgramCount(NVM_AREA_JOURNAL), USART_FORMAT_DECIMAL, 0);
+			USARTx_SendString(" Records=");
+			USARTx_SendValue(NVM_GetProgramCount(NVM_AREA_RECORDS), USART_FORMAT_DECIMAL, 0);
+			USARTx_SendString(" Backlog=");
+			USARTx_SendValue(NVM_GetProgramCount(NVM_AREA_BACKLOG), USART_FORMAT_DECIMAL, 0);
+			USARTx_SendString("\n");
+		}
+		// Carrier sense statistics command AT$CS?<CR>.
+		else if (AT_CompareCommand(AT_IN_COMMAND_CS) == AT_NO_ERROR) {
+			// Print number and duration of clear channel assessments since start-up.
+			sfx_u32 cs_count = 0;
+			sfx_u32 cs_last_duration_ms = 0;
+			sfx_u32 cs_total_duration_ms = 0;
+			RF_API_GetCarrierSenseStatistics(&cs_count, &cs_last_duration_ms, &cs_total_duration_ms);
+			USARTx_SendString("Count=");
+			USARTx_SendValue(cs_count, USART_FORMAT_DECIMAL, 0);
+			USARTx_SendString(" Last=");
+			USARTx_SendValue(cs_last_duration_ms, USART_FORMAT_DECIMAL, 0);
+			USARTx_SendString("ms Total=");
+			USARTx_SendValue(cs_total_duration_ms, USART_FORMAT_DECIMAL, 0);
+			USARTx_SendString("ms\n");
+		}
+		// Radio configuration benchmark command AT$RFC?<CR>.
+		else if (AT_CompareCommand(AT_IN_COMMAND_RFC) == AT_NO_ERROR) {
+			// Print duration of the last RF_API_init configuration.
+			sfx_u8 image_restored = 0;
+			sfx_u8 registers_written = 0;
+			sfx_u16 duration_us = 0;
+			RF_API_GetConfigurationStatistics(&image_restored, &registers_written, &duration_us);
+			if (image_restored != 0) {
+				USARTx_SendString("Restore Registers=");
+				USARTx_SendValue(registers_written, USART_FORMAT_DECIMAL, 0);
+				USARTx_SendString(" ");
+			}
+			else {
+				USARTx_SendString("Full ");
+			}
+			USARTx_SendString("Duration=");
+			USARTx_SendValue(duration_us, USART_FORMAT_DECIMAL, 0);
+			USARTx_SendString("us\n");
+		}
+		// Radio power states residency command AT$RADIO?<CR>.
+		else if (AT_CompareCommand(AT_IN_COMMAND_RADIO) == AT_NO_ERROR) {
+			// Print time spent in each radio power state since start-up.
+			unsigned char state_idx = 0;
+			for (state_idx=0 ; state_idx<RADIO_STATE_LAST ; state_idx++) {
+				USARTx_SendString(at_radio_state_name[state_idx]);
+				USARTx_SendString("=");
+				USARTx_SendValue(RADIO_GetResidency(state_idx), USART_FORMAT_DECIMAL, 0);
+				USARTx_SendString((state_idx < (RADIO_STATE_LAST - 1)) ? "ms " : "ms\n");
+			}
+		}
+		// Duty cycle ledger command AT$AIR?<CR>.
+		else if (AT_CompareCommand(AT_IN_COMMAND_AIR) == AT_NO_ERROR) {
+			// Print airtime of the last hour, budget and airtime since start-up.
+			USARTx_SendString("Window=");
+			USARTx_SendValue(AIRTIME_GetWindowDuration(), USART_FORMAT_DECIMAL, 0);
+			USARTx_SendString("ms Budget=");
+			USARTx_SendValue(AIRTIME_WINDOW_BUDGET_MS, USART_FORMAT_DECIMAL, 0);
+			USARTx_SendString("ms Total=");
+			USARTx_SendValue(AIRTIME_GetTotalDuration(), USART_FORMAT_DECIMAL, 0);
+			USARTx_SendString("ms\n");
+		}
+		// Radio link statistics command AT$LINK?<CR>.
+		else if (AT_CompareCommand(AT_IN_COMMAND_LINK) == AT_NO_ERROR) {
+			// Print statistics of the current day and of the previous day.
+			LINK_Statistics link_statistics;
+			LINK_GetCurrentDay(&link_statistics);
+			USARTx_SendString("Today ");
+			AT_PrintLinkStatistics(&link_statistics);
+			if (LINK_GetPreviousDay(&link_statistics) != 0) {
+				USARTx_SendString("Yesterday ");
+				AT_PrintLinkStatistics(&link_statistics);
+			}
+		}
+		// AES benchmark command AT$AES?<CR>.
+		else if (AT_CompareCommand(AT_IN_COMMAND_AES) == AT_NO_ERROR) {
+			// Print duration of the last MCU_API_aes_128_cbc_encrypt call.
+			sfx_u32 calls_count = 0;
+			sfx_u8 number_of_blocks = 0;
+			sfx_u32 cycle_count = 0;
+			MCU_API_GetAesStatistics(&calls_count, &number_of_blocks, &cycle_count);
+			USARTx_SendString("Calls=");
+			USARTx_SendValue(calls_count, USART_FORMAT_DECIMAL, 0);
+			USARTx_SendString(" Blocks=");
+			USARTx_SendValue(number_of_blocks, USART_FORMAT_DECIMAL, 0);
+			USARTx_SendString(" Cycles=");
+			USARTx_SendValue(cycle_count, USART_FORMAT_DECIMAL, 0);
+			USARTx_SendString("\n");
+		}
+		// AES backends self-test command AT$AEST?<CR>.
+		else if (AT_CompareCommand(AT_IN_COMMAND_AEST) == AT_NO_ERROR) {
+			// Check test vector and measure throughput of each backend through the Sigfox MCU API.
+			unsigned char key[AES_BLOCK_SIZE];
+			unsigned char data_in[AT_AES_BENCHMARK_NUMBER_OF_BLOCKS_MAX * AES_BLOCK_SIZE];
+			unsigned char data_out[MCU_API_AES_BACKEND_LAST][AT_AES_BENCHMARK_NUMBER_OF_BLOCKS_MAX * AES_BLOCK_SIZE];
+			sfx_u32 calls_count = 0;
+			sfx_u8 number_of_blocks = 0;
+			sfx_u32 cycle_count = 0;
+			unsigned char backend_idx = 0;
+			unsigned char idx = 0;
+			for (idx=0 ; idx<AES_BLOCK_SIZE ; idx++) key[idx] = at_aes_test_key[idx];
+			for (backend_idx=0 ; backend_idx<MCU_API_AES_BACKEND_LAST ; backend_idx++) {
+				MCU_API_SetAesBackend(backend_idx);
+				// Test vector.
+				for (idx=0 ; idx<AES_BLOCK_SIZE ; idx++) data_in[idx] = at_aes_test_plaintext[idx];
+				MCU_API_aes_128_cbc_encrypt(data_out[backend_idx], data_in, AES_BLOCK_SIZE, key, CREDENTIALS_KEY_IN_ARGUMENT);
+				for (idx=0 ; idx<AES_BLOCK_SIZE ; idx++) {
+					if (data_out[backend_idx][idx] != at_aes_test_ciphertext[idx]) break;
+				}
+				USARTx_SendString(at_aes_backend_name[backend_idx]);
+				USARTx_SendString((idx < AES_BLOCK_SIZE) ? " Vector=KO " : " Vector=OK ");
+				// Throughput on the largest buffer.
+				for (idx=0 ; idx<(AT_AES_BENCHMARK_NUMBER_OF_BLOCKS_MAX * AES_BLOCK_SIZE) ; idx++) data_in[idx] = idx;
+				MCU_API_aes_128_cbc_encrypt(data_out[backend_idx], data_in, (AT_AES_BENCHMARK_NUMBER_OF_BLOCKS_MAX * AES_BLOCK_SIZE), key, CREDENTIALS_KEY_IN_ARGUMENT);
+				MCU_API_GetAesStatistics(&calls_count, &number_of_blocks, &cycle_count);
+				USARTx_SendValue(((RCC_GetSysclkKhz() * 1000 * number_of_blocks) / cycle_count), USART_FORMAT_DECIMAL, 0);
+				USARTx_SendString("blocks/s\n");
+			}
+			MCU_API_SetAesBackend(MCU_API_AES_BACKEND_HARDWARE);
+			// Check that backends are bit-identical.
+			for (idx=0 ; idx<(AT_AES_BENCHMARK_NUMBER_OF_BLOCKS_MAX * AES_BLOCK_SIZE) ; idx++) {
+				if (data_out[MCU_API_AES_BACKEND_HARDWARE][idx] != data_out[MCU_API_AES_BACKEND_SOFTWARE][idx]) break;
+			}
+			USARTx_SendString((idx < (AT_AES_BENCHMARK_NUMBER_OF_BLOCKS_MAX * AES_BLOCK_SIZE)) ? "Mismatch\n" : "Match\n");
+		}
+		// AES benchmark command AT$AESB=<number_of_blocks><CR>.
+		else if (AT_CompareHeader(AT_IN_HEADER_AESB) == AT_NO_ERROR) {
+			unsigned int number_of_blocks = 0;
+			get_param_result = AT_GetParameter(AT_PARAM_TYPE_DECIMAL, 1, &number_of_blocks);
+			if (get_param_result == AT_NO_ERROR) {
+				if ((number_of_blocks > 0) && (number_of_blocks <= AT_AES_BENCHMARK_NUMBER_OF_BLOCKS_MAX)) {
+					// Word buffers to guarantee 32-bits alignment for DMA.
+					unsigned int data_in[AT_AES_BENCHMARK_NUMBER_OF_BLOCKS_MAX * (AES_BLOCK_SIZE / 4)];
+					unsigned int data_out_cpu[AT_AES_BENCHMARK_NUMBER_OF_BLOCKS_MAX * (AES_BLOCK_SIZE / 4)];
+					unsigned int data_out_dma[AT_AES_BENCHMARK_NUMBER_OF_BLOCKS_MAX * (AES_BLOCK_SIZE / 4)];
+					unsigned char init_vector[AES_BLOCK_SIZE] = {0};
+					unsigned char key[AES_BLOCK_SIZE];
+					unsigned int cycle_count[AES_TRANSFER_LAST];
+					AES_Transfer transfer_done[AES_TRANSFER_LAST];
+					unsigned char idx = 0;
+					// Build test pattern.
+					for (idx=0 ; idx<(AT_AES_BENCHMARK_NUMBER_OF_BLOCKS_MAX * (AES_BLOCK_SIZE / 4)) ; idx++) data_in[idx] = (0x01010101 * idx);
+					for (idx=0 ; idx<AES_BLOCK_SIZE ; idx++) key[idx] = idx;
+					// Encrypt with CPU transfers then with DMA.
+					AES_Init();
+					SYSTICK_StartCycleCount();
+					transfer_done[AES_TRANSFER_CPU] = AES_EncodeCbcBuffer((unsigned char*) data_in, (unsigned char*) data_out_cpu, number_of_blocks, init_vector, key, AES_TRANSFER_CPU);
+					cycle_count[AES_TRANSFER_CPU] = SYSTICK_StopCycleCount();
+					SYSTICK_StartCycleCount();
+					transfer_done[AES_TRANSFER_DMA] = AES_EncodeCbcBuffer((unsigned char*) data_in, (unsigned char*) data_out_dma, number_of_blocks, init_vector, key, AES_TRANSFER_DMA);
+					cycle_count[AES_TRANSFER_DMA] = SYSTICK_StopCycleCount();
+					AES_Disable();
+					if ((transfer_done[AES_TRANSFER_CPU] == AES_TRANSFER_ERROR) || (transfer_done[AES_TRANSFER_DMA] == AES_TRANSFER_ERROR)) {
+						AT_ReplyError(AT_ERROR_SOURCE_AT, AT_OUT_ERROR_AES_TRANSFER);
+					}
+					else {
+						// Print durations and check that both methods give the same result.
+						USARTx_SendString("Cpu=");
+						USARTx_SendValue(cycle_count[AES_TRANSFER_CPU], USART_FORMAT_DECIMAL, 0);
+						USARTx_SendString(" Dma=");
+						USARTx_SendValue(cycle_count[AES_TRANSFER_DMA], USART_FORMAT_DECIMAL, 0);
+						USARTx_SendString(" cycles ");
+						for (idx=0 ; idx<(number_of_blocks * (AES_BLOCK_SIZE / 4)) ; idx++) {
+							if (data_out_cpu[idx] != data_out_dma[idx]) break;
+						}
+						USARTx_SendString((idx < (number_of_blocks * (AES_BLOCK_SIZE / 4))) ? "Mismatch\n" : "Match\n");
+					}
+				}
+				else {
+					AT_ReplyError(AT_ERROR_SOURCE_AT, AT_OUT_ERROR_AES_BLOCKS_OVERFLOW);
+				}
+			}
+			else {
+				// Error in parameter.
+				AT_ReplyError(AT_ERROR_SOURCE_AT, get_param_result);
+			}
+		}
+		// NVM read command AT$NVM=<field><CR>.
 		else if (AT_CompareHeader(AT_IN_HEADER_NVM) == AT_NO_ERROR) {
-			unsigned int address_offset = 0;
-			get_param_result = AT_GetParameter(AT_PARAM_TYPE_DECIMAL, 1, &address_offset);
+			unsigned int field = 0;
+			get_param_result = AT_GetParameter(AT_PARAM_TYPE_DECIMAL, 1, &field);
 			if (get_param_result == AT_NO_ERROR) {
-				// Check if address is reachable.
-				if (address_offset < EEPROM_SIZE) {
-					// Read byte at requested address.
-					unsigned char nvm_byte = 0;
-					NVM_Enable();
-					NVM_ReadByte(address_offset, &nvm_byte);
-					NVM_Disable();
-					// Print byte.
-					USARTx_SendValue(nvm_byte, USART_FORMAT_HEXADECIMAL, 1);
+				// Check if field exists.
+				if (field < NVM_FIELD_LAST) {
+					// Read field from loaded NVM data (records and journal).
+					unsigned short nvm_field = 0;
+					NVM_ReadField(field, &nvm_field);
+					// Print value.
+					USARTx_SendValue(nvm_field, USART_FORMAT_DECIMAL, 0);
 					USARTx_SendString("\n");
 				}
 				else {
-					AT_ReplyError(AT_ERROR_SOURCE_AT, AT_OUT_ERROR_NVM_ADDRESS_OVERFLOW);
+					AT_ReplyError(AT_ERROR_SOURCE_AT, AT_OUT_ERROR_NVM_FIELD_OVERFLOW);
 				}
 			}
 			else {
-				// Error in address parameter.
+				// Error in field parameter.
 				AT_ReplyError(AT_ERROR_SOURCE_AT, get_param_result);
 			}
 		}
 		// Get ID command AT$ID?<CR>.
 		else if (AT_CompareCommand(AT_IN_COMMAND_ID) == AT_NO_ERROR) {
-			// Enable NVM interface.
-			NVM_Enable();
-			// Retrieve device ID in NVM.
-			unsigned char id_byte = 0;
+			// Retrieve device ID.
+			unsigned char device_id[ID_LENGTH] = {0};
+			NVM_ReadSigfoxId(device_id);
 			for (byte_idx=0 ; byte_idx<ID_LENGTH ; byte_idx++) {
-				NVM_ReadByte((NVM_SIGFOX_ID_ADDRESS_OFFSET + ID_LENGTH - byte_idx - 1), &id_byte);
-				USARTx_SendValue(id_byte, USART_FORMAT_HEXADECIMAL, (byte_idx==0 ? 1 : 0));
+				USARTx_SendValue(device_id[ID_LENGTH - byte_idx - 1], USART_FORMAT_HEXADECIMAL, (byte_idx==0 ? 1 : 0));
 			}
 			USARTx_SendString("\n");
-			// Disable NVM interface.
-			NVM_Disable();
 		}
 		// Set ID command AT$ID=<id><CR>.
 		else if (AT_CompareHeader(AT_IN_HEADER_ID) == AT_NO_ERROR) {
@@ -1079,12 +1320,15 @@ static void AT_DecodeRxBuffer(void) {
 			if (get_param_result == AT_NO_ERROR) {
 				// Check length.
 				if (extracted_length == ID_LENGTH) {
+					// Device ID is stored in reverse order.
+					unsigned char device_id[ID_LENGTH] = {0};
+					for (byte_idx=0 ; byte_idx<ID_LENGTH ; byte_idx++) {
+						device_id[ID_LENGTH - byte_idx - 1] = param_id[byte_idx];
+					}
 					// Enable NVM interface.
 					NVM_Enable();
 					// Write device ID in NVM.
-					for (byte_idx=0 ; byte_idx<ID_LENGTH ; byte_idx++) {
-						NVM_WriteByte((NVM_SIGFOX_ID_ADDRESS_OFFSET + ID_LENGTH - byte_idx - 1), param_id[byte_idx]);
-					}
+					NVM_WriteSigfoxId(device_id);
 					AT_ReplyOk();
 					// Disable NVM interface.
 					NVM_Disable();
@@ -1100,18 +1344,14 @@ static void AT_DecodeRxBuffer(void) {
 		}
 		// Get key command AT$KEY?<CR>.
 		else if (AT_CompareCommand(AT_IN_COMMAND_KEY) == AT_NO_ERROR) {
-			// Enable NVM interface.
-			NVM_Enable();
-			// Retrieve device key in NVM.
-			unsigned char id_byte = 0;
+			// Retrieve device key.
+			unsigned char device_key[AES_BLOCK_SIZE] = {0};
 			unsigned char byte_idx = 0;
+			NVM_ReadSigfoxKey(device_key);
 			for (byte_idx=0 ; byte_idx<AES_BLOCK_SIZE ; byte_idx++) {
-				NVM_ReadByte((NVM_SIGFOX_KEY_ADDRESS_OFFSET + byte_idx), &id_byte);
-				USARTx_SendValue(id_byte, USART_FORMAT_HEXADECIMAL, (byte_idx==0 ? 1 : 0));
+				USARTx_SendValue(device_key[byte_idx], USART_FORMAT_HEXADECIMAL, (byte_idx==0 ? 1 : 0));
 			}
 			USARTx_SendString("\n");
-			// Disable NVM interface.
-			NVM_Disable();
 		}
 		// Set key command AT$KEY=<id><CR>.
 		else if (AT_CompareHeader(AT_IN_HEADER_KEY) == AT_NO_ERROR) {
@@ -1122,10 +1362,8 @@ static void AT_DecodeRxBuffer(void) {
 				if (extracted_length == AES_BLOCK_SIZE) {
 					// Enable NVM interface.
 					NVM_Enable();
-					// Write device ID in NVM.
-					for (byte_idx=0 ; byte_idx<AES_BLOCK_SIZE ; byte_idx++) {
-						NVM_WriteByte((NVM_SIGFOX_KEY_ADDRESS_OFFSET + byte_idx), param_key[byte_idx]);
-					}
+					// Write device key in NVM.
+					NVM_WriteSigfoxKey(param_key);
 					AT_ReplyOk();
 					// Disable NVM interface.
 					NVM_Disable();
@@ -1152,6 +1390,7 @@ static void AT_DecodeRxBuffer(void) {
 					sfx_error = SIGFOX_API_send_outofband(SFX_OOB_SERVICE);
 				}
 				SIGFOX_API_close();
+				LINK_RecordUplink(sfx_error, 0);
 				if (sfx_error == SFX_ERR_NONE) {
 					AT_ReplyOk();
 				}
@@ -1183,6 +1422,7 @@ static void AT_DecodeRxBuffer(void) {
 							sfx_error = SIGFOX_API_send_bit(data_bit, sfx_downlink_data, 2, downlink_request);
 						}
 						SIGFOX_API_close();
+						LINK_RecordUplink(sfx_error, downlink_request);
 						if (sfx_error == SFX_ERR_NONE) {
 							if (downlink_request == 1) {
 								AT_PrintDownlinkData(sfx_downlink_data);
@@ -1210,6 +1450,7 @@ static void AT_DecodeRxBuffer(void) {
 							sfx_error = SIGFOX_API_send_bit(data_bit, sfx_downlink_data, 2, 0);
 						}
 						SIGFOX_API_close();
+						LINK_RecordUplink(sfx_error, 0);
 						if (sfx_error == SFX_ERR_NONE) {
 							AT_ReplyOk();
 						}
@@ -1239,6 +1480,7 @@ static void AT_DecodeRxBuffer(void) {
 					sfx_error = SIGFOX_API_send_frame(sfx_uplink_data, 0, sfx_downlink_data, 2, 0);
 				}
 				SIGFOX_API_close();
+				LINK_RecordUplink(sfx_error, 0);
 				if (sfx_error == SFX_ERR_NONE) {
 					AT_ReplyOk();
 				}
@@ -1269,6 +1511,7 @@ static void AT_DecodeRxBuffer(void) {
 							sfx_error = SIGFOX_API_send_frame(sfx_uplink_data, extracted_length, sfx_downlink_data, 2, downlink_request);
 						}
 						SIGFOX_API_close();
+						LINK_RecordUplink(sfx_error, downlink_request);
 						if (sfx_error == SFX_ERR_NONE) {
 							if (downlink_request == 1) {
 								AT_PrintDownlinkData(sfx_downlink_data);
@@ -1296,6 +1539,7 @@ static void AT_DecodeRxBuffer(void) {
 							sfx_error = SIGFOX_API_send_frame(sfx_uplink_data, extracted_length, sfx_downlink_data, 2, 0);
 						}
 						SIGFOX_API_close();
+						LINK_RecordUplink(sfx_error, 0);
 						if (sfx_error == SFX_ERR_NONE) {
 							AT_ReplyOk();
 						}
@@ -1386,10 +1630,7 @@ static void AT_DecodeRxBuffer(void) {
 					RF_API_init(SFX_RF_MODE_RX);
 					RF_API_change_frequency(frequency_hz);
 					// Start continuous listening.
-					SX1232_SetMode(SX1232_MODE_FSRX);
-					LPTIM1_DelayMilliseconds(5, 0); // Wait TS_FS=60us typical.
-					SX1232_SetMode(SX1232_MODE_RX);
-					LPTIM1_DelayMilliseconds(5, 0); // Wait TS_TR=120us typical.
+					RADIO_SetState(RADIO_STATE_RX);
 					unsigned int rssi_print_count = 0;
 					unsigned char rssi = 0;
 					while (rssi_print_count < (AT_RSSI_REPORT_DURATION_MS / AT_RSSI_REPORT_PERIOD_MS)) {
@@ -1570,6 +1811,30 @@ static void AT_DecodeRxBuffer(void) {
 				AT_ReplyError(AT_ERROR_SOURCE_AT, get_param_result);
 			}
 		}
+		// Downlink sniffing command AT$DLS=<rx_slot_ms>,<sleep_slot_ms><CR>.
+		else if (AT_CompareHeader(AT_IN_HEADER_DLS) == AT_NO_ERROR) {
+			unsigned int rx_slot_ms = 0;
+			// Search RX slot parameter.
+			get_param_result = AT_GetParameter(AT_PARAM_TYPE_DECIMAL, 0, &rx_slot_ms);
+			if (get_param_result == AT_NO_ERROR) {
+				unsigned int sleep_slot_ms = 0;
+				// Search sleep slot parameter.
+				get_param_result = AT_GetParameter(AT_PARAM_TYPE_DECIMAL, 1, &sleep_slot_ms);
+				if (get_param_result == AT_NO_ERROR) {
+					// Update duty ratio (sleep slot 0 selects continuous RX).
+					RF_API_SetDownlinkSniffing((sfx_u16) rx_slot_ms, (sfx_u16) sleep_slot_ms);
+					AT_ReplyOk();
+				}
+				else {
+					// Error in sleep slot parameter.
+					AT_ReplyError(AT_ERROR_SOURCE_AT, get_param_result);
+				}
+			}
+			else {
+				// Error in RX slot parameter.
+				AT_ReplyError(AT_ERROR_SOURCE_AT, get_param_result);
+			}
+		}
 #endif
 		// Unknown command.
 		else {
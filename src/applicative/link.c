@@ -0,0 +1,178 @@
+/*
+ * link.c
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "link.h"
+
+#include "airtime.h"
+#include "nvm.h"
+#include "rf_api.h"
+#include "sigfox_api.h"
+#include "sigfox_types.h"
+
+/*** LINK local macros ***/
+
+#define LINK_ERROR_CODES_MAX	4 // Number of distinct error codes counted per day.
+#define LINK_COUNTER_MAX		0xFF
+#define LINK_DURATION_MAX		0xFFFF
+
+/*** LINK local structures ***/
+
+typedef struct {
+	// Uplinks.
+	unsigned short link_uplinks_attempted;
+	unsigned short link_uplinks_failed;
+	sfx_error_t link_error_code[LINK_ERROR_CODES_MAX];
+	unsigned short link_error_count[LINK_ERROR_CODES_MAX];
+	unsigned int link_tx_reference_ms; // Airtime counter at the beginning of the day.
+	// Downlinks.
+	unsigned short link_downlinks_requested;
+	unsigned short link_downlinks_received;
+	signed short link_rssi_min;
+	signed short link_rssi_max;
+	signed int link_rssi_sum;
+	unsigned short link_rssi_count;
+} LINK_Context;
+
+/*** LINK local global variables ***/
+
+static LINK_Context link_ctx;
+
+/*** LINK local functions ***/
+
+/* RESET DAILY COUNTERS.
+ * @param:	None.
+ * @return:	None.
+ */
+static void LINK_ResetCounters(void) {
+	unsigned char code_idx = 0;
+	link_ctx.link_uplinks_attempted = 0;
+	link_ctx.link_uplinks_failed = 0;
+	for (code_idx=0 ; code_idx<LINK_ERROR_CODES_MAX ; code_idx++) {
+		link_ctx.link_error_code[code_idx] = SFX_ERR_NONE;
+		link_ctx.link_error_count[code_idx] = 0;
+	}
+	link_ctx.link_tx_reference_ms = AIRTIME_GetTotalDuration();
+	link_ctx.link_downlinks_requested = 0;
+	link_ctx.link_downlinks_received = 0;
+	link_ctx.link_rssi_min = 0;
+	link_ctx.link_rssi_max = 0;
+	link_ctx.link_rssi_sum = 0;
+	link_ctx.link_rssi_count = 0;
+}
+
+/* SATURATE A COUNTER TO THE WIDTH OF ITS STATISTICS FIELD.
+ * @param value:		Counter value.
+ * @param max_value:	Maximum value of the field.
+ * @return:				Saturated value.
+ */
+static unsigned int LINK_Saturate(unsigned int value, unsigned int max_value) {
+	return (value > max_value) ? max_value : value;
+}
+
+/*** LINK functions ***/
+
+/* INIT RADIO LINK STATISTICS.
+ * @param:	None.
+ * @return:	None.
+ */
+void LINK_Init(void) {
+	LINK_ResetCounters();
+}
+
+/* RECORD THE OUTCOME OF AN UPLINK.
+ * @param sfx_error:			Error code returned by the Sigfox library.
+ * @param downlink_request:		1 if a downlink was requested, 0 otherwise.
+ * @return:						None.
+ */
+void LINK_RecordUplink(sfx_error_t sfx_error, unsigned char downlink_request) {
+	unsigned char code_idx = 0;
+	link_ctx.link_uplinks_attempted++;
+	if (downlink_request != 0) {
+		link_ctx.link_downlinks_requested++;
+	}
+	if (sfx_error != SFX_ERR_NONE) {
+		link_ctx.link_uplinks_failed++;
+		// Downlink frame was lost or rejected: come back to maximum output power.
+		if (downlink_request != 0) {
+			RF_API_UpdateOutputPower(0);
+		}
+		// Count error by code (codes beyond table size are only counted as failures).
+		for (code_idx=0 ; code_idx<LINK_ERROR_CODES_MAX ; code_idx++) {
+			if ((link_ctx.link_error_count[code_idx] == 0) || (link_ctx.link_error_code[code_idx] == sfx_error)) {
+				link_ctx.link_error_code[code_idx] = sfx_error;
+				link_ctx.link_error_count[code_idx]++;
+				break;
+			}
+		}
+	}
+	else if (downlink_request != 0) {
+		// Downlink frame was received and authenticated.
+		sfx_u8 rssi_retrieved = 0;
+		sfx_s16 rssi = 0;
+		link_ctx.link_downlinks_received++;
+		RF_API_UpdateOutputPower(1);
+		RF_API_GetDownlinkRssi(&rssi_retrieved, &rssi);
+		if (rssi_retrieved != 0) {
+			if ((link_ctx.link_rssi_count == 0) || (rssi < link_ctx.link_rssi_min)) {
+				link_ctx.link_rssi_min = rssi;
+			}
+			if ((link_ctx.link_rssi_count == 0) || (rssi > link_ctx.link_rssi_max)) {
+				link_ctx.link_rssi_max = rssi;
+			}
+			link_ctx.link_rssi_sum += rssi;
+			link_ctx.link_rssi_count++;
+		}
+	}
+}
+
+/* GET STATISTICS OF THE CURRENT DAY.
+ * @param link_statistics:	Pointer to structure that will contain the statistics.
+ * @return:					None.
+ */
+void LINK_GetCurrentDay(LINK_Statistics* link_statistics) {
+	unsigned char code_idx = 0;
+	unsigned char top_idx = 0;
+	// Uplinks.
+	(link_statistics -> field).uplinks_attempted = LINK_Saturate(link_ctx.link_uplinks_attempted, LINK_COUNTER_MAX);
+	(link_statistics -> field).uplinks_failed = LINK_Saturate(link_ctx.link_uplinks_failed, LINK_COUNTER_MAX);
+	for (code_idx=1 ; code_idx<LINK_ERROR_CODES_MAX ; code_idx++) {
+		if (link_ctx.link_error_count[code_idx] > link_ctx.link_error_count[top_idx]) {
+			top_idx = code_idx;
+		}
+	}
+	(link_statistics -> field).top_error_code = link_ctx.link_error_code[top_idx];
+	(link_statistics -> field).top_error_count = LINK_Saturate(link_ctx.link_error_count[top_idx], LINK_COUNTER_MAX);
+	(link_statistics -> field).tx_duration_seconds = LINK_Saturate(((AIRTIME_GetTotalDuration() - link_ctx.link_tx_reference_ms) / 1000), LINK_DURATION_MAX);
+	// Downlinks.
+	(link_statistics -> field).downlinks_requested = LINK_Saturate(link_ctx.link_downlinks_requested, LINK_COUNTER_MAX);
+	(link_statistics -> field).downlinks_received = LINK_Saturate(link_ctx.link_downlinks_received, LINK_COUNTER_MAX);
+	(link_statistics -> field).rssi_min_dbm = LINK_Saturate((-link_ctx.link_rssi_min), LINK_COUNTER_MAX);
+	(link_statistics -> field).rssi_max_dbm = LINK_Saturate((-link_ctx.link_rssi_max), LINK_COUNTER_MAX);
+	(link_statistics -> field).rssi_mean_dbm = 0;
+	if (link_ctx.link_rssi_count != 0) {
+		(link_statistics -> field).rssi_mean_dbm = LINK_Saturate(((-link_ctx.link_rssi_sum) / link_ctx.link_rssi_count), LINK_COUNTER_MAX);
+	}
+}
+
+/* GET STATISTICS OF THE PREVIOUS DAY (FROM NVM).
+ * @param link_statistics:	Pointer to structure that will contain the statistics.
+ * @return valid:			1 if a daily summary is available, 0 otherwise.
+ */
+unsigned char LINK_GetPreviousDay(LINK_Statistics* link_statistics) {
+	return NVM_RecordRead(NVM_RECORD_LINK, (link_statistics -> raw));
+}
+
+/* STORE STATISTICS OF THE CURRENT DAY IN NVM AND START A NEW DAY (NVM MUST BE ENABLED).
+ * @param:	None.
+ * @return:	None.
+ */
+void LINK_Summarize(void) {
+	LINK_Statistics link_statistics;
+	LINK_GetCurrentDay(&link_statistics);
+	NVM_RecordWrite(NVM_RECORD_LINK, link_statistics.raw);
+	LINK_ResetCounters();
+}
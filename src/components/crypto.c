@@ -0,0 +1,170 @@
+/*
+ * crypto.c
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "crypto.h"
+
+/*** CRYPTO local macros ***/
+
+#define CRYPTO_AES_NUMBER_OF_ROUNDS		10 // AES-128.
+#define CRYPTO_AES_ROUND_KEYS_SIZE		(CRYPTO_AES_BLOCK_SIZE * (CRYPTO_AES_NUMBER_OF_ROUNDS + 1))
+
+/*** CRYPTO local global variables ***/
+
+// Forward substitution box (FIPS-197 figure 7).
+static const unsigned char crypto_aes_sbox[256] = {
+	0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+	0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+	0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+	0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+	0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+	0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+	0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+	0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+	0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+	0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+	0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+	0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+	0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+	0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+	0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+	0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16
+};
+// Round constants of the key expansion.
+static const unsigned char crypto_aes_rcon[CRYPTO_AES_NUMBER_OF_ROUNDS] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36};
+
+/*** CRYPTO local functions ***/
+
+/* MULTIPLY A BYTE BY 2 IN GF(2^8).
+ * @param value:	Input byte.
+ * @return:			Result of the multiplication.
+ */
+static unsigned char CRYPTO_AesXtime(unsigned char value) {
+	return (unsigned char) ((value << 1) ^ (((value & 0x80) != 0) ? 0x1B : 0x00));
+}
+
+/* EXPAND AES-128 KEY INTO ROUND KEYS.
+ * @param key:			AES key (128-bits value).
+ * @param round_keys:	Byte array that will contain the 11 round keys.
+ * @return:				None.
+ */
+static void CRYPTO_AesExpandKey(unsigned char key[CRYPTO_AES_BLOCK_SIZE], unsigned char round_keys[CRYPTO_AES_ROUND_KEYS_SIZE]) {
+	unsigned char idx = 0;
+	// First round key is the cipher key.
+	for (idx=0 ; idx<CRYPTO_AES_BLOCK_SIZE ; idx++) {
+		round_keys[idx] = key[idx];
+	}
+	// Next words are computed from the previous word and the word of the previous round key.
+	for (idx=CRYPTO_AES_BLOCK_SIZE ; idx<CRYPTO_AES_ROUND_KEYS_SIZE ; idx+=4) {
+		unsigned char word[4];
+		word[0] = round_keys[idx - 4];
+		word[1] = round_keys[idx - 3];
+		word[2] = round_keys[idx - 2];
+		word[3] = round_keys[idx - 1];
+		if ((idx % CRYPTO_AES_BLOCK_SIZE) == 0) {
+			// RotWord, SubWord and round constant.
+			unsigned char first_byte = word[0];
+			word[0] = crypto_aes_sbox[word[1]] ^ crypto_aes_rcon[(idx / CRYPTO_AES_BLOCK_SIZE) - 1];
+			word[1] = crypto_aes_sbox[word[2]];
+			word[2] = crypto_aes_sbox[word[3]];
+			word[3] = crypto_aes_sbox[first_byte];
+		}
+		round_keys[idx + 0] = round_keys[idx - CRYPTO_AES_BLOCK_SIZE + 0] ^ word[0];
+		round_keys[idx + 1] = round_keys[idx - CRYPTO_AES_BLOCK_SIZE + 1] ^ word[1];
+		round_keys[idx + 2] = round_keys[idx - CRYPTO_AES_BLOCK_SIZE + 2] ^ word[2];
+		round_keys[idx + 3] = round_keys[idx - CRYPTO_AES_BLOCK_SIZE + 3] ^ word[3];
+	}
+}
+
+/* ENCRYPT ONE BLOCK IN PLACE.
+ * @param state:		Block to encrypt (column-major order as in FIPS-197).
+ * @param round_keys:	Expanded key.
+ * @return:				None.
+ */
+static void CRYPTO_AesEncodeBlock(unsigned char state[CRYPTO_AES_BLOCK_SIZE], unsigned char round_keys[CRYPTO_AES_ROUND_KEYS_SIZE]) {
+	// Local variables.
+	unsigned char round_idx = 0;
+	unsigned char idx = 0;
+	unsigned char temp = 0;
+	// Initial round key addition.
+	for (idx=0 ; idx<CRYPTO_AES_BLOCK_SIZE ; idx++) {
+		state[idx] ^= round_keys[idx];
+	}
+	for (round_idx=1 ; round_idx<=CRYPTO_AES_NUMBER_OF_ROUNDS ; round_idx++) {
+		// SubBytes.
+		for (idx=0 ; idx<CRYPTO_AES_BLOCK_SIZE ; idx++) {
+			state[idx] = crypto_aes_sbox[state[idx]];
+		}
+		// ShiftRows (row r is rotated left by r bytes).
+		temp = state[1];
+		state[1] = state[5];
+		state[5] = state[9];
+		state[9] = state[13];
+		state[13] = temp;
+		temp = state[2];
+		state[2] = state[10];
+		state[10] = temp;
+		temp = state[6];
+		state[6] = state[14];
+		state[14] = temp;
+		temp = state[15];
+		state[15] = state[11];
+		state[11] = state[7];
+		state[7] = state[3];
+		state[3] = temp;
+		// MixColumns (skipped in the last round).
+		if (round_idx < CRYPTO_AES_NUMBER_OF_ROUNDS) {
+			for (idx=0 ; idx<CRYPTO_AES_BLOCK_SIZE ; idx+=4) {
+				unsigned char a0 = state[idx + 0];
+				unsigned char a1 = state[idx + 1];
+				unsigned char a2 = state[idx + 2];
+				unsigned char a3 = state[idx + 3];
+				unsigned char all = a0 ^ a1 ^ a2 ^ a3;
+				state[idx + 0] ^= all ^ CRYPTO_AesXtime(a0 ^ a1);
+				state[idx + 1] ^= all ^ CRYPTO_AesXtime(a1 ^ a2);
+				state[idx + 2] ^= all ^ CRYPTO_AesXtime(a2 ^ a3);
+				state[idx + 3] ^= all ^ CRYPTO_AesXtime(a3 ^ a0);
+			}
+		}
+		// AddRoundKey.
+		for (idx=0 ; idx<CRYPTO_AES_BLOCK_SIZE ; idx++) {
+			state[idx] ^= round_keys[(round_idx * CRYPTO_AES_BLOCK_SIZE) + idx];
+		}
+	}
+}
+
+/*** CRYPTO functions ***/
+
+/* COMPUTE AES-128 CBC ALGORITHME IN SOFTWARE (SAME RESULT AS AES PERIPHERAL).
+ * @param data_in:				Input data.
+ * @param data_out:				Output data (can be the same buffer as input data).
+ * @param number_of_blocks:		Number of blocks to encrypt.
+ * @param init_vector:			Initialisation vector (128-bits value).
+ * @param key:					AES key (128-bits value).
+ * @return:						None.
+ */
+void CRYPTO_AesEncodeCbc(unsigned char* data_in, unsigned char* data_out, unsigned char number_of_blocks, unsigned char init_vector[CRYPTO_AES_BLOCK_SIZE], unsigned char key[CRYPTO_AES_BLOCK_SIZE]) {
+	// Local variables.
+	unsigned char round_keys[CRYPTO_AES_ROUND_KEYS_SIZE];
+	unsigned char state[CRYPTO_AES_BLOCK_SIZE];
+	unsigned char block_idx = 0;
+	unsigned char idx = 0;
+	// Key is expanded once for the whole buffer.
+	CRYPTO_AesExpandKey(key, round_keys);
+	for (idx=0 ; idx<CRYPTO_AES_BLOCK_SIZE ; idx++) {
+		state[idx] = init_vector[idx];
+	}
+	for (block_idx=0 ; block_idx<number_of_blocks ; block_idx++) {
+		// Chain with previous cipher block (or IV).
+		for (idx=0 ; idx<CRYPTO_AES_BLOCK_SIZE ; idx++) {
+			state[idx] ^= data_in[(block_idx * CRYPTO_AES_BLOCK_SIZE) + idx];
+		}
+		CRYPTO_AesEncodeBlock(state, round_keys);
+		for (idx=0 ; idx<CRYPTO_AES_BLOCK_SIZE ; idx++) {
+			data_out[(block_idx * CRYPTO_AES_BLOCK_SIZE) + idx] = state[idx];
+		}
+	}
+}
@@ -0,0 +1,236 @@
+/*
+ * radio.c
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "radio.h"
+
+#include "lptim.h"
+#include "rtc.h"
+#include "sky13317.h"
+#include "spi.h"
+#include "sx1232.h"
+
+/*** RADIO local macros ***/
+
+#define RADIO_MODE_READY_TIMEOUT_COUNT	1000
+#define RADIO_SX1232_IRQ_MODE_READY		(0b1 << 15) // ModeReady (IRQFLAGS1 bit 7).
+#define RADIO_DAY_DURATION_MS			86400000
+#define RADIO_STATE_IS_SUPPLIED(state)	(((state) == RADIO_STATE_SUPPLY) || ((state) >= RADIO_STATE_SLEEP))
+#define RADIO_STATE_IS_TCXO_ON(state)	((state) >= RADIO_STATE_TCXO_WARM)
+
+/*** RADIO local structures ***/
+
+typedef struct {
+	RADIO_State radio_state;
+	unsigned int radio_state_entry_time_ms;
+	unsigned int radio_tcxo_on_time_ms;
+	unsigned int radio_residency_ms[RADIO_STATE_LAST];
+} RADIO_Context;
+
+/*** RADIO local global variables ***/
+
+static RADIO_Context radio_ctx;
+// Transceiver mode of each state where it is powered (unused below RADIO_STATE_SLEEP).
+static const SX1232_Mode radio_sx1232_mode[RADIO_STATE_LAST] = {SX1232_MODE_SLEEP, SX1232_MODE_SLEEP, SX1232_MODE_SLEEP, SX1232_MODE_SLEEP, SX1232_MODE_STANDBY, SX1232_MODE_FSTX, SX1232_MODE_FSRX, SX1232_MODE_TX, SX1232_MODE_RX};
+
+/*** RADIO local functions ***/
+
+/* COMPUTE TIME ELAPSED SINCE A GIVEN RTC TIME OF DAY.
+ * @param start_time_ms:	Start time in milliseconds since midnight.
+ * @return:					Elapsed time in milliseconds.
+ */
+static unsigned int RADIO_GetElapsedMilliseconds(unsigned int start_time_ms) {
+	unsigned int current_time_ms = RTC_GetTimeOfDayMilliseconds();
+	// Manage midnight roll-over.
+	if (current_time_ms < start_time_ms) {
+		current_time_ms += RADIO_DAY_DURATION_MS;
+	}
+	return (current_time_ms - start_time_ms);
+}
+
+/* PROGRAM TRANSCEIVER MODE AND WAIT UNTIL IT IS READY.
+ * @param state:	Radio state to enter (transceiver must be powered).
+ * @return:			1 in case of success, 0 if the mode ready flag was not set before timeout.
+ */
+static unsigned char RADIO_SetTransceiverMode(RADIO_State state) {
+	SX1232_SetMode(radio_sx1232_mode[state]);
+	// Poll mode ready flag instead of waiting worst case start-up time (TS_OSC, TS_FS, TS_TR or TS_RE).
+	if (state != RADIO_STATE_SLEEP) {
+		unsigned int loop_count = 0;
+		while ((SX1232_GetIrqFlags() & RADIO_SX1232_IRQ_MODE_READY) == 0) {
+			loop_count++;
+			if (loop_count > RADIO_MODE_READY_TIMEOUT_COUNT) return 0;
+		}
+	}
+	return 1;
+}
+
+/* SELECT RF SWITCH CHANNEL OF A RADIO STATE.
+ * @param state:	Radio state.
+ * @return:			None.
+ */
+static void RADIO_SetRfPath(RADIO_State state) {
+	switch (state) {
+	case RADIO_STATE_TX:
+		// Select TX path.
+#ifdef HW1_0
+		SKY13317_SetChannel(SKY13317_CHANNEL_RF1);
+#endif
+#ifdef HW2_0
+		SKY13317_SetChannel(SKY13317_CHANNEL_RF2);
+#endif
+		break;
+	case RADIO_STATE_RX:
+		// Activate LNA path.
+#ifdef HW1_0
+		SKY13317_SetChannel(SKY13317_CHANNEL_RF2);
+#endif
+#ifdef HW2_0
+		SKY13317_SetChannel(SKY13317_CHANNEL_RF3);
+#endif
+		break;
+	default:
+		// Disable every channel.
+		SKY13317_SetChannel(SKY13317_CHANNEL_NONE);
+		break;
+	}
+}
+
+/*** RADIO functions ***/
+
+/* INIT RADIO POWER MANAGER.
+ * @param:	None.
+ * @return:	None.
+ */
+void RADIO_Init(void) {
+	// Init components.
+	SX1232_Init();
+	SX1232_Tcxo(0);
+	SKY13317_Init();
+	// Init context.
+	unsigned char state_idx = 0;
+	for (state_idx=0 ; state_idx<RADIO_STATE_LAST ; state_idx++) {
+		radio_ctx.radio_residency_ms[state_idx] = 0;
+	}
+	radio_ctx.radio_state = RADIO_STATE_OFF;
+	radio_ctx.radio_state_entry_time_ms = RTC_GetTimeOfDayMilliseconds();
+	radio_ctx.radio_tcxo_on_time_ms = radio_ctx.radio_state_entry_time_ms;
+}
+
+/* SWITCH RADIO OFF AND DISABLE ALL GPIOs.
+ * @param:	None.
+ * @return:	None.
+ */
+void RADIO_DisableGpio(void) {
+	RADIO_SetState(RADIO_STATE_OFF);
+	SX1232_DisableGpio();
+	SKY13317_DisableGpio();
+}
+
+/* SWITCH RADIO TO A GIVEN POWER STATE.
+ * @param state:	State to enter (see RADIO_State enumeration in radio.h).
+ * @return:			1 in case of success, 0 if the transceiver did not reach the requested mode.
+ */
+unsigned char RADIO_SetState(RADIO_State state) {
+	// Check parameter.
+	if (state >= RADIO_STATE_LAST) return 0;
+	if (state == radio_ctx.radio_state) return 1;
+	unsigned char status = 1;
+	RADIO_State previous_state = radio_ctx.radio_state;
+	// Update residency (transition time is counted in the new state).
+	unsigned int elapsed_ms = RADIO_GetElapsedMilliseconds(radio_ctx.radio_state_entry_time_ms);
+	radio_ctx.radio_residency_ms[previous_state] += elapsed_ms;
+	radio_ctx.radio_state_entry_time_ms += elapsed_ms;
+	if (radio_ctx.radio_state_entry_time_ms >= RADIO_DAY_DURATION_MS) {
+		radio_ctx.radio_state_entry_time_ms -= RADIO_DAY_DURATION_MS;
+	}
+	if (state >= RADIO_STATE_SLEEP) {
+		if (previous_state < RADIO_STATE_SLEEP) {
+			// Switch TCXO and transceiver on together: TCXO warm-up overlaps supply settling time.
+			if (RADIO_STATE_IS_TCXO_ON(previous_state) == 0) {
+				SX1232_Tcxo(1);
+				radio_ctx.radio_tcxo_on_time_ms = RTC_GetTimeOfDayMilliseconds();
+			}
+			if (RADIO_STATE_IS_SUPPLIED(previous_state) == 0) {
+				SPI1_PowerOn();
+			}
+			elapsed_ms = RADIO_GetElapsedMilliseconds(radio_ctx.radio_tcxo_on_time_ms);
+			if (elapsed_ms < SX1232_TCXO_WARM_UP_MS) {
+				LPTIM1_DelayMilliseconds((SX1232_TCXO_WARM_UP_MS - elapsed_ms), 1);
+			}
+			// Transceiver has just been powered on its default crystal input: select TCXO before any mode change, otherwise mode ready flag is never set.
+			SX1232_SetOscillator(SX1232_OSCILLATOR_TCXO);
+		}
+		if ((state == RADIO_STATE_TX) || (state == RADIO_STATE_RX)) {
+			// Never switch RF path while PA or LNA is running.
+			if ((previous_state == RADIO_STATE_TX) || (previous_state == RADIO_STATE_RX)) {
+				status &= RADIO_SetTransceiverMode(RADIO_STATE_STANDBY);
+			}
+			// Select RF path before starting PA or LNA.
+			RADIO_SetRfPath(state);
+			status &= RADIO_SetTransceiverMode(state);
+		}
+		else {
+			// Stop PA or LNA before releasing RF path.
+			status &= RADIO_SetTransceiverMode(state);
+			RADIO_SetRfPath(state);
+		}
+	}
+	else {
+		if (previous_state >= RADIO_STATE_SLEEP) {
+			// Stop PA or LNA and release RF path.
+			SX1232_SetMode(SX1232_MODE_STANDBY);
+			RADIO_SetRfPath(state);
+		}
+		// Switch transceiver off.
+		if ((RADIO_STATE_IS_SUPPLIED(state) == 0) && (RADIO_STATE_IS_SUPPLIED(previous_state) != 0)) {
+			SPI1_PowerOff();
+		}
+		// Supply state only powers the SPI bus: TCXO is not needed.
+		if (RADIO_STATE_IS_TCXO_ON(state) == 0) {
+			SX1232_Tcxo(0);
+		}
+		else if (RADIO_STATE_IS_TCXO_ON(previous_state) == 0) {
+			SX1232_Tcxo(1);
+			radio_ctx.radio_tcxo_on_time_ms = RTC_GetTimeOfDayMilliseconds();
+		}
+	}
+	radio_ctx.radio_state = state;
+	return status;
+}
+
+/* RE-ANCHOR RADIO TIMINGS AFTER AN RTC TIME UPDATE.
+ * @param:	None.
+ * @return:	None.
+ */
+void RADIO_Synchronize(void) {
+	// Restart current state and TCXO timings from the new time of day, so that the time jump is neither counted in residency nor in TCXO warm-up.
+	radio_ctx.radio_state_entry_time_ms = RTC_GetTimeOfDayMilliseconds();
+	radio_ctx.radio_tcxo_on_time_ms = radio_ctx.radio_state_entry_time_ms;
+}
+
+/* GET CURRENT RADIO POWER STATE.
+ * @param:	None.
+ * @return:	Current state (see RADIO_State enumeration in radio.h).
+ */
+RADIO_State RADIO_GetState(void) {
+	return radio_ctx.radio_state;
+}
+
+/* GET TIME SPENT IN A RADIO POWER STATE SINCE INIT.
+ * @param state:	Radio state.
+ * @return:			Residency time in milliseconds.
+ */
+unsigned int RADIO_GetResidency(RADIO_State state) {
+	// Check parameter.
+	if (state >= RADIO_STATE_LAST) return 0;
+	unsigned int residency_ms = radio_ctx.radio_residency_ms[state];
+	// Add time spent in current state.
+	if (state == radio_ctx.radio_state) {
+		residency_ms += RADIO_GetElapsedMilliseconds(radio_ctx.radio_state_entry_time_ms);
+	}
+	return residency_ms;
+}
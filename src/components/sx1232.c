@@ -7,9 +7,11 @@
 
 #include "sx1232.h"
 
+#include "exti.h"
 #include "gpio.h"
 #include "lptim.h"
 #include "mapping.h"
+#include "nvic.h"
 #include "spi.h"
 #include "sx1232_reg.h"
 #include "tim.h"
@@ -26,17 +28,38 @@
 // SX1232 DIOs.
 #define SX1232_DIO_NUMBER						6
 #define SX1232_DIO_MAPPING_MAX_VALUE			4
+// SX1232 configuration image (longest span of consecutive configuration registers).
+#define SX1232_CONFIGURATION_SPAN_LENGTH_MAX	22
 
 /*** SX1232 local structures ***/
 
 typedef struct {
 	SX1232_RfOutputPin sx1232_rf_output_pin;
 	signed char sx1232_rssi_offset;
+	volatile unsigned char sx1232_dio0_flag;
+	volatile unsigned char sx1232_dio2_flag;
 } SX1232_Context;
 
+// Block of consecutive configuration registers.
+typedef struct {
+	unsigned char first_addr;
+	unsigned char length;
+} SX1232_RegisterSpan;
+
 /*** SX1232 local global variables ***/
 
 static SX1232_Context sx1232_ctx;
+// Registers saved in a configuration image (RF frequency, oscillator, read-only values and IRQ flags are excluded).
+static const SX1232_RegisterSpan sx1232_configuration_spans[] = {
+	{SX1232_REG_OPMODE, 5}, // OPMODE to FDEVLSB.
+	{SX1232_REG_PACONFIG, 8}, // PACONFIG to RSSITHRESH.
+	{SX1232_REG_RXBW, 5}, // RXBW to OOKAVG.
+	{SX1232_REG_PREAMBLEDETECT, 5}, // PREAMBLEDETECT to RXDELAY.
+	{SX1232_REG_PREAMBLEMSB, 22}, // PREAMBLEMSB to TIMER2COEF.
+	{SX1232_REG_DIOMAPPING1, 2}, // DIOMAPPING1 and DIOMAPPING2.
+	{SX1232_REG_PLLHOP, 1},
+	{SX1232_REG_BITRATEFRAC, 1}
+};
 
 /*** SX1232 local functions ***/
 
@@ -59,6 +82,23 @@ static void SX1232_WriteRegister(unsigned char addr, unsigned char value) {
 	}
 }
 
+/* SX1232 BURST ACCESS WRITE FUNCTION.
+ * @param addr:		Address of the first register (7 bits).
+ * @param values:	Values to write in consecutive registers.
+ * @param length:	Number of registers to write.
+ * @return:			None.
+ */
+static void SX1232_WriteRegisters(unsigned char addr, unsigned char* values, unsigned char length) {
+	// Check addr is a 7-bits value.
+	if (addr < (0b1 << 7)) {
+		// Write access sequence (address is automatically incremented by the transceiver, except for FIFO).
+		GPIO_Write(&GPIO_SX1232_CS, 0); // Falling edge on CS pin.
+		SPI1_WriteByte((0b1 << 7) | addr); // '1 A6 A5 A4 A3 A2 A1 A0' for a write access.
+		SPI1_TransferBytes(values, 0, length);
+		GPIO_Write(&GPIO_SX1232_CS, 1); // Set CS pin.
+	}
+}
+
 /* SX1232 SINGLE ACCESS READ FUNCTION.
  * @param addr:		Register address (7 bits).
  * @param value:	Pointer to byte that will contain the register Value to read.
@@ -78,6 +118,23 @@ static void SX1232_ReadRegister(unsigned char addr, unsigned char* value) {
 	}
 }
 
+/* SX1232 BURST ACCESS READ FUNCTION.
+ * @param addr:		Address of the first register (7 bits).
+ * @param values:	Byte array that will contain the values of consecutive registers.
+ * @param length:	Number of registers to read.
+ * @return:			None.
+ */
+static void SX1232_ReadRegisters(unsigned char addr, unsigned char* values, unsigned char length) {
+	// Check addr is a 7-bits value.
+	if (addr < (0b1 << 7)) {
+		// Read access sequence (address is automatically incremented by the transceiver, except for FIFO).
+		GPIO_Write(&GPIO_SX1232_CS, 0); // Falling edge on CS pin.
+		SPI1_WriteByte(addr); // '0 A6 A5 A4 A3 A2 A1 A0' for a read access.
+		SPI1_TransferBytes(0, values, length);
+		GPIO_Write(&GPIO_SX1232_CS, 1); // Set CS pin.
+	}
+}
+
 /*** SX1232 functions ***/
 
 /* INIT SX1232 TRANSCEIVER.
@@ -88,6 +145,8 @@ void SX1232_Init(void) {
 	// Init context.
 	sx1232_ctx.sx1232_rf_output_pin = SX1232_RF_OUTPUT_PIN_RFO;
 	sx1232_ctx.sx1232_rssi_offset = 0;
+	sx1232_ctx.sx1232_dio0_flag = 0;
+	sx1232_ctx.sx1232_dio2_flag = 0;
 	// Init SX1232 DIOx.
 	GPIO_Configure(&GPIO_SX1232_DIO2, GPIO_MODE_OUTPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
 	GPIO_Configure(&GPIO_SX1232_DIO0, GPIO_MODE_INPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
@@ -105,19 +164,98 @@ void SX1232_DisableGpio(void) {
 }
 
 /* SWITCH SX1232 EXTERNAL TCXO ON OR OFF.
- * @param tcxo_enable:	Power down 32MHz TCXO if 0, power on otherwise.
+ * @param tcxo_enable:	Power down 32MHz TCXO if 0, power on otherwise (caller must then wait SX1232_TCXO_WARM_UP_MS).
  * @return:				None.
  */
 void SX1232_Tcxo(unsigned char tcxo_enable) {
 	// Update power control.
-	if (tcxo_enable == 0) {
-		GPIO_Write(&GPIO_TCXO32_POWER_ENABLE, 0);
+	GPIO_Write(&GPIO_TCXO32_POWER_ENABLE, ((tcxo_enable == 0) ? 0 : 1));
+}
+
+/* READ A BLOCK OF CONSECUTIVE SX1232 REGISTERS (SINGLE SPI BURST).
+ * @param first_addr:	Address of the first register.
+ * @param image:		Byte array that will contain the registers value.
+ * @param length:		Number of registers to read.
+ * @return:				None.
+ */
+void SX1232_ReadRegisterImage(unsigned char first_addr, unsigned char* image, unsigned char length) {
+#ifdef HW1_0
+	// Configure SPI.
+	SPI1_SetClockPolarity(0);
+#endif
+	SX1232_ReadRegisters(first_addr, image, length);
+}
+
+/* WRITE A BLOCK OF CONSECUTIVE SX1232 REGISTERS (SINGLE SPI BURST).
+ * @param first_addr:	Address of the first register.
+ * @param image:		Registers value to write.
+ * @param length:		Number of registers to write.
+ * @return:				None.
+ */
+void SX1232_WriteRegisterImage(unsigned char first_addr, unsigned char* image, unsigned char length) {
+#ifdef HW1_0
+	// Configure SPI.
+	SPI1_SetClockPolarity(0);
+#endif
+	SX1232_WriteRegisters(first_addr, image, length);
+}
+
+/* SAVE CURRENT SX1232 CONFIGURATION REGISTERS.
+ * @param image:	Byte array that will contain the configuration registers value.
+ * @return:			None.
+ */
+void SX1232_SaveConfiguration(unsigned char image[SX1232_CONFIGURATION_IMAGE_SIZE]) {
+#ifdef HW1_0
+	// Configure SPI.
+	SPI1_SetClockPolarity(0);
+#endif
+	// Read each span in a single burst.
+	unsigned char span_idx = 0;
+	unsigned char image_idx = 0;
+	for (span_idx=0 ; span_idx<(sizeof(sx1232_configuration_spans) / sizeof(SX1232_RegisterSpan)) ; span_idx++) {
+		SX1232_ReadRegisters(sx1232_configuration_spans[span_idx].first_addr, &(image[image_idx]), sx1232_configuration_spans[span_idx].length);
+		image_idx += sx1232_configuration_spans[span_idx].length;
 	}
-	else {
-		GPIO_Write(&GPIO_TCXO32_POWER_ENABLE, 1);
-		// Wait for TCXO to warm-up.
-		LPTIM1_DelayMilliseconds(100, 1);
+}
+
+/* RESTORE SX1232 CONFIGURATION REGISTERS.
+ * @param image:	Configuration registers value previously saved with SX1232_SaveConfiguration.
+ * @return written:	Number of registers which had to be written.
+ */
+unsigned char SX1232_RestoreConfiguration(unsigned char image[SX1232_CONFIGURATION_IMAGE_SIZE]) {
+#ifdef HW1_0
+	// Configure SPI.
+	SPI1_SetClockPolarity(0);
+#endif
+	unsigned char current_values[SX1232_CONFIGURATION_SPAN_LENGTH_MAX];
+	unsigned char span_idx = 0;
+	unsigned char image_idx = 0;
+	unsigned char reg_idx = 0;
+	unsigned char run_length = 0;
+	unsigned char written = 0;
+	for (span_idx=0 ; span_idx<(sizeof(sx1232_configuration_spans) / sizeof(SX1232_RegisterSpan)) ; span_idx++) {
+		// Read current values.
+		SX1232_ReadRegisters(sx1232_configuration_spans[span_idx].first_addr, current_values, sx1232_configuration_spans[span_idx].length);
+		// Write consecutive registers which differ from the image in a single burst.
+		reg_idx = 0;
+		while (reg_idx < sx1232_configuration_spans[span_idx].length) {
+			run_length = 0;
+			while (((reg_idx + run_length) < sx1232_configuration_spans[span_idx].length) && (current_values[reg_idx + run_length] != image[image_idx + reg_idx + run_length])) {
+				run_length++;
+			}
+			if (run_length == 0) {
+				// Register already holds the right value.
+				reg_idx++;
+			}
+			else {
+				SX1232_WriteRegisters((sx1232_configuration_spans[span_idx].first_addr + reg_idx), &(image[image_idx + reg_idx]), run_length);
+				written += run_length;
+				reg_idx += run_length;
+			}
+		}
+		image_idx += sx1232_configuration_spans[span_idx].length;
 	}
+	return written;
 }
 
 /* SELECT SX1232 OSCILLATOR CONFIGURATION.
@@ -250,17 +388,36 @@ void SX1232_SetModulation(SX1232_Modulation modulation, SX1232_ModulationShaping
  * @return:				None.
  */
 void SX1232_SetRfFrequency(unsigned int rf_frequency_hz) {
+	unsigned char frf[SX1232_FRF_SIZE_BYTES];
+	SX1232_ComputeFrf(rf_frequency_hz, frf);
+	SX1232_WriteFrf(frf);
+}
+
+/* COMPUTE SX1232 RF FREQUENCY REGISTERS VALUE.
+ * @param frequency_hz:	Transceiver frequency in Hz.
+ * @param frf:			Byte array that will contain the FRF registers value (MSB first).
+ * @return:				None.
+ */
+void SX1232_ComputeFrf(unsigned int rf_frequency_hz, unsigned char frf[SX1232_FRF_SIZE_BYTES]) {
+	unsigned long long frf_reg_value = (0b1 << 19);
+	frf_reg_value *= rf_frequency_hz;
+	frf_reg_value /= SX1232_FXOSC_HZ;
+	frf[0] = ((frf_reg_value & 0x00FF0000) >> 16);
+	frf[1] = ((frf_reg_value & 0x0000FF00) >> 8);
+	frf[2] = (frf_reg_value & 0x000000FF);
+}
+
+/* PROGRAM PRECOMPUTED SX1232 RF FREQUENCY REGISTERS (SINGLE SPI BURST).
+ * @param frf:	FRF registers value (MSB first) computed with SX1232_ComputeFrf function.
+ * @return:		None.
+ */
+void SX1232_WriteFrf(unsigned char frf[SX1232_FRF_SIZE_BYTES]) {
 #ifdef HW1_0
 	// Configure SPI.
 	SPI1_SetClockPolarity(0);
 #endif
-	// Program RF frequency.
-	unsigned long long frf_reg_value = (0b1 << 19);
-	frf_reg_value *= rf_frequency_hz;
-	frf_reg_value /= SX1232_FXOSC_HZ;
-	SX1232_WriteRegister(SX1232_REG_FRFMSB, ((frf_reg_value & 0x00FF0000) >> 16));
-	SX1232_WriteRegister(SX1232_REG_FRFMID, ((frf_reg_value & 0x0000FF00) >> 8));
-	SX1232_WriteRegister(SX1232_REG_FRFLSB, (frf_reg_value & 0x000000FF));
+	// Frequency change is triggered by the LSB write.
+	SX1232_WriteRegisters(SX1232_REG_FRFMSB, frf, SX1232_FRF_SIZE_BYTES);
 }
 
 /* GET EFFECTIVE RF FREQUENCY.
@@ -268,14 +425,16 @@ void SX1232_SetRfFrequency(unsigned int rf_frequency_hz) {
  * @return rf_frequency_hz:	Effective programmed RF frequency in Hz.
  */
 unsigned int SX1232_GetRfFrequency(void) {
-	unsigned char byte_value = 0;
+#ifdef HW1_0
+	// Configure SPI.
+	SPI1_SetClockPolarity(0);
+#endif
+	unsigned char frf[SX1232_FRF_SIZE_BYTES];
 	unsigned int frf_reg_value = 0;
-	SX1232_ReadRegister(SX1232_REG_FRFMSB, &byte_value);
-	frf_reg_value |= (byte_value << 16);
-	SX1232_ReadRegister(SX1232_REG_FRFMID, &byte_value);
-	frf_reg_value |= (byte_value << 8);
-	SX1232_ReadRegister(SX1232_REG_FRFLSB, &byte_value);
-	frf_reg_value |= (byte_value << 0);
+	SX1232_ReadRegisters(SX1232_REG_FRFMSB, frf, SX1232_FRF_SIZE_BYTES);
+	frf_reg_value |= (frf[0] << 16);
+	frf_reg_value |= (frf[1] << 8);
+	frf_reg_value |= (frf[2] << 0);
 	unsigned long long rf_frequency_hz = ((unsigned long long) SX1232_FXOSC_HZ) * ((unsigned long long) frf_reg_value);
 	rf_frequency_hz /= (0b1 << 19);
 	return ((unsigned int) rf_frequency_hz);
@@ -296,8 +455,10 @@ void SX1232_SetFskDeviation(unsigned short fsk_deviation_hz) {
 		unsigned long long fdev_reg_value = (0b1 << 19);
 		fdev_reg_value *= fsk_deviation_hz;
 		fdev_reg_value /= SX1232_FXOSC_HZ;
-		SX1232_WriteRegister(SX1232_REG_FDEVMSB, ((fdev_reg_value & 0x00003F00) >> 8));
-		SX1232_WriteRegister(SX1232_REG_FDEVLSB, ((fdev_reg_value & 0x000000FF) >> 0));
+		unsigned char fdev[2];
+		fdev[0] = ((fdev_reg_value & 0x00003F00) >> 8);
+		fdev[1] = ((fdev_reg_value & 0x000000FF) >> 0);
+		SX1232_WriteRegisters(SX1232_REG_FDEVMSB, fdev, 2);
 	}
 }
 
@@ -322,8 +483,10 @@ void SX1232_SetBitRate(unsigned int bit_rate_bps) {
 	SX1232_WriteRegister(SX1232_REG_BITRATEFRAC, 0x00);
 	// Compute register value: BR = FXOSC / bit_rate.
 	unsigned int bit_rate_reg_value = SX1232_FXOSC_HZ / local_bit_rate_bps;
-	SX1232_WriteRegister(SX1232_REG_BITRATEMSB, ((bit_rate_reg_value & 0x0000FF00) >> 8));
-	SX1232_WriteRegister(SX1232_REG_BITRATELSB, ((bit_rate_reg_value & 0x000000FF) >> 0));
+	unsigned char bit_rate[2];
+	bit_rate[0] = ((bit_rate_reg_value & 0x0000FF00) >> 8);
+	bit_rate[1] = ((bit_rate_reg_value & 0x000000FF) >> 0);
+	SX1232_WriteRegisters(SX1232_REG_BITRATEMSB, bit_rate, 2);
 }
 
 /* SET DATA MODE.
@@ -425,12 +588,11 @@ unsigned short SX1232_GetIrqFlags(void) {
 	SPI1_SetClockPolarity(0);
 #endif
 	// Read registers.
-	unsigned char reg_value = 0;
+	unsigned char irq_flags[2];
 	unsigned short irq_flags_value = 0;
-	SX1232_ReadRegister(SX1232_REG_IRQFLAGS1, &reg_value);
-	irq_flags_value |= (reg_value << 8);
-	SX1232_ReadRegister(SX1232_REG_IRQFLAGS2, &reg_value);
-	irq_flags_value |= (reg_value << 0);
+	SX1232_ReadRegisters(SX1232_REG_IRQFLAGS1, irq_flags, 2);
+	irq_flags_value |= (irq_flags[0] << 8);
+	irq_flags_value |= (irq_flags[1] << 0);
 	return irq_flags_value;
 }
 
@@ -538,31 +700,6 @@ void SX1232_EnableFastFrequencyHopping(void) {
 	SX1232_WriteRegister(SX1232_REG_PLLHOP, (reg_value | 0x80));
 }
 
-/* START CONTINUOUS WAVE OUTPUT.
- * @param:	None.
- * @return:	None.
- */
-void SX1232_StartCw(void) {
-	// Start data signal.
-	GPIO_Write(&GPIO_SX1232_DIO2, 1);
-	// Start radio.
-	SX1232_SetMode(SX1232_MODE_FSTX);
-	LPTIM1_DelayMilliseconds(2, 1); // Wait TS_FS=60us typical.
-	SX1232_SetMode(SX1232_MODE_TX);
-	LPTIM1_DelayMilliseconds(2, 1); // Wait TS_TR=120us typical.
-}
-
-/* STOP CONTINUOUS WAVE OUTPUT.
- * @param:	None.
- * @return:	None.
- */
-void SX1232_StopCw(void) {
-	// Stop data signal and radio.
-	GPIO_Write(&GPIO_SX1232_DIO2, 0);
-	LPTIM1_DelayMilliseconds(2, 1); // Wait ramp down.
-	SX1232_SetMode(SX1232_MODE_STANDBY);
-}
-
 /* SET SX1232 RX BANDWIDTH.
  * @param rxbw_mantissa:	RXBW mantissa (see p.30 of SX1232 datasheet).
  * @param rxbw_exponenta:	RXBW exponent (see p.30 of SX1232 datasheet).
@@ -661,19 +798,18 @@ void SX1232_SetSyncWord(unsigned char* sync_word, unsigned char sync_word_length
 	// Check parameters.
 	if ((sync_word_length_bytes > 0) && (sync_word_length_bytes <= SX1232_SYNC_WORD_MAXIMUM_LENGTH_BYTES)) {
 		// Set syncronization word length.
-		unsigned char reg_value = 0;
-		SX1232_ReadRegister(SX1232_REG_SYNCCONFIG, &reg_value);
-		reg_value &= 0xF8; // Reset bits 0-2.
-		reg_value |= ((sync_word_length_bytes - 1) & 0x07);
-		reg_value &= 0x3F; // Disable receiver auto_restart.
-		reg_value |= 0x10; // Enable syncronization word detector.
-		SX1232_WriteRegister(SX1232_REG_SYNCCONFIG, reg_value);
-		// Fill synchronization word.
+		unsigned char sync_regs[1 + SX1232_SYNC_WORD_MAXIMUM_LENGTH_BYTES];
+		SX1232_ReadRegister(SX1232_REG_SYNCCONFIG, &(sync_regs[0]));
+		sync_regs[0] &= 0xF8; // Reset bits 0-2.
+		sync_regs[0] |= ((sync_word_length_bytes - 1) & 0x07);
+		sync_regs[0] &= 0x3F; // Disable receiver auto_restart.
+		sync_regs[0] |= 0x10; // Enable syncronization word detector.
+		// Fill synchronization word (SYNCVALUE registers directly follow SYNCCONFIG).
 		unsigned char byte_idx = 0;
 		for (byte_idx=0 ; byte_idx<sync_word_length_bytes ; byte_idx++) {
-			// Warning: this loop is working because registers addresses are adjacent.
-			SX1232_WriteRegister((SX1232_REG_SYNCVALUE1 + byte_idx), sync_word[byte_idx]);
+			sync_regs[1 + byte_idx] = sync_word[byte_idx];
 		}
+		SX1232_WriteRegisters(SX1232_REG_SYNCCONFIG, sync_regs, (1 + sync_word_length_bytes));
 	}
 }
 
@@ -707,6 +843,7 @@ void SX1232_ConfigureRssi(signed char rssi_offset, SX1232_RssiSampling rssi_samp
 	// Configure sampling.
 	unsigned char rssi_config_reg_value = 0; // Do not use internal RSSI offset.
 	rssi_config_reg_value |= (rssi_sampling & 0x00000007);
+	SX1232_WriteRegister(SX1232_REG_RSSICONFIG, rssi_config_reg_value);
 }
 
 /* READ SX1232 RSSI.
@@ -735,11 +872,80 @@ void SX1232_ReadFifo(unsigned char* rx_data, unsigned char rx_data_length) {
 	// Configure SPI.
 	SPI1_SetClockPolarity(0);
 #endif
-	// Access FIFO byte per byte.
-	unsigned char byte_idx = 0;
-	unsigned char rx_data_byte = 0;
-	for (byte_idx=0 ; byte_idx<rx_data_length ; byte_idx++) {
-		SX1232_ReadRegister(SX1232_REG_FIFO, &rx_data_byte);
-		rx_data[byte_idx] = rx_data_byte;
-	}
+	// Read FIFO in a single burst.
+	SX1232_ReadRegisters(SX1232_REG_FIFO, rx_data, rx_data_length);
+}
+
+/* ENABLE SX1232 DIO0 AND DIO2 INTERRUPTS (RX PACKET MODE).
+ * @param:	None.
+ * @return:	None.
+ */
+void SX1232_EnableDioInterrupts(void) {
+	// DIO2 is an input in packet mode.
+	GPIO_Configure(&GPIO_SX1232_DIO2, GPIO_MODE_INPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
+	// Configure EXTI lines.
+	EXTI_ConfigureGpio(&GPIO_SX1232_DIO0, EXTI_TRIGGER_RISING_EDGE);
+	EXTI_ConfigureGpio(&GPIO_SX1232_DIO2, EXTI_TRIGGER_RISING_EDGE);
+	// Reset flags.
+	sx1232_ctx.sx1232_dio0_flag = 0;
+	sx1232_ctx.sx1232_dio2_flag = 0;
+	// Enable interrupts.
+#ifdef HW1_0
+	NVIC_EnableInterrupt(NVIC_IT_EXTI_2_3);
+	NVIC_EnableInterrupt(NVIC_IT_EXTI_4_15);
+#else
+	NVIC_EnableInterrupt(NVIC_IT_EXTI_0_1);
+#endif
+}
+
+/* DISABLE SX1232 DIO0 AND DIO2 INTERRUPTS.
+ * @param:	None.
+ * @return:	None.
+ */
+void SX1232_DisableDioInterrupts(void) {
+	// Disable interrupts (wind and rain measurements are stopped during radio operations).
+#ifdef HW1_0
+	NVIC_DisableInterrupt(NVIC_IT_EXTI_2_3);
+	NVIC_DisableInterrupt(NVIC_IT_EXTI_4_15);
+#else
+	NVIC_DisableInterrupt(NVIC_IT_EXTI_0_1);
+#endif
+	// Release EXTI lines.
+	EXTI_DisableGpio(&GPIO_SX1232_DIO0);
+	EXTI_DisableGpio(&GPIO_SX1232_DIO2);
+	// Put DIO2 back in output mode for continuous mode modulation.
+	GPIO_Configure(&GPIO_SX1232_DIO2, GPIO_MODE_OUTPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
+	GPIO_Write(&GPIO_SX1232_DIO2, 0);
+}
+
+/* GET SX1232 DIO0 INTERRUPT STATUS.
+ * @param:	None.
+ * @return:	1 if a rising edge occured on DIO0 since interrupts were enabled, 0 otherwise.
+ */
+volatile unsigned char SX1232_GetDio0Flag(void) {
+	return sx1232_ctx.sx1232_dio0_flag;
+}
+
+/* GET SX1232 DIO2 INTERRUPT STATUS.
+ * @param:	None.
+ * @return:	1 if a rising edge occured on DIO2 since interrupts were enabled, 0 otherwise.
+ */
+volatile unsigned char SX1232_GetDio2Flag(void) {
+	return sx1232_ctx.sx1232_dio2_flag;
+}
+
+/* FUNCTION CALLED BY EXTI INTERRUPT HANDLER WHEN A RISING EDGE IS DETECTED ON DIO0.
+ * @param:	None.
+ * @return:	None.
+ */
+void SX1232_Dio0EdgeCallback(void) {
+	sx1232_ctx.sx1232_dio0_flag = 1;
+}
+
+/* FUNCTION CALLED BY EXTI INTERRUPT HANDLER WHEN A RISING EDGE IS DETECTED ON DIO2.
+ * @param:	None.
+ * @return:	None.
+ */
+void SX1232_Dio2EdgeCallback(void) {
+	sx1232_ctx.sx1232_dio2_flag = 1;
 }
@@ -14,6 +14,7 @@
 #include "max11136.h"
 #include "mode.h"
 #include "nvic.h"
+#include "radio.h"
 #include "rcc.h"
 #include "spi.h"
 #include "usart.h"
@@ -217,9 +218,10 @@ void WIND_Init(void) {
  * @return:	None.
  */
 void WIND_StartContinuousMeasure(void) {
-	// Reset second counters.
+	// Reset second counters and drop edges of the interrupted period.
 	wind_ctx.wind_speed_seconds_count = 0;
 	wind_ctx.wind_direction_seconds_count = 0;
+	wind_ctx.wind_speed_edge_count = 0;
 #ifdef WIND_VANE_ULTIMETER
 	// Init phase shift timers: TBD.
 	LPTIM1_Enable();
@@ -356,7 +358,7 @@ void WIND_MeasurementPeriodCallback(void) {
 			// Get direction from ADC.
 #ifdef HW1_0
 			SPI1_Enable();
-			SPI1_PowerOn();
+			RADIO_SetState(RADIO_STATE_SUPPLY); // External ADC is supplied by the radio SPI bus.
 #endif
 #ifdef HW2_0
 			SPI2_Enable();
@@ -364,7 +366,7 @@ void WIND_MeasurementPeriodCallback(void) {
 #endif
 			MAX11136_PerformMeasurements();
 #ifdef HW1_0
-			SPI1_PowerOff();
+			RADIO_SetState(RADIO_STATE_OFF);
 			SPI1_Disable();
 #endif
 #ifdef HW2_0
@@ -30,14 +30,15 @@
 #include "dps310.h"
 #include "max11136.h"
 #include "neom8n.h"
+#include "radio.h"
 #include "sht3x.h"
 #include "si1133.h"
-#include "sky13317.h"
-#include "sx1232.h"
 #include "sigfox_types.h"
 #include "wind.h"
 // Applicative.
+#include "airtime.h"
 #include "at.h"
+#include "link.h"
 #include "mode.h"
 #include "rain.h"
 #include "sigfox_api.h"
@@ -64,8 +65,23 @@
 #define SPSWS_SIGFOX_WEATHER_DATA_LENGTH			10
 #endif
 #define SPSWS_SIGFOX_MONITORING_DATA_LENGTH			9
+#define SPSWS_SIGFOX_LINK_DATA_LENGTH				7 // Must differ from all other frame lengths (frame type is decoded from length).
 #define SPSWS_SIGFOX_GEOLOC_DATA_LENGTH				11
 #define SPSWS_SIGFOX_GEOLOC_TIMEOUT_DATA_LENGTH		1
+#define SPSWS_SIGFOX_BACKFILL_DATA_LENGTH			(SPSWS_SIGFOX_WEATHER_DATA_LENGTH + 2) // Weather data + UTC month, date and hours.
+#define SPSWS_SIGFOX_OOB_DATA_LENGTH				8
+#define SPSWS_SIGFOX_ERROR_DUTY_CYCLE				0xFF00 // Manufacturer error: frame not sent to respect sub-band duty cycle.
+// Backfill (ETSI duty cycle allows 6 uplinks per hour, 3 are used by monitoring, weather and geoloc frames, plus the link frame once a day).
+// AIRTIME admission still bounds the hour where all of them are sent.
+#define SPSWS_BACKFILL_FRAMES_PER_HOUR_MAX			2
+#define SPSWS_BACKFILL_SUPERCAP_VOLTAGE_MIN_MV		2000
+// Uplink slot (measurements are performed on the hour, uplinks are spread over the fleet).
+#define SPSWS_UPLINK_SLOT_OFFSET_MAX_SECONDS		3000 // Keep time for geolocation and RTC calibration before the next hour.
+#define SPSWS_UPLINK_SLOT_HASH_MULTIPLIER			2654435761 // Knuth multiplicative hash (spreads consecutive device IDs).
+
+#if (SPSWS_SIGFOX_BACKFILL_DATA_LENGTH != NVM_BACKLOG_DATA_SIZE_BYTES)
+#error "Backfill frame must fit exactly in a NVM backlog entry."
+#endif
 
 /*** SPSWS structures ***/
 
@@ -76,8 +92,11 @@ typedef enum {
 	SPSWS_STATE_INIT,
 	SPSWS_STATE_POR,
 	SPSWS_STATE_MEASURE,
+	SPSWS_STATE_UPLINK_SLOT,
 	SPSWS_STATE_MONITORING,
+	SPSWS_STATE_LINK,
 	SPSWS_STATE_WEATHER_DATA,
+	SPSWS_STATE_BACKFILL,
 	SPSWS_STATE_GEOLOC,
 	SPSWS_STATE_RTC_CALIBRATION,
 	SPSWS_STATE_OFF,
@@ -127,6 +146,32 @@ typedef union {
 	} __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed)) field;
 } SPSWS_SigfoxMonitoringData;
 
+// Sigfox link frame data format (radio link statistics of the previous day, sent once a day).
+typedef union {
+	unsigned char raw_frame[SPSWS_SIGFOX_LINK_DATA_LENGTH];
+	struct {
+		unsigned tx_power_backoff_db : 8;
+		unsigned uplinks_attempted : 8;
+		unsigned uplinks_failed : 8;
+		unsigned downlinks_requested : 8;
+		unsigned downlinks_received : 8;
+		unsigned rssi_min_dbm : 8; // RSSI values are absolute values.
+		unsigned rssi_mean_dbm : 8;
+	} __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed)) field;
+} SPSWS_SigfoxLinkData;
+
+// Sigfox backfill frame data format (weather data of a previous hour).
+typedef union {
+	unsigned char raw_frame[SPSWS_SIGFOX_BACKFILL_DATA_LENGTH];
+	struct {
+		unsigned char weather_data[SPSWS_SIGFOX_WEATHER_DATA_LENGTH];
+		unsigned month : 4; // UTC timestamp of the measurements.
+		unsigned date : 5;
+		unsigned hours : 5;
+		unsigned unused : 2;
+	} __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed)) field;
+} SPSWS_SigfoxBackfillData;
+
 // Sigfox geolocation frame data format.
 typedef union {
 	unsigned char raw_frame[SPSWS_SIGFOX_GEOLOC_DATA_LENGTH];
@@ -155,14 +200,17 @@ typedef struct {
 	unsigned char spsws_hour_changed_flag;
 	unsigned char spsws_day_changed_flag;
 	unsigned char spsws_is_afternoon_flag;
+	unsigned char spsws_link_report_flag;
 	// Wake-up management.
 	Timestamp spsws_current_timestamp;
 	Timestamp spsws_previous_wake_up_timestamp;
 	// Monitoring.
 	unsigned char spsws_status_byte;
 	SPSWS_SigfoxMonitoringData spsws_sigfox_monitoring_data;
+	SPSWS_SigfoxLinkData spsws_sigfox_link_data;
 	// Weather data.
 	SPSWS_SigfoxWeatherData spsws_sigfox_weather_data;
+	SPSWS_SigfoxBackfillData spsws_sigfox_backfill_data;
 	// Geoloc.
 	Position spsws_geoloc_position;
 	unsigned int spsws_geoloc_fix_duration_seconds;
@@ -216,17 +264,11 @@ void SPSWS_BlinkLed(unsigned char number_of_blinks) {
 void SPSWS_UpdateTimestampFlags(void) {
 	// Retrieve current timestamp from RTC.
 	RTC_GetTimestamp(&spsws_ctx.spsws_current_timestamp);
-	// Retrieve previous wake-up timestamp from NVM.
-	unsigned char nvm_byte = 0;
-	NVM_Enable();
-	NVM_ReadByte((NVM_RTC_PWKUP_YEAR_ADDRESS_OFFSET + 0), &nvm_byte);
-	spsws_ctx.spsws_previous_wake_up_timestamp.year = (nvm_byte << 8);
-	NVM_ReadByte((NVM_RTC_PWKUP_YEAR_ADDRESS_OFFSET + 1), &nvm_byte);
-	spsws_ctx.spsws_previous_wake_up_timestamp.year |= nvm_byte;
-	NVM_ReadByte(NVM_RTC_PWKUP_MONTH_ADDRESS_OFFSET, &spsws_ctx.spsws_previous_wake_up_timestamp.month);
-	NVM_ReadByte(NVM_RTC_PWKUP_DATE_ADDRESS_OFFSET, &spsws_ctx.spsws_previous_wake_up_timestamp.date);
-	NVM_ReadByte(NVM_RTC_PWKUP_HOURS_ADDRESS_OFFSET, &spsws_ctx.spsws_previous_wake_up_timestamp.hours);
-	NVM_Disable();
+	// Retrieve previous wake-up timestamp from NVM journal.
+	spsws_ctx.spsws_previous_wake_up_timestamp.year = NVM_GetRtcPwkupYear();
+	spsws_ctx.spsws_previous_wake_up_timestamp.month = NVM_GetRtcPwkupMonth();
+	spsws_ctx.spsws_previous_wake_up_timestamp.date = NVM_GetRtcPwkupDate();
+	spsws_ctx.spsws_previous_wake_up_timestamp.hours = NVM_GetRtcPwkupHours();
 	// Check timestamp are differents (avoiding false wake-up due to RTC recalibration).
 	if ((spsws_ctx.spsws_current_timestamp.year != spsws_ctx.spsws_previous_wake_up_timestamp.year) ||
 		(spsws_ctx.spsws_current_timestamp.month != spsws_ctx.spsws_previous_wake_up_timestamp.month) ||
@@ -262,14 +304,44 @@ void SPSWS_UpdatePwut(void) {
 	RTC_GetTimestamp(&spsws_ctx.spsws_current_timestamp);
 	// Update previous wake-up timestamp.
 	NVM_Enable();
-	NVM_WriteByte((NVM_RTC_PWKUP_YEAR_ADDRESS_OFFSET + 0), ((spsws_ctx.spsws_current_timestamp.year & 0xFF00) >> 8));
-	NVM_WriteByte((NVM_RTC_PWKUP_YEAR_ADDRESS_OFFSET + 1), ((spsws_ctx.spsws_current_timestamp.year & 0x00FF) >> 0));
-	NVM_WriteByte(NVM_RTC_PWKUP_MONTH_ADDRESS_OFFSET, spsws_ctx.spsws_current_timestamp.month);
-	NVM_WriteByte(NVM_RTC_PWKUP_DATE_ADDRESS_OFFSET, spsws_ctx.spsws_current_timestamp.date);
-	NVM_WriteByte(NVM_RTC_PWKUP_HOURS_ADDRESS_OFFSET, spsws_ctx.spsws_current_timestamp.hours);
+	NVM_SetRtcPwkupYear(spsws_ctx.spsws_current_timestamp.year);
+	NVM_SetRtcPwkupMonth(spsws_ctx.spsws_current_timestamp.month);
+	NVM_SetRtcPwkupDate(spsws_ctx.spsws_current_timestamp.date);
+	NVM_SetRtcPwkupHours(spsws_ctx.spsws_current_timestamp.hours);
 	NVM_Disable();
 }
 
+/* COMPUTE UPLINK INSTANT OF THE DEVICE WITHIN THE HOUR.
+ * @param:	None.
+ * @return:	Uplink offset in seconds after the hour.
+ */
+unsigned int SPSWS_GetUplinkSlotOffset(void) {
+	// Read device ID and slot configuration.
+	unsigned char device_id[NVM_SIGFOX_ID_LENGTH_BYTES];
+	unsigned short slot_window_minutes = NVM_GetUplinkSlotWindow();
+	unsigned short slot_jitter_seconds = NVM_GetUplinkSlotJitter();
+	unsigned char byte_idx = 0;
+	unsigned int hash_seed = 0;
+	NVM_ReadSigfoxId(device_id);
+	for (byte_idx=0 ; byte_idx<NVM_SIGFOX_ID_LENGTH_BYTES ; byte_idx++) {
+		hash_seed = (hash_seed << 8) | device_id[byte_idx];
+	}
+	// Fixed offset derived from device ID.
+	unsigned int hash = hash_seed * SPSWS_UPLINK_SLOT_HASH_MULTIPLIER;
+	hash ^= (hash >> 16);
+	unsigned int slot_offset_seconds = hash % (slot_window_minutes * 60);
+	// Optional jitter which changes every hour.
+	if (slot_jitter_seconds != 0) {
+		hash = (hash_seed ^ (spsws_ctx.spsws_current_timestamp.date << 8) ^ spsws_ctx.spsws_current_timestamp.hours) * SPSWS_UPLINK_SLOT_HASH_MULTIPLIER;
+		hash ^= (hash >> 16);
+		slot_offset_seconds += hash % (slot_jitter_seconds + 1);
+	}
+	if (slot_offset_seconds > SPSWS_UPLINK_SLOT_OFFSET_MAX_SECONDS) {
+		slot_offset_seconds = SPSWS_UPLINK_SLOT_OFFSET_MAX_SECONDS;
+	}
+	return slot_offset_seconds;
+}
+
 /*** SPSWS main function ***/
 
 #if (defined IM || defined CM)
@@ -294,11 +366,14 @@ int main (void) {
 	spsws_ctx.spsws_hour_changed_flag = 0;
 	spsws_ctx.spsws_day_changed_flag = 0;
 	spsws_ctx.spsws_is_afternoon_flag = 0;
+	spsws_ctx.spsws_link_report_flag = 0;
 	spsws_ctx.spsws_geoloc_timeout_flag = 0;
 	spsws_ctx.spsws_geoloc_fix_duration_seconds = 0;
+	// Retrieve NVM records and journal fields.
 	NVM_Enable();
-	NVM_ReadByte(NVM_MONITORING_STATUS_BYTE_ADDRESS_OFFSET, &spsws_ctx.spsws_status_byte);
+	NVM_Init();
 	NVM_Disable();
+	spsws_ctx.spsws_status_byte = NVM_GetMonitoringStatusByte();
 #ifdef IM
 	spsws_ctx.spsws_status_byte &= ~(0b1 << SPSWS_STATUS_BYTE_STATION_MODE_BIT_IDX); // IM = 0b0.
 #else
@@ -315,6 +390,7 @@ int main (void) {
 	unsigned int generic_data_u32_2 = 0;
 	NEOM8N_ReturnCode neom8n_return_code = NEOM8N_TIMEOUT;
 	sfx_error_t sfx_error = SFX_ERR_NONE;
+	LINK_Statistics link_statistics;
 	// Main loop.
 	while (1) {
 		// Perform state machine.
@@ -360,6 +436,11 @@ int main (void) {
 				spsws_ctx.spsws_status_byte &= ~(0b1 << SPSWS_STATUS_BYTE_DAILY_RTC_CALIBRATION_BIT_IDX);
 				spsws_ctx.spsws_status_byte &= ~(0b1 << SPSWS_STATUS_BYTE_DAILY_DOWNLINK_BIT_IDX);
 				spsws_ctx.spsws_status_byte &= ~(0b1 << SPSWS_STATUS_BYTE_DAILY_GEOLOC_BIT_IDX);
+				// Store radio link statistics of the previous day.
+				NVM_Enable();
+				LINK_Summarize();
+				NVM_Disable();
+				spsws_ctx.spsws_link_report_flag = 1;
 				// Reset flags.
 				spsws_ctx.spsws_day_changed_flag = 0;
 				spsws_ctx.spsws_hour_changed_flag = 0;
@@ -404,6 +485,9 @@ int main (void) {
 				if (spsws_ctx.spsws_lse_running == 0) {
 					spsws_ctx.spsws_status_byte &= ~(0b1 << SPSWS_STATUS_BYTE_LSE_STATUS_BIT_IDX);
 				}
+				// Restore duty cycle ledger from last checkpoint and start radio link statistics.
+				AIRTIME_Init();
+				LINK_Init();
 			}
 			IWDG_Reload();
 			// Communication interfaces.
@@ -420,9 +504,7 @@ int main (void) {
 			SPI2_Init();
 #endif
 			// Init components.
-			SX1232_Init();
-			SX1232_Tcxo(1);
-			SKY13317_Init();
+			RADIO_Init();
 			NEOM8N_Init();
 			MAX11136_Init();
 			SHT3X_Init();
@@ -453,7 +535,7 @@ int main (void) {
 			spsws_ctx.spsws_sigfox_monitoring_data.field.mcu_voltage_mv = generic_data_u32_1;
 			// Retrieve external ADC data.
 #ifdef HW1_0
-			SPI1_PowerOn();
+			RADIO_SetState(RADIO_STATE_SUPPLY); // External ADC is supplied by the radio SPI bus.
 #endif
 #ifdef HW2_0
 			I2C1_PowerOn(); // Must be called before ADC since LDR is on the MSM module (powered by I2C sensors supply).
@@ -463,7 +545,7 @@ int main (void) {
 			MAX11136_PerformMeasurements();
 
 #ifdef HW1_0
-			SPI1_PowerOff();
+			RADIO_SetState(RADIO_STATE_OFF);
 #endif
 #ifdef HW2_0
 			SPI2_PowerOff();
@@ -523,35 +605,168 @@ int main (void) {
 			// Retrieve rain measurements.
 			RAIN_GetPluviometry(&generic_data_u8);
 			spsws_ctx.spsws_sigfox_weather_data.field.rain_mm = generic_data_u8;
+			// Start next measurement period.
+			WIND_ResetData();
+			RAIN_ResetData();
 #endif
 			// Read status byte.
 			spsws_ctx.spsws_sigfox_monitoring_data.field.status_byte = spsws_ctx.spsws_status_byte;
 			// Compute next state.
+			spsws_ctx.spsws_state = SPSWS_STATE_UPLINK_SLOT;
+			break;
+		// UPLINK SLOT.
+		case SPSWS_STATE_UPLINK_SLOT:
+			IWDG_Reload();
+			// Wait for the device uplink instant (alarm A is set on the hour).
+			generic_data_u32_1 = SPSWS_GetUplinkSlotOffset();
+			generic_data_u32_2 = (RTC_GetTimeOfDayMilliseconds() / 1000) % 3600;
+			if (generic_data_u32_2 < generic_data_u32_1) {
+				// Switch to MSI and enter stop mode until RTC wake-up timer expires (alarm B reloads watchdog every second).
+				RCC_SwitchToMsi();
+#ifdef CM
+				// Keep measuring wind and rain during the wait.
+				WIND_StartContinuousMeasure();
+				RAIN_StartContinuousMeasure();
+#endif
+				RTC_ClearWakeUpTimerFlag();
+				RTC_StartWakeUpTimer(generic_data_u32_1 - generic_data_u32_2);
+				RTC_ClearAlarmBFlag();
+				RTC_EnableAlarmBInterrupt();
+				while (RTC_GetWakeUpTimerFlag() == 0) {
+					IWDG_Reload();
+					PWR_EnterStopMode();
+					if (RTC_GetAlarmBFlag() != 0) {
+#ifdef CM
+						// Call WIND callback.
+						WIND_MeasurementPeriodCallback();
+#endif
+						RTC_ClearAlarmBFlag();
+					}
+				}
+				RTC_DisableAlarmBInterrupt();
+				RTC_StopWakeUpTimer();
+				RTC_ClearWakeUpTimerFlag();
+#ifdef CM
+				// Stop continuous measurements during radio operations.
+				WIND_StopContinuousMeasure();
+				RAIN_StopContinuousMeasure();
+#endif
+				// Restore high speed oscillator.
+				spsws_ctx.spsws_status_byte &= ~(0b1 << SPSWS_STATUS_BYTE_MCU_CLOCK_SOURCE_BIT_IDX);
+				spsws_ctx.spsws_status_byte |= (RCC_SwitchToHse() << SPSWS_STATUS_BYTE_MCU_CLOCK_SOURCE_BIT_IDX);
+				if ((spsws_ctx.spsws_status_byte & (0b1 << SPSWS_STATUS_BYTE_MCU_CLOCK_SOURCE_BIT_IDX)) == 0) {
+					RCC_SwitchToHsi();
+				}
+			}
+			// Compute next state.
 			spsws_ctx.spsws_state = SPSWS_STATE_MONITORING;
 			break;
 		// MONITORING.
 		case SPSWS_STATE_MONITORING:
 			IWDG_Reload();
-			// Send uplink monitoring frame.
-			sfx_error = SIGFOX_API_open(&spsws_ctx.spsws_sfx_rc);
-			if (sfx_error == SFX_ERR_NONE) {
-				sfx_error = SIGFOX_API_set_std_config(spsws_ctx.spsws_sfx_rc_std_config, SFX_FALSE);
-				sfx_error = SIGFOX_API_send_frame(spsws_ctx.spsws_sigfox_monitoring_data.raw_frame, SPSWS_SIGFOX_MONITORING_DATA_LENGTH, spsws_ctx.spsws_sfx_downlink_data, 2, 0);
+			// Request a downlink once a day (link margin feedback for uplink output power control).
+			generic_data_u8 = ((spsws_ctx.spsws_status_byte & (0b1 << SPSWS_STATUS_BYTE_DAILY_DOWNLINK_BIT_IDX)) == 0) ? 1 : 0;
+			// Send uplink monitoring frame if duty cycle allows it.
+			sfx_error = SPSWS_SIGFOX_ERROR_DUTY_CYCLE;
+			if (AIRTIME_Admit(AIRTIME_GetUplinkDuration(SPSWS_SIGFOX_MONITORING_DATA_LENGTH, generic_data_u8)) != 0) {
+				sfx_error = SIGFOX_API_open(&spsws_ctx.spsws_sfx_rc);
+				if (sfx_error == SFX_ERR_NONE) {
+					sfx_error = SIGFOX_API_set_std_config(spsws_ctx.spsws_sfx_rc_std_config, SFX_FALSE);
+					sfx_error = SIGFOX_API_send_frame(spsws_ctx.spsws_sigfox_monitoring_data.raw_frame, SPSWS_SIGFOX_MONITORING_DATA_LENGTH, spsws_ctx.spsws_sfx_downlink_data, 2, generic_data_u8);
+				}
+				SIGFOX_API_close();
+				LINK_RecordUplink(sfx_error, generic_data_u8);
 			}
-			SIGFOX_API_close();
+			// Downlink is attempted only once a day, whatever the result.
+			spsws_ctx.spsws_status_byte |= (generic_data_u8 << SPSWS_STATUS_BYTE_DAILY_DOWNLINK_BIT_IDX);
+			// Compute next state.
+			spsws_ctx.spsws_state = (spsws_ctx.spsws_link_report_flag != 0) ? SPSWS_STATE_LINK : SPSWS_STATE_WEATHER_DATA;
+			break;
+		// LINK.
+		case SPSWS_STATE_LINK:
+			IWDG_Reload();
+			// Read current output power reduction and radio link statistics of the previous day.
+			spsws_ctx.spsws_sigfox_link_data.field.tx_power_backoff_db = NVM_GetTxPowerBackoff();
+			if (LINK_GetPreviousDay(&link_statistics) != 0) {
+				spsws_ctx.spsws_sigfox_link_data.field.uplinks_attempted = link_statistics.field.uplinks_attempted;
+				spsws_ctx.spsws_sigfox_link_data.field.uplinks_failed = link_statistics.field.uplinks_failed;
+				spsws_ctx.spsws_sigfox_link_data.field.downlinks_requested = link_statistics.field.downlinks_requested;
+				spsws_ctx.spsws_sigfox_link_data.field.downlinks_received = link_statistics.field.downlinks_received;
+				spsws_ctx.spsws_sigfox_link_data.field.rssi_min_dbm = link_statistics.field.rssi_min_dbm;
+				spsws_ctx.spsws_sigfox_link_data.field.rssi_mean_dbm = link_statistics.field.rssi_mean_dbm;
+				// Send uplink link frame if duty cycle allows it.
+				sfx_error = SPSWS_SIGFOX_ERROR_DUTY_CYCLE;
+				if (AIRTIME_Admit(AIRTIME_GetUplinkDuration(SPSWS_SIGFOX_LINK_DATA_LENGTH, 0)) != 0) {
+					sfx_error = SIGFOX_API_open(&spsws_ctx.spsws_sfx_rc);
+					if (sfx_error == SFX_ERR_NONE) {
+						sfx_error = SIGFOX_API_set_std_config(spsws_ctx.spsws_sfx_rc_std_config, SFX_FALSE);
+						sfx_error = SIGFOX_API_send_frame(spsws_ctx.spsws_sigfox_link_data.raw_frame, SPSWS_SIGFOX_LINK_DATA_LENGTH, spsws_ctx.spsws_sfx_downlink_data, 2, 0);
+					}
+					SIGFOX_API_close();
+					LINK_RecordUplink(sfx_error, 0);
+				}
+			}
+			// Report is attempted only once a day, whatever the result.
+			spsws_ctx.spsws_link_report_flag = 0;
 			// Compute next state.
 			spsws_ctx.spsws_state = SPSWS_STATE_WEATHER_DATA;
 			break;
 		// WEATHER DATA.
 		case SPSWS_STATE_WEATHER_DATA:
 			IWDG_Reload();
-			// Send uplink weather frame.
-			sfx_error = SIGFOX_API_open(&spsws_ctx.spsws_sfx_rc);
-			if (sfx_error == SFX_ERR_NONE) {
-				sfx_error = SIGFOX_API_set_std_config(spsws_ctx.spsws_sfx_rc_std_config, SFX_FALSE);
-				sfx_error = SIGFOX_API_send_frame(spsws_ctx.spsws_sigfox_weather_data.raw_frame, SPSWS_SIGFOX_WEATHER_DATA_LENGTH, spsws_ctx.spsws_sfx_downlink_data, 2, 0);
+			// Send uplink weather frame if duty cycle allows it.
+			sfx_error = SPSWS_SIGFOX_ERROR_DUTY_CYCLE;
+			if (AIRTIME_Admit(AIRTIME_GetUplinkDuration(SPSWS_SIGFOX_WEATHER_DATA_LENGTH, 0)) != 0) {
+				sfx_error = SIGFOX_API_open(&spsws_ctx.spsws_sfx_rc);
+				if (sfx_error == SFX_ERR_NONE) {
+					sfx_error = SIGFOX_API_set_std_config(spsws_ctx.spsws_sfx_rc_std_config, SFX_FALSE);
+					sfx_error = SIGFOX_API_send_frame(spsws_ctx.spsws_sigfox_weather_data.raw_frame, SPSWS_SIGFOX_WEATHER_DATA_LENGTH, spsws_ctx.spsws_sfx_downlink_data, 2, 0);
+				}
+				SIGFOX_API_close();
+				LINK_RecordUplink(sfx_error, 0);
+			}
+			// Store data in NVM backlog if the frame could not be sent.
+			if (sfx_error != SFX_ERR_NONE) {
+				for (idx=0 ; idx<SPSWS_SIGFOX_WEATHER_DATA_LENGTH ; idx++) spsws_ctx.spsws_sigfox_backfill_data.field.weather_data[idx] = spsws_ctx.spsws_sigfox_weather_data.raw_frame[idx];
+				spsws_ctx.spsws_sigfox_backfill_data.field.month = spsws_ctx.spsws_current_timestamp.month;
+				spsws_ctx.spsws_sigfox_backfill_data.field.date = spsws_ctx.spsws_current_timestamp.date;
+				spsws_ctx.spsws_sigfox_backfill_data.field.hours = spsws_ctx.spsws_current_timestamp.hours;
+				spsws_ctx.spsws_sigfox_backfill_data.field.unused = 0;
+				NVM_Enable();
+				NVM_BacklogPush(spsws_ctx.spsws_sigfox_backfill_data.raw_frame);
+				NVM_Disable();
+			}
+			// Compute next state.
+			spsws_ctx.spsws_state = SPSWS_STATE_BACKFILL;
+			break;
+		// BACKFILL.
+		case SPSWS_STATE_BACKFILL:
+			// Send stored weather data only if the link is up and energy is sufficient.
+			if ((sfx_error == SFX_ERR_NONE) && (spsws_ctx.spsws_sigfox_monitoring_data.field.supercap_voltage_mv >= SPSWS_BACKFILL_SUPERCAP_VOLTAGE_MIN_MV)) {
+				for (generic_data_u8=0 ; generic_data_u8<SPSWS_BACKFILL_FRAMES_PER_HOUR_MAX ; generic_data_u8++) {
+					IWDG_Reload();
+					// Get oldest pending data.
+					NVM_Enable();
+					idx = NVM_BacklogPeek(spsws_ctx.spsws_sigfox_backfill_data.raw_frame);
+					NVM_Disable();
+					if (idx == 0) break;
+					// Keep data in backlog if duty cycle budget is exhausted.
+					if (AIRTIME_Admit(AIRTIME_GetUplinkDuration(SPSWS_SIGFOX_BACKFILL_DATA_LENGTH, 0)) == 0) break;
+					// Send uplink backfill frame.
+					sfx_error = SIGFOX_API_open(&spsws_ctx.spsws_sfx_rc);
+					if (sfx_error == SFX_ERR_NONE) {
+						sfx_error = SIGFOX_API_set_std_config(spsws_ctx.spsws_sfx_rc_std_config, SFX_FALSE);
+						sfx_error = SIGFOX_API_send_frame(spsws_ctx.spsws_sigfox_backfill_data.raw_frame, SPSWS_SIGFOX_BACKFILL_DATA_LENGTH, spsws_ctx.spsws_sfx_downlink_data, 2, 0);
+					}
+					SIGFOX_API_close();
+					LINK_RecordUplink(sfx_error, 0);
+					// Stop at first failure, data remains in backlog.
+					if (sfx_error != SFX_ERR_NONE) break;
+					NVM_Enable();
+					NVM_BacklogPop();
+					NVM_Disable();
+				}
 			}
-			SIGFOX_API_close();
 			// Compute next state.
 			if ((spsws_ctx.spsws_status_byte & (0b1 << SPSWS_STATUS_BYTE_DAILY_RTC_CALIBRATION_BIT_IDX)) == 0) {
 				// Perform RTC calibration.
@@ -571,13 +786,16 @@ int main (void) {
 		// POR.
 		case SPSWS_STATE_POR:
 			IWDG_Reload();
-			// Send OOB frame.
-			sfx_error = SIGFOX_API_open(&spsws_ctx.spsws_sfx_rc);
-			if (sfx_error == SFX_ERR_NONE) {
-				sfx_error = SIGFOX_API_set_std_config(spsws_ctx.spsws_sfx_rc_std_config, SFX_FALSE);
-				sfx_error = SIGFOX_API_send_outofband(SFX_OOB_SERVICE);
+			// Send OOB frame if duty cycle allows it (protects the sub-band against reset loops).
+			if (AIRTIME_Admit(AIRTIME_GetUplinkDuration(SPSWS_SIGFOX_OOB_DATA_LENGTH, 0)) != 0) {
+				sfx_error = SIGFOX_API_open(&spsws_ctx.spsws_sfx_rc);
+				if (sfx_error == SFX_ERR_NONE) {
+					sfx_error = SIGFOX_API_set_std_config(spsws_ctx.spsws_sfx_rc_std_config, SFX_FALSE);
+					sfx_error = SIGFOX_API_send_outofband(SFX_OOB_SERVICE);
+				}
+				SIGFOX_API_close();
+				LINK_RecordUplink(sfx_error, 0);
 			}
-			SIGFOX_API_close();
 			// Reset all daily flags.
 			spsws_ctx.spsws_status_byte &= ~(0b1 << SPSWS_STATUS_BYTE_FIRST_RTC_CALIBRATION_BIT_IDX);
 			spsws_ctx.spsws_status_byte &= ~(0b1 << SPSWS_STATUS_BYTE_DAILY_RTC_CALIBRATION_BIT_IDX);
@@ -614,13 +832,17 @@ int main (void) {
 				spsws_ctx.spsws_geoloc_timeout_flag = 1;
 			}
 			IWDG_Reload();
-			// Send uplink geolocation frame.
-			sfx_error = SIGFOX_API_open(&spsws_ctx.spsws_sfx_rc);
-			if (sfx_error == SFX_ERR_NONE) {
-				sfx_error = SIGFOX_API_set_std_config(spsws_ctx.spsws_sfx_rc_std_config, SFX_FALSE);
-				sfx_error = SIGFOX_API_send_frame(spsws_ctx.spsws_sigfox_geoloc_data.raw_frame, ((spsws_ctx.spsws_geoloc_timeout_flag) ? SPSWS_SIGFOX_GEOLOC_TIMEOUT_DATA_LENGTH : SPSWS_SIGFOX_GEOLOC_DATA_LENGTH), spsws_ctx.spsws_sfx_downlink_data, 2, 0);
+			// Send uplink geolocation frame if duty cycle allows it.
+			generic_data_u8 = (spsws_ctx.spsws_geoloc_timeout_flag) ? SPSWS_SIGFOX_GEOLOC_TIMEOUT_DATA_LENGTH : SPSWS_SIGFOX_GEOLOC_DATA_LENGTH;
+			if (AIRTIME_Admit(AIRTIME_GetUplinkDuration(generic_data_u8, 0)) != 0) {
+				sfx_error = SIGFOX_API_open(&spsws_ctx.spsws_sfx_rc);
+				if (sfx_error == SFX_ERR_NONE) {
+					sfx_error = SIGFOX_API_set_std_config(spsws_ctx.spsws_sfx_rc_std_config, SFX_FALSE);
+					sfx_error = SIGFOX_API_send_frame(spsws_ctx.spsws_sigfox_geoloc_data.raw_frame, generic_data_u8, spsws_ctx.spsws_sfx_downlink_data, 2, 0);
+				}
+				SIGFOX_API_close();
+				LINK_RecordUplink(sfx_error, 0);
 			}
-			SIGFOX_API_close();
 			// Reset geoloc variables.
 			spsws_ctx.spsws_geoloc_timeout_flag = 0;
 			spsws_ctx.spsws_geoloc_fix_duration_seconds = 0;
@@ -630,8 +852,8 @@ int main (void) {
 		// RTC CALIBRATION.
 		case SPSWS_STATE_RTC_CALIBRATION:
 			IWDG_Reload();
-			// Turn radio TCXO off since Sigfox is not required anymore.
-			SX1232_Tcxo(0);
+			// Make sure radio is off since Sigfox is not required anymore.
+			RADIO_SetState(RADIO_STATE_OFF);
 			// Get current timestamp from GPS.{
 			LPUART1_PowerOn();
 			neom8n_return_code = NEOM8N_GetTimestamp(&spsws_ctx.spsws_current_timestamp, SPSWS_RTC_CALIBRATION_TIMEOUT_SECONDS, 0);
@@ -640,6 +862,8 @@ int main (void) {
 			if (neom8n_return_code == NEOM8N_SUCCESS) {
 				// Update RTC registers.
 				RTC_Calibrate(&spsws_ctx.spsws_current_timestamp);
+				AIRTIME_Synchronize();
+				RADIO_Synchronize();
 				// Update PWUT when first calibration.
 				if ((spsws_ctx.spsws_status_byte & (0b1 << SPSWS_STATUS_BYTE_FIRST_RTC_CALIBRATION_BIT_IDX)) == 0) {
 					SPSWS_UpdatePwut();
@@ -657,10 +881,8 @@ int main (void) {
 			// Clear POR flag.
 			spsws_ctx.spsws_por_flag = 0;
 			// Turn peripherals off.
-			SX1232_DisableGpio();
-			SKY13317_DisableGpio();
+			RADIO_DisableGpio();
 			MAX11136_DisableGpio();
-			SX1232_Tcxo(0);
 #ifdef HW2_0
 			SPI2_Disable();
 #endif
@@ -669,17 +891,16 @@ int main (void) {
 			SPI1_Disable();
 			LPUART1_Disable();
 			I2C1_Disable();
-			// Store status byte in NVM.
+			// Store status byte and duty cycle ledger checkpoint in NVM.
 			NVM_Enable();
-			NVM_WriteByte(NVM_MONITORING_STATUS_BYTE_ADDRESS_OFFSET, spsws_ctx.spsws_status_byte);
+			NVM_SetMonitoringStatusByte(spsws_ctx.spsws_status_byte);
+			AIRTIME_Checkpoint();
 			NVM_Disable();
 			// Switch to internal MSI 65kHz (must be called before WIND functions to init LPTIM with right clock frequency).
 			RCC_SwitchToMsi();
 			RCC_DisableGpio();
 #ifdef CM
-			// Re-start continuous measurements.
-			WIND_ResetData();
-			RAIN_ResetData();
+			// Re-start continuous measurements (data is reset when read, so that edges counted during the uplink slot wait are kept).
 			WIND_StartContinuousMeasure();
 			RAIN_StartContinuousMeasure();
 #endif
@@ -759,6 +980,10 @@ int main (void) {
 	}
 	RCC_GetLsiFrequency(&spsws_ctx.spsws_lsi_frequency_hz);
 	RTC_Init(&spsws_ctx.spsws_lse_running, spsws_ctx.spsws_lsi_frequency_hz);
+	// Retrieve NVM records and journal fields.
+	NVM_Enable();
+	NVM_Init();
+	NVM_Disable();
 	// Timers.
 	LPTIM1_Init(spsws_ctx.spsws_lsi_frequency_hz);
 	// Analog.
@@ -777,9 +1002,7 @@ int main (void) {
 	USART1_Init();
 #endif
 	// Init components.
-	SX1232_Init();
-	SX1232_Tcxo(1);
-	SKY13317_Init();
+	RADIO_Init();
 #ifdef AT_COMMANDS_GPS
 	NEOM8N_Init();
 #endif
@@ -792,6 +1015,8 @@ int main (void) {
 	SI1133_Init();
 #endif
 	// Init applicative layers.
+	AIRTIME_Init();
+	LINK_Init();
 	AT_Init();
 	// Main loop.
 	while (1) {
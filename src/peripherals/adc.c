@@ -11,6 +11,7 @@
 #include "filter.h"
 #include "lptim.h"
 #include "rcc_reg.h"
+#include "rtc.h"
 
 /*** ADC local macros ***/
 
@@ -21,12 +22,16 @@
 #define ADC_MEDIAN_FILTER_LENGTH			9
 #define ADC_CENTER_AVERGAE_LENGTH			3
 
+#define ADC_DAY_DURATION_MS					86400000
+
 /*** ADC local structures ***/
 
 typedef struct {
 	unsigned int adc_mcu_voltage_mv;
 	unsigned char adc_mcu_temperature_degrees_comp1;
 	signed char adc_mcu_temperature_degrees_comp2;
+	unsigned char adc_measurement_valid;
+	unsigned int adc_measurement_time_ms; // RTC time of day of the last measurement.
 } ADC_Context;
 
 /*** ADC local global variables ***/
@@ -134,6 +139,7 @@ void ADC1_Init(void) {
 	adc_ctx.adc_mcu_voltage_mv = 0;
 	adc_ctx.adc_mcu_temperature_degrees_comp2 = 0;
 	adc_ctx.adc_mcu_temperature_degrees_comp1 = 0;
+	adc_ctx.adc_measurement_valid = 0;
 	// Enable peripheral clock.
 	RCC -> APB2ENR |= (0b1 << 9); // ADCEN='1'.
 	// Ensure ADC is disabled.
@@ -193,6 +199,8 @@ void ADC1_PerformAllMeasurements(void) {
 	// Perform measurements.
 	ADC1_ComputeMcuVoltage();
 	ADC1_ComputeMcuTemperature();
+	adc_ctx.adc_measurement_valid = 1;
+	adc_ctx.adc_measurement_time_ms = RTC_GetTimeOfDayMilliseconds();
 	// Clear all flags.
 	ADC1 -> ISR |= 0x0000089F; // Clear all flags.
 	// Disable ADC peripheral.
@@ -224,3 +232,13 @@ void ADC1_GetMcuTemperatureComp2(signed char* mcu_temperature_degrees) {
 void ADC1_GetMcuTemperatureComp1(unsigned char* mcu_temperature_degrees) {
 	(*mcu_temperature_degrees) = adc_ctx.adc_mcu_temperature_degrees_comp1;
 }
+
+/* GET AGE OF THE LAST MEASUREMENTS.
+ * @param measurement_age_ms:	Pointer to value that will contain the time elapsed since the last measurements in ms.
+ * @return valid:				1 if measurements were performed since ADC init, 0 otherwise.
+ */
+unsigned char ADC1_GetMeasurementAge(unsigned int* measurement_age_ms) {
+	// Handle midnight roll-over.
+	(*measurement_age_ms) = (RTC_GetTimeOfDayMilliseconds() + ADC_DAY_DURATION_MS - adc_ctx.adc_measurement_time_ms) % ADC_DAY_DURATION_MS;
+	return adc_ctx.adc_measurement_valid;
+}
@@ -8,8 +8,13 @@
 #include "aes.h"
 
 #include "aes_reg.h"
+#include "dma.h"
 #include "rcc_reg.h"
 
+/*** AES local macros ***/
+
+#define AES_TIMEOUT_COUNT		1000000
+
 /*** AES functions ***/
 
 /* INIT AES HARDWARE PERIPHERAL.
@@ -36,12 +41,11 @@ void AES_Disable(void) {
 	RCC -> AHBENR &= ~(0b1 << 24); // CRYPTOEN='0'.
 }
 
-/* COMPUTE AES-128 CBC ALGORITHME WITH HARDWARE ACCELERATOR.
- * @param data_in:		Input data (16-bits value).
- * @param init_vector:	Initialisation vector (128-bits value).
- * @param key			AES key (128-bits value).
+/* LOAD AES KEY (PERIPHERAL MUST BE DISABLED).
+ * @param key:	AES key (128-bits value).
+ * @return:		None.
  */
-void AES_EncodeCbc(unsigned char data_in[AES_BLOCK_SIZE], unsigned char data_out[AES_BLOCK_SIZE], unsigned char init_vector[AES_BLOCK_SIZE], unsigned char key[AES_BLOCK_SIZE]) {
+void AES_SetKey(unsigned char key[AES_BLOCK_SIZE]) {
 	// Configure operation.
 	AES -> CR &= ~(0b11 << 3); // MODE='00'.
 	// Fill key.
@@ -53,6 +57,13 @@ void AES_EncodeCbc(unsigned char data_in[AES_BLOCK_SIZE], unsigned char data_out
 	AES -> KEYR1 |= (key[8] << 24) | (key[9] << 16) | (key[10] << 8) | (key[11] << 0);
 	AES -> KEYR0 = 0;
 	AES -> KEYR0 |= (key[12] << 24) | (key[13] << 16) | (key[14] << 8) | (key[15] << 0);
+}
+
+/* LOAD INITIALIZATION VECTOR AND START A NEW CBC CHAIN (PERIPHERAL MUST BE DISABLED).
+ * @param init_vector:	Initialisation vector (128-bits value).
+ * @return:				None.
+ */
+void AES_SetInitVector(unsigned char init_vector[AES_BLOCK_SIZE]) {
 	// Fill initialization vector.
 	AES -> IVR3 = 0;
 	AES -> IVR3 |= (init_vector[0] << 24) | (init_vector[1] << 16) | (init_vector[2] << 8) | (init_vector[3] << 0);
@@ -62,7 +73,15 @@ void AES_EncodeCbc(unsigned char data_in[AES_BLOCK_SIZE], unsigned char data_out
 	AES -> IVR1 |= (init_vector[8] << 24) | (init_vector[9] << 16) | (init_vector[10] << 8) | (init_vector[11] << 0);
 	AES -> IVR0 = 0;
 	AES -> IVR0 |= (init_vector[12] << 24) | (init_vector[13] << 16) | (init_vector[14] << 8) | (init_vector[15] << 0);
-	// Enable peripheral.
+}
+
+/* ENCRYPT ONE BLOCK OF THE CURRENT CBC CHAIN.
+ * @param data_in:		Input data (128-bits value).
+ * @param data_out:		Output data (128-bits value).
+ * @return:				1 in case of success, 0 in case of failure.
+ */
+unsigned char AES_EncodeBlock(unsigned char data_in[AES_BLOCK_SIZE], unsigned char data_out[AES_BLOCK_SIZE]) {
+	// Enable peripheral (kept enabled between blocks so that IV chaining is performed by hardware).
 	AES -> CR |= (0b1 << 0); // EN='1'.
 	// Fill input data (provided most significant 32-bits word first).
 	unsigned char register_idx = 0;
@@ -77,7 +96,12 @@ void AES_EncodeCbc(unsigned char data_in[AES_BLOCK_SIZE], unsigned char data_out
 		AES -> DINR = data_in_32bits;
 	}
 	// Wait for algorithme to complete.
-	while (((AES -> SR) & (0b1 << 0)) == 0); // Wait for CCF='1'.
+	unsigned int loop_count = 0;
+	while (((AES -> SR) & (0b1 << 0)) == 0) {
+		// Wait for CCF='1' or timeout.
+		loop_count++;
+		if (loop_count > AES_TIMEOUT_COUNT) return 0;
+	}
 	// Get result (returned most signifiant 32-bits word first).
 	for (register_idx=0 ; register_idx<4 ; register_idx++) {
 		// Read output data register (most signifiant 32-bits word first).
@@ -88,7 +112,80 @@ void AES_EncodeCbc(unsigned char data_in[AES_BLOCK_SIZE], unsigned char data_out
 		data_out[(register_idx*4)+2] = (data_out_32bits & 0x0000FF00) >> 8;
 		data_out[(register_idx*4)+3] = (data_out_32bits & 0x000000FF) >> 0;
 	}
-	// Reset peripheral.
-	AES -> CR |= (0b1 << 7); // Clear CCF flag for next AES operation.
+	// Clear CCF flag for next block.
+	AES -> CR |= (0b1 << 7);
+	return 1;
+}
+
+/* END CURRENT CBC CHAIN.
+ * @param:	None.
+ * @return:	None.
+ */
+void AES_Stop(void) {
+	// Disable peripheral (key and IV can be loaded again).
 	AES -> CR &= ~(0b1 << 0); // EN='0'.
 }
+
+/* COMPUTE AES-128 CBC ALGORITHME WITH HARDWARE ACCELERATOR.
+ * @param data_in:		Input data (16-bits value).
+ * @param init_vector:	Initialisation vector (128-bits value).
+ * @param key			AES key (128-bits value).
+ */
+void AES_EncodeCbc(unsigned char data_in[AES_BLOCK_SIZE], unsigned char data_out[AES_BLOCK_SIZE], unsigned char init_vector[AES_BLOCK_SIZE], unsigned char key[AES_BLOCK_SIZE]) {
+	// Single block chain.
+	AES_SetKey(key);
+	AES_SetInitVector(init_vector);
+	AES_EncodeBlock(data_in, data_out);
+	AES_Stop();
+}
+
+/* COMPUTE AES-128 CBC ALGORITHME ON A MULTI-BLOCKS BUFFER.
+ * @param data_in:				Input data.
+ * @param data_out:				Output data.
+ * @param number_of_blocks:		Number of blocks to encrypt.
+ * @param init_vector:			Initialisation vector (128-bits value).
+ * @param key:					AES key (128-bits value).
+ * @param transfer:				Requested transfer method (DMA falls back to CPU if one of the buffers is not 32-bits aligned).
+ * @return transfer_done:		Transfer method effectively used or AES_TRANSFER_ERROR if output data is not valid.
+ */
+AES_Transfer AES_EncodeCbcBuffer(unsigned char* data_in, unsigned char* data_out, unsigned char number_of_blocks, unsigned char init_vector[AES_BLOCK_SIZE], unsigned char key[AES_BLOCK_SIZE], AES_Transfer transfer) {
+	// Local variables.
+	unsigned char block_idx = 0;
+	unsigned int loop_count = 0;
+	DMA_Status dma_status = DMA_STATUS_RUNNING;
+	// Load key and IV once for the whole buffer.
+	AES_SetKey(key);
+	AES_SetInitVector(init_vector);
+	// DMA transfers are 32-bits wide.
+	if ((transfer == AES_TRANSFER_DMA) && ((((unsigned int) data_in) & 0x3) == 0) && ((((unsigned int) data_out) & 0x3) == 0)) {
+		// Swap bytes of each word so that buffers are streamed most significant byte first.
+		AES -> CR |= (0b10 << 1); // DATATYPE='10'.
+		// Configure and start DMA (output channel must be ready before peripheral is enabled).
+		DMA1_InitChannels1_2();
+		DMA1_StartChannels1_2((unsigned int) data_in, (unsigned int) data_out, (number_of_blocks * (AES_BLOCK_SIZE / 4)));
+		AES -> CR |= (0b1 << 12) | (0b1 << 11); // DMAOUTEN='1' and DMAINEN='1'.
+		AES -> CR |= (0b1 << 0); // EN='1'.
+		// Poll transfer status until the last word is read (a block takes about 200 cycles, sleeping would not save anything
+		// and SysTick can not bound the wait since callers use it to count encryption cycles).
+		while (dma_status == DMA_STATUS_RUNNING) {
+			dma_status = DMA1_GetChannels1_2Status();
+			// Exit on transfer error or timeout.
+			loop_count++;
+			if (loop_count > AES_TIMEOUT_COUNT) break;
+		}
+		// Release DMA.
+		AES -> CR &= ~(0b11 << 11); // DMAOUTEN='0' and DMAINEN='0'.
+		DMA1_StopChannels1_2();
+		DMA1_Disable();
+		AES -> CR |= (0b1 << 7); // Clear CCF flag.
+		AES -> CR &= ~(0b11 << 1); // DATATYPE='00'.
+		AES_Stop();
+		return ((dma_status == DMA_STATUS_COMPLETE) ? AES_TRANSFER_DMA : AES_TRANSFER_ERROR);
+	}
+	// Blocks are written and read by CPU.
+	for (block_idx=0 ; block_idx<number_of_blocks ; block_idx++) {
+		if (AES_EncodeBlock(&(data_in[block_idx * AES_BLOCK_SIZE]), &(data_out[block_idx * AES_BLOCK_SIZE])) == 0) break;
+	}
+	AES_Stop();
+	return ((block_idx == number_of_blocks) ? AES_TRANSFER_CPU : AES_TRANSFER_ERROR);
+}
@@ -7,14 +7,57 @@
 
 #include "dma.h"
 
+#include "aes_reg.h"
 #include "dma_reg.h"
 #include "lpuart_reg.h"
 #include "neom8n.h"
 #include "nvic.h"
 #include "rcc_reg.h"
+#include "spi_reg.h"
+
+/*** DMA local global variables ***/
+
+static volatile DMA_Status dma1_channels_status = DMA_STATUS_RUNNING; // Status of the SPI1 or AES transfer.
 
 /*** DMA local functions ***/
 
+/* DMA1 CHANNEL 1 INTERRUPT HANDLER.
+ * @param:	None.
+ * @return:	None.
+ */
+void __attribute__((optimize("-O0"))) DMA1_Channel1_IRQHandler(void) {
+	// Transfer error interrupt (TEIF1='1', channel is disabled by hardware).
+	if (((DMA1 -> ISR) & (0b1 << 3)) != 0) {
+		// Update status.
+		dma1_channels_status = DMA_STATUS_ERROR;
+		// Clear flag.
+		DMA1 -> IFCR |= (0b1 << 3); // CTEIF1='1'.
+	}
+}
+
+/* DMA1 CHANNELS 2 AND 3 INTERRUPT HANDLER.
+ * @param:	None.
+ * @return:	None.
+ */
+void __attribute__((optimize("-O0"))) DMA1_Channel2_3_IRQHandler(void) {
+	// Transfer error interrupt (TEIF2='1' or TEIF3='1', channel is disabled by hardware).
+	if (((DMA1 -> ISR) & ((0b1 << 11) | (0b1 << 7))) != 0) {
+		// Update status.
+		dma1_channels_status = DMA_STATUS_ERROR;
+		// Clear flags.
+		DMA1 -> IFCR |= (0b1 << 11) | (0b1 << 7); // CTEIF3='1' and CTEIF2='1'.
+	}
+	// Transfer complete interrupt (TCIF2='1').
+	if (((DMA1 -> ISR) & (0b1 << 5)) != 0) {
+		// Update status (an error on the other channel is kept).
+		if (dma1_channels_status == DMA_STATUS_RUNNING) {
+			dma1_channels_status = DMA_STATUS_COMPLETE;
+		}
+		// Clear flag.
+		DMA1 -> IFCR |= (0b1 << 5); // CTCIF2='1'.
+	}
+}
+
 /* DMA1 CHANNEL 6 INTERRUPT HANDLER.
  * @param:	None.
  * @return:	None.
@@ -97,16 +140,178 @@ void DMA1_SetChannel6DestAddr(unsigned int dest_buf_addr, unsigned short dest_bu
 	DMA1 -> IFCR |= 0x00F00000;
 }
 
-/* DISABLE DMA1 PERIPHERAL.
+/* CONFIGURE DMA1 CHANNELS 2 AND 3 FOR SPI1 RX AND TX TRANSFERS.
  * @param:	None.
  * @return:	None.
  */
-void DMA1_Disable(void) {
-	// Disable interrupts.
+void DMA1_InitChannels2_3(void) {
+	// Enable peripheral clock.
+	RCC -> AHBENR |= (0b1 << 0); // DMAEN='1'.
+	// Channel 2 = SPI1 RX (read from peripheral, DIR='0').
+	// Memory and peripheral data size are 8 bits (MSIZE='00' and PSIZE='00').
+	DMA1 -> CCR2 &= 0xFFFF8000; // Disable channel and reset configuration.
+	DMA1 -> CCR2 |= (0b10 << 12); // High priority (PL='10').
+	DMA1 -> CCR2 |= (0b1 << 3) | (0b1 << 1); // Enable transfer error and transfer complete interrupts (TEIE='1' and TCIE='1').
+	DMA1 -> CPAR2 = (unsigned int) &(SPI1 -> DR);
+	// Channel 3 = SPI1 TX.
+	DMA1 -> CCR3 &= 0xFFFF8000; // Disable channel and reset configuration.
+	DMA1 -> CCR3 |= (0b10 << 12); // High priority (PL='10').
+	DMA1 -> CCR3 |= (0b1 << 4); // Read from memory (DIR='1').
+	DMA1 -> CCR3 |= (0b1 << 3); // Enable transfer error interrupt (TEIE='1').
+	DMA1 -> CPAR3 = (unsigned int) &(SPI1 -> DR);
+	// Map channels on SPI1 (request number 1).
+	DMA1 -> CSELR &= ~(0b11111111 << 4); // Reset bits 4-11.
+	DMA1 -> CSELR |= (0b0001 << 8) | (0b0001 << 4); // C3S='0001' and C2S='0001'.
+	// Clear all flags.
+	DMA1 -> IFCR |= 0x00000FF0;
+	// Set interrupt priority.
+	NVIC_SetPriority(NVIC_IT_DMA1_CH_2_3, 1);
+}
+
+/* START DMA1 CHANNELS 2 AND 3 TRANSFER.
+ * @param tx_buf_addr:	Address of the bytes to send (memory increment is disabled if increment_tx is 0).
+ * @param increment_tx:	Send consecutive bytes (1) or always the same byte (0).
+ * @param rx_buf_addr:	Address of the buffer that will contain the received bytes.
+ * @param increment_rx:	Store received bytes consecutively (1) or always at the same address (0).
+ * @param size:			Number of bytes to transfer.
+ * @return:				None.
+ */
+void DMA1_StartChannels2_3(unsigned int tx_buf_addr, unsigned char increment_tx, unsigned int rx_buf_addr, unsigned char increment_rx, unsigned short size) {
+	// Configure memory increment mode.
+	if (increment_tx != 0) {
+		DMA1 -> CCR3 |= (0b1 << 7); // MINC='1'.
+	}
+	else {
+		DMA1 -> CCR3 &= ~(0b1 << 7); // MINC='0'.
+	}
+	if (increment_rx != 0) {
+		DMA1 -> CCR2 |= (0b1 << 7); // MINC='1'.
+	}
+	else {
+		DMA1 -> CCR2 &= ~(0b1 << 7); // MINC='0'.
+	}
+	// Set addresses and size.
+	DMA1 -> CMAR2 = rx_buf_addr;
+	DMA1 -> CNDTR2 = size;
+	DMA1 -> CMAR3 = tx_buf_addr;
+	DMA1 -> CNDTR3 = size;
+	// Clear all flags.
+	DMA1 -> IFCR |= 0x00000FF0;
+	dma1_channels_status = DMA_STATUS_RUNNING;
+	NVIC_EnableInterrupt(NVIC_IT_DMA1_CH_2_3);
+	// Start transfer (RX channel first).
+	DMA1 -> CCR2 |= (0b1 << 0); // EN='1'.
+	DMA1 -> CCR3 |= (0b1 << 0); // EN='1'.
+}
+
+/* GET DMA1 CHANNELS 2 AND 3 TRANSFER STATUS.
+ * @param:			None.
+ * @return status:	DMA_STATUS_COMPLETE once the last byte has been received, DMA_STATUS_ERROR in case of bus error.
+ */
+DMA_Status DMA1_GetChannels2_3Status(void) {
+	return dma1_channels_status;
+}
+
+/* STOP DMA1 CHANNELS 2 AND 3 TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_StopChannels2_3(void) {
+	// Stop transfer.
+	DMA1 -> CCR3 &= ~(0b1 << 0); // EN='0'.
+	DMA1 -> CCR2 &= ~(0b1 << 0); // EN='0'.
 	NVIC_DisableInterrupt(NVIC_IT_DMA1_CH_2_3);
-	NVIC_DisableInterrupt(NVIC_IT_DMA1_CH_4_7);
+}
+
+/* CONFIGURE DMA1 CHANNELS 1 AND 2 FOR AES INPUT AND OUTPUT TRANSFERS.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_InitChannels1_2(void) {
+	// Enable peripheral clock.
+	RCC -> AHBENR |= (0b1 << 0); // DMAEN='1'.
+	// Channel 1 = AES IN (read from memory, DIR='1').
+	// Memory and peripheral data size are 32 bits (MSIZE='10' and PSIZE='10').
+	DMA1 -> CCR1 &= 0xFFFF8000; // Disable channel and reset configuration.
+	DMA1 -> CCR1 |= (0b10 << 12); // High priority (PL='10').
+	DMA1 -> CCR1 |= (0b10 << 10) | (0b10 << 8); // MSIZE='10' and PSIZE='10'.
+	DMA1 -> CCR1 |= (0b1 << 7); // Memory increment mode enabled (MINC='1').
+	DMA1 -> CCR1 |= (0b1 << 4); // Read from memory (DIR='1').
+	DMA1 -> CCR1 |= (0b1 << 3); // Enable transfer error interrupt (TEIE='1').
+	DMA1 -> CPAR1 = (unsigned int) &(AES -> DINR);
+	// Channel 2 = AES OUT (read from peripheral, DIR='0').
+	DMA1 -> CCR2 &= 0xFFFF8000; // Disable channel and reset configuration.
+	DMA1 -> CCR2 |= (0b10 << 12); // High priority (PL='10').
+	DMA1 -> CCR2 |= (0b10 << 10) | (0b10 << 8); // MSIZE='10' and PSIZE='10'.
+	DMA1 -> CCR2 |= (0b1 << 7); // Memory increment mode enabled (MINC='1').
+	DMA1 -> CCR2 |= (0b1 << 3) | (0b1 << 1); // Enable transfer error and transfer complete interrupts (TEIE='1' and TCIE='1').
+	DMA1 -> CPAR2 = (unsigned int) &(AES -> DOUTR);
+	// Map channels on AES (request number 11).
+	DMA1 -> CSELR &= ~(0b11111111 << 0); // Reset bits 0-7.
+	DMA1 -> CSELR |= (0b1011 << 4) | (0b1011 << 0); // C2S='1011' and C1S='1011'.
+	// Clear all flags.
+	DMA1 -> IFCR |= 0x000000FF;
+	// Set interrupt priority.
+	NVIC_SetPriority(NVIC_IT_DMA1_CHA1, 1);
+	NVIC_SetPriority(NVIC_IT_DMA1_CH_2_3, 1);
+}
+
+/* START DMA1 CHANNELS 1 AND 2 TRANSFER.
+ * @param in_buf_addr:		Address of the words to encrypt (must be 32-bits aligned).
+ * @param out_buf_addr:		Address of the buffer that will contain the encrypted words (must be 32-bits aligned).
+ * @param number_of_words:	Number of 32-bits words to transfer.
+ * @return:					None.
+ */
+void DMA1_StartChannels1_2(unsigned int in_buf_addr, unsigned int out_buf_addr, unsigned short number_of_words) {
+	// Set addresses and size.
+	DMA1 -> CMAR1 = in_buf_addr;
+	DMA1 -> CNDTR1 = number_of_words;
+	DMA1 -> CMAR2 = out_buf_addr;
+	DMA1 -> CNDTR2 = number_of_words;
 	// Clear all flags.
-	DMA1 -> IFCR |= 0x0FFFFFFF;
-	// Disable peripheral clock.
-	RCC -> AHBENR &= ~(0b1 << 0); // DMAEN='0'.
+	DMA1 -> IFCR |= 0x000000FF;
+	dma1_channels_status = DMA_STATUS_RUNNING;
+	NVIC_EnableInterrupt(NVIC_IT_DMA1_CHA1);
+	NVIC_EnableInterrupt(NVIC_IT_DMA1_CH_2_3);
+	// Start transfer (output channel first).
+	DMA1 -> CCR2 |= (0b1 << 0); // EN='1'.
+	DMA1 -> CCR1 |= (0b1 << 0); // EN='1'.
+}
+
+/* GET DMA1 CHANNELS 1 AND 2 TRANSFER STATUS.
+ * @param:			None.
+ * @return status:	DMA_STATUS_COMPLETE once the last word has been read from the AES peripheral, DMA_STATUS_ERROR in case of bus error.
+ */
+DMA_Status DMA1_GetChannels1_2Status(void) {
+	return dma1_channels_status;
+}
+
+/* STOP DMA1 CHANNELS 1 AND 2 TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_StopChannels1_2(void) {
+	// Stop transfer.
+	DMA1 -> CCR1 &= ~(0b1 << 0); // EN='0'.
+	DMA1 -> CCR2 &= ~(0b1 << 0); // EN='0'.
+	NVIC_DisableInterrupt(NVIC_IT_DMA1_CHA1);
+	NVIC_DisableInterrupt(NVIC_IT_DMA1_CH_2_3);
+}
+
+/* DISABLE DMA1 PERIPHERAL.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_Disable(void) {
+	// Keep peripheral on while a channel is still running (GPS, SPI1 and AES transfers are independent).
+	if ((((DMA1 -> CCR1) | (DMA1 -> CCR2) | (DMA1 -> CCR3) | (DMA1 -> CCR6)) & (0b1 << 0)) == 0) {
+		// Disable interrupts.
+		NVIC_DisableInterrupt(NVIC_IT_DMA1_CHA1);
+		NVIC_DisableInterrupt(NVIC_IT_DMA1_CH_2_3);
+		NVIC_DisableInterrupt(NVIC_IT_DMA1_CH_4_7);
+		// Clear all flags.
+		DMA1 -> IFCR |= 0x0FFFFFFF;
+		// Disable peripheral clock.
+		RCC -> AHBENR &= ~(0b1 << 0); // DMAEN='0'.
+	}
 }
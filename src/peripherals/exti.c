@@ -12,6 +12,7 @@
 #include "nvic.h"
 #include "rcc_reg.h"
 #include "rain.h"
+#include "sx1232.h"
 #include "syscfg_reg.h"
 #include "wind.h"
 
@@ -26,7 +27,26 @@
  * @return:	None.
  */
 void __attribute__((optimize("-O0"))) EXTI0_1_IRQHandler(void) {
-	// Unused.
+#ifdef HW2_0
+	// SX1232 DIO0 interrupt.
+	if (((EXTI -> PR) & (0b1 << (GPIO_SX1232_DIO0.gpio_num))) != 0) {
+		// Manage callback.
+		if (((EXTI -> IMR) & (0b1 << (GPIO_SX1232_DIO0.gpio_num))) != 0) {
+			SX1232_Dio0EdgeCallback();
+		}
+		// Clear flag.
+		EXTI -> PR |= (0b1 << (GPIO_SX1232_DIO0.gpio_num)); // PIFx='1' (writing '1' clears the bit).
+	}
+	// SX1232 DIO2 interrupt.
+	if (((EXTI -> PR) & (0b1 << (GPIO_SX1232_DIO2.gpio_num))) != 0) {
+		// Manage callback.
+		if (((EXTI -> IMR) & (0b1 << (GPIO_SX1232_DIO2.gpio_num))) != 0) {
+			SX1232_Dio2EdgeCallback();
+		}
+		// Clear flag.
+		EXTI -> PR |= (0b1 << (GPIO_SX1232_DIO2.gpio_num)); // PIFx='1' (writing '1' clears the bit).
+	}
+#endif
 }
 
 /* EXTI LINES 2-3 INTERRUPT HANDLER.
@@ -34,7 +54,17 @@ void __attribute__((optimize("-O0"))) EXTI0_1_IRQHandler(void) {
  * @return:	None.
  */
 void __attribute__((optimize("-O0"))) EXTI2_3_IRQHandler(void) {
-	// Unused.
+#ifdef HW1_0
+	// SX1232 DIO0 interrupt.
+	if (((EXTI -> PR) & (0b1 << (GPIO_SX1232_DIO0.gpio_num))) != 0) {
+		// Manage callback.
+		if (((EXTI -> IMR) & (0b1 << (GPIO_SX1232_DIO0.gpio_num))) != 0) {
+			SX1232_Dio0EdgeCallback();
+		}
+		// Clear flag.
+		EXTI -> PR |= (0b1 << (GPIO_SX1232_DIO0.gpio_num)); // PIFx='1' (writing '1' clears the bit).
+	}
+#endif
 }
 
 /* EXTI LINES 4-15 INTERRUPT HANDLER.
@@ -42,6 +72,17 @@ void __attribute__((optimize("-O0"))) EXTI2_3_IRQHandler(void) {
  * @return:	None.
  */
 void __attribute__((optimize("-O0"))) EXTI4_15_IRQHandler(void) {
+#ifdef HW1_0
+	// SX1232 DIO2 interrupt.
+	if (((EXTI -> PR) & (0b1 << (GPIO_SX1232_DIO2.gpio_num))) != 0) {
+		// Manage callback.
+		if (((EXTI -> IMR) & (0b1 << (GPIO_SX1232_DIO2.gpio_num))) != 0) {
+			SX1232_Dio2EdgeCallback();
+		}
+		// Clear flag.
+		EXTI -> PR |= (0b1 << (GPIO_SX1232_DIO2.gpio_num)); // PIFx='1' (writing '1' clears the bit).
+	}
+#endif
 #if (defined CM || defined ATM)
 	// Speed edge interrupt.
 	if (((EXTI -> PR) & (0b1 << (GPIO_WIND_SPEED.gpio_num))) != 0) {
@@ -90,6 +131,7 @@ void EXTI_Init(void) {
 	EXTI -> PR |= 0x007BFFFF; // PIFx='1'.
 	// Set interrupts priority.
 	NVIC_SetPriority(NVIC_IT_EXTI_0_1, 3);
+	NVIC_SetPriority(NVIC_IT_EXTI_2_3, 3);
 	NVIC_SetPriority(NVIC_IT_EXTI_4_15, 0);
 }
 
@@ -133,6 +175,19 @@ void EXTI_ConfigureGpio(const GPIO* gpio, EXTI_Trigger edge_trigger) {
 	EXTI -> PR |= (0b1 << ((gpio -> gpio_num)));
 }
 
+/* DISABLE EXTERNAL INTERRUPT OF A GPIO.
+ * @param gpio:		GPIO to be detached from EXTI peripheral.
+ * @return:			None.
+ */
+void EXTI_DisableGpio(const GPIO* gpio) {
+	// Mask line and disable triggers.
+	EXTI -> IMR &= ~(0b1 << ((gpio -> gpio_num))); // IMx='0'.
+	EXTI -> RTSR &= ~(0b1 << ((gpio -> gpio_num))); // Rising edge disabled.
+	EXTI -> FTSR &= ~(0b1 << ((gpio -> gpio_num))); // Falling edge disabled.
+	// Clear flag.
+	EXTI -> PR |= (0b1 << ((gpio -> gpio_num)));
+}
+
 /* CONFIGURE A LINE AS INTERNAL INTERRUPT SOURCE.
  * @param line:		Line to configure (see EXTI_Line enum).
  * @edge_trigger:	Interrupt edge trigger (see EXTI_Trigger enum).
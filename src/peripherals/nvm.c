@@ -7,9 +7,124 @@
 
 #include "nvm.h"
 
+#include "airtime.h"
 #include "flash_reg.h"
 #include "rcc_reg.h"
 
+/*** NVM local macros ***/
+
+// Journal record format (two 32-bits words): | FIELD_ID (4) | SEQUENCE (4) | VALUE (16) | CRC8 (8) | followed by the commit word | CRC16 (16) | ~CRC16 (16) |.
+// The commit word is programmed after the data word and its CRC16 covers the 4 bytes of the data word: a torn data word
+// must match both the CRC8 and the commit word left by the previous record, a torn commit word must match a 32-bits pattern.
+#define NVM_JOURNAL_FIELD_ID_SHIFT			28
+#define NVM_JOURNAL_SEQUENCE_SHIFT			24
+#define NVM_JOURNAL_SEQUENCE_MASK			0x0F
+#define NVM_JOURNAL_VALUE_SHIFT				8
+#define NVM_JOURNAL_COMMIT_OFFSET_BYTES		4
+#define NVM_JOURNAL_RECORD_INDEX_NONE		0xFFFF
+// Number of oldest records which must never contain the last value of a field.
+#define NVM_JOURNAL_RESERVED_RECORDS		(NVM_JOURNAL_FIELD_LAST + 1)
+#define NVM_CRC8_POLYNOMIAL					0x07
+#define NVM_LEGACY_ADDRESS_OFFSET_NONE		0xFF // Field created after the fixed address layout (imported with its default value).
+// Records.
+#define NVM_RECORD_VERSION					0x01
+#define NVM_RECORD_COPY_INDEX_NONE			0xFF
+#define NVM_RECORD_DATA_MAX_SIZE_BYTES		12
+#define NVM_CRC16_POLYNOMIAL				0x1021
+// Backlog.
+#define NVM_BACKLOG_STATUS_PENDING			0xA5
+#define NVM_BACKLOG_STATUS_SENT				0x5A
+#define NVM_BACKLOG_ENTRY_INDEX_NONE		0xFF
+
+#if (NVM_BACKLOG_END_ADDRESS_OFFSET > EEPROM_SIZE)
+#error "NVM backlog exceeds EEPROM size."
+#endif
+
+/*** NVM local structures ***/
+
+typedef enum {
+	NVM_JOURNAL_FIELD_DAY_COUNT,
+	NVM_JOURNAL_FIELD_HOURS_COUNT,
+	NVM_JOURNAL_FIELD_MONITORING_STATUS_BYTE,
+	NVM_JOURNAL_FIELD_RTC_PWKUP_YEAR,
+	NVM_JOURNAL_FIELD_RTC_PWKUP_MONTH,
+	NVM_JOURNAL_FIELD_RTC_PWKUP_DATE,
+	NVM_JOURNAL_FIELD_RTC_PWKUP_HOURS,
+	NVM_JOURNAL_FIELD_TX_POWER_BACKOFF,
+	NVM_JOURNAL_FIELD_AIRTIME_WINDOW,
+	NVM_JOURNAL_FIELD_LAST
+} NVM_JournalField;
+
+typedef enum {
+	NVM_STORAGE_CONFIG_RECORD,
+	NVM_STORAGE_JOURNAL
+} NVM_Storage;
+
+typedef struct {
+	NVM_Storage nvm_storage;
+	unsigned char nvm_index; // Byte index in configuration record or journal field.
+	unsigned char nvm_legacy_address_offset; // Fixed address used before record or journal creation.
+	unsigned char nvm_width_bytes; // 1 or 2 (big-endian).
+	unsigned short nvm_default_value;
+	unsigned short nvm_min_value;
+	unsigned short nvm_max_value;
+} NVM_FieldDescriptor;
+
+typedef struct {
+	unsigned short nvm_address_offset; // Address of the first copy.
+	unsigned char nvm_size_bytes; // Data size (multiple of 4).
+	unsigned char nvm_number_of_copies;
+	unsigned char nvm_legacy_address_offset; // Fixed address used before record creation.
+	unsigned char nvm_legacy_size_bytes;
+} NVM_RecordDescriptor;
+
+typedef struct {
+	unsigned short nvm_journal_value[NVM_JOURNAL_FIELD_LAST]; // RAM copy of the last value of each field.
+	unsigned short nvm_journal_record_idx[NVM_JOURNAL_FIELD_LAST]; // Record holding the last value of each field.
+	unsigned short nvm_journal_head_idx; // Next record to be written.
+	unsigned char nvm_journal_sequence; // Sequence number of the next record.
+	unsigned char nvm_record_copy_idx[NVM_RECORD_LAST]; // Copy holding the last valid data of each record.
+	unsigned char nvm_record_sequence[NVM_RECORD_LAST]; // Sequence number of the last valid copy.
+	unsigned char nvm_record_data[NVM_RECORD_LAST][NVM_RECORD_DATA_MAX_SIZE_BYTES]; // RAM copy of the last valid copy.
+	unsigned char nvm_sigfox_id[NVM_SIGFOX_ID_LENGTH_BYTES];
+	unsigned char nvm_sigfox_key[NVM_SIGFOX_KEY_LENGTH_BYTES];
+	unsigned char nvm_backlog_head_idx; // Next entry to be written.
+	unsigned char nvm_backlog_sequence; // Sequence number of the next entry.
+	unsigned char nvm_backlog_count; // Number of pending entries.
+	unsigned int nvm_program_count[NVM_AREA_LAST]; // Number of program operations since start-up.
+} NVM_Context;
+
+/*** NVM local global variables ***/
+
+static const NVM_FieldDescriptor nvm_fields[NVM_FIELD_LAST] = {
+	// Device configuration (mapped on downlink frame).
+	{NVM_STORAGE_CONFIG_RECORD, 0, NVM_CONFIG_LOCAL_UTC_OFFSET_ADDRESS_OFFSET, 1, 0x01, 0x00, 0xFF},
+	{NVM_STORAGE_CONFIG_RECORD, 1, NVM_CONFIG_UPLINK_FRAMES_ADDRESS_OFFSET, 1, 0x00, 0x00, 0xFF},
+	{NVM_STORAGE_CONFIG_RECORD, 2, NVM_CONFIG_GPS_TIMEOUT_ADDRESS_OFFSET, 1, 0x78, 0x00, 0xFF},
+	// Uplink slot spreading window in minutes and per-hour jitter in seconds.
+	{NVM_STORAGE_CONFIG_RECORD, 3, NVM_LEGACY_ADDRESS_OFFSET_NONE, 1, 30, 1, 50},
+	{NVM_STORAGE_CONFIG_RECORD, 4, NVM_LEGACY_ADDRESS_OFFSET_NONE, 1, 0x00, 0x00, 0xFF},
+	// Period management and status.
+	{NVM_STORAGE_JOURNAL, NVM_JOURNAL_FIELD_DAY_COUNT, NVM_DAY_COUNT_ADDRESS_OFFSET, 1, 0x01, 0x00, 0xFF},
+	{NVM_STORAGE_JOURNAL, NVM_JOURNAL_FIELD_HOURS_COUNT, NVM_HOURS_COUNT_ADDRESS_OFFSET, 1, 0x01, 0x00, 0xFF},
+	{NVM_STORAGE_JOURNAL, NVM_JOURNAL_FIELD_MONITORING_STATUS_BYTE, NVM_MONITORING_STATUS_BYTE_ADDRESS_OFFSET, 1, 0x00, 0x00, 0xFF},
+	// RTC (0 means no previous wake-up).
+	{NVM_STORAGE_JOURNAL, NVM_JOURNAL_FIELD_RTC_PWKUP_YEAR, NVM_RTC_PWKUP_YEAR_ADDRESS_OFFSET, 2, 0, 0, 2099},
+	{NVM_STORAGE_JOURNAL, NVM_JOURNAL_FIELD_RTC_PWKUP_MONTH, NVM_RTC_PWKUP_MONTH_ADDRESS_OFFSET, 1, 0, 0, 12},
+	{NVM_STORAGE_JOURNAL, NVM_JOURNAL_FIELD_RTC_PWKUP_DATE, NVM_RTC_PWKUP_DATE_ADDRESS_OFFSET, 1, 0, 0, 31},
+	{NVM_STORAGE_JOURNAL, NVM_JOURNAL_FIELD_RTC_PWKUP_HOURS, NVM_RTC_PWKUP_HOURS_ADDRESS_OFFSET, 1, 0, 0, 23},
+	// Radio (uplink output power reduction in dB, 0 means maximum power).
+	{NVM_STORAGE_JOURNAL, NVM_JOURNAL_FIELD_TX_POWER_BACKOFF, NVM_TX_POWER_BACKOFF_ADDRESS_OFFSET, 1, 0, 0, NVM_TX_POWER_BACKOFF_MAX_DB},
+	// Airtime of the last hour in ms (duty cycle ledger checkpoint).
+	{NVM_STORAGE_JOURNAL, NVM_JOURNAL_FIELD_AIRTIME_WINDOW, NVM_LEGACY_ADDRESS_OFFSET_NONE, 2, 0, 0, AIRTIME_WINDOW_BUDGET_MS}
+};
+static const NVM_RecordDescriptor nvm_records[NVM_RECORD_LAST] = {
+	{NVM_RECORD_CONFIG_ADDRESS_OFFSET, NVM_RECORD_CONFIG_SIZE_BYTES, NVM_RECORD_CONFIG_NUMBER_OF_COPIES, NVM_CONFIG_START_ADDRESS_OFFSET, (NVM_DAY_COUNT_ADDRESS_OFFSET - NVM_CONFIG_START_ADDRESS_OFFSET)},
+	{NVM_RECORD_SIGFOX_ADDRESS_OFFSET, NVM_RECORD_SIGFOX_SIZE_BYTES, NVM_RECORD_SIGFOX_NUMBER_OF_COPIES, NVM_SIGFOX_PN_ADDRESS_OFFSET, (NVM_CONFIG_START_ADDRESS_OFFSET - NVM_SIGFOX_PN_ADDRESS_OFFSET)},
+	{NVM_RECORD_LINK_ADDRESS_OFFSET, NVM_RECORD_LINK_SIZE_BYTES, NVM_RECORD_LINK_NUMBER_OF_COPIES, 0, 0}
+};
+static NVM_Context nvm_ctx;
+
 /*** NVM local functions ***/
 
 /* UNLOCK NVM.
@@ -38,6 +153,425 @@ static void NVM_Lock(void) {
 	FLASH -> PECR |= (0b1 << 0); // PELOCK='1'.
 }
 
+/* GET THE EEPROM AREA OF AN ADDRESS.
+ * @param address_offset:	Address offset starting from NVM start address (expressed in bytes).
+ * @return area:			Area containing the address.
+ */
+static NVM_Area NVM_GetArea(unsigned short address_offset) {
+	NVM_Area area = NVM_AREA_FIXED;
+	if (address_offset >= NVM_BACKLOG_ADDRESS_OFFSET) {
+		area = NVM_AREA_BACKLOG;
+	}
+	else if (address_offset >= NVM_JOURNAL_END_ADDRESS_OFFSET) {
+		area = NVM_AREA_RECORDS;
+	}
+	else if (address_offset >= NVM_JOURNAL_START_ADDRESS_OFFSET) {
+		area = NVM_AREA_JOURNAL;
+	}
+	return area;
+}
+
+/* READ A WORD STORED IN NVM.
+ * @param address_offset:	Address offset starting from NVM start address (expressed in bytes, must be a multiple of 4).
+ * @return word:			Word read at requested address (0 if out of range).
+ */
+static unsigned int NVM_ReadWord(unsigned short address_offset) {
+	unsigned int word = 0;
+	// Check if address is in EEPROM range (read access does not require unlock).
+	if ((address_offset + 3) < EEPROM_SIZE) {
+		word = *((unsigned int*) (EEPROM_START_ADDRESS+address_offset)); // Read word at requested address.
+	}
+	return word;
+}
+
+/* WRITE A WORD TO NVM.
+ * @param address_offset:	Address offset starting from NVM start address (expressed in bytes, must be a multiple of 4).
+ * @param word_to_store:	Word to store in NVM (single program operation).
+ * @return:					None.
+ */
+static void NVM_WriteWord(unsigned short address_offset, unsigned int word_to_store) {
+	// Unlock NVM.
+	NVM_Unlock();
+	// Check if address is in EEPROM range.
+	if ((address_offset + 3) < EEPROM_SIZE) {
+		(*((unsigned int*) (EEPROM_START_ADDRESS+address_offset))) = word_to_store; // Write word to requested address.
+		nvm_ctx.nvm_program_count[NVM_GetArea(address_offset)]++;
+	}
+	// Wait end of operation.
+	while (((FLASH -> SR) & (0b1 << 0)) != 0); // Wait till BSY='1'.
+	// Lock NVM.
+	NVM_Lock();
+}
+
+/* COMPUTE CRC8 OF A BYTE ARRAY.
+ * @param data:		Bytes to process.
+ * @param length:	Number of bytes.
+ * @return crc:		CRC8 (polynomial x^8+x^2+x+1, initial value 0xFF).
+ */
+static unsigned char NVM_ComputeCrc8(unsigned char* data, unsigned char length) {
+	unsigned char crc = 0xFF;
+	unsigned char byte_idx = 0;
+	unsigned char bit_idx = 0;
+	for (byte_idx=0 ; byte_idx<length ; byte_idx++) {
+		crc ^= data[byte_idx];
+		for (bit_idx=0 ; bit_idx<8 ; bit_idx++) {
+			crc = (crc & 0x80) ? ((crc << 1) ^ NVM_CRC8_POLYNOMIAL) : (crc << 1);
+		}
+	}
+	return crc;
+}
+
+/* COMPUTE CRC16 OF A BYTE ARRAY.
+ * @param crc:		Initial value (0xFFFF to start a new computation).
+ * @param data:		Bytes to process.
+ * @param length:	Number of bytes.
+ * @return crc:		CRC16 (CCITT polynomial x^16+x^12+x^5+1).
+ */
+static unsigned short NVM_ComputeCrc16(unsigned short crc, unsigned char* data, unsigned char length) {
+	unsigned char byte_idx = 0;
+	unsigned char bit_idx = 0;
+	for (byte_idx=0 ; byte_idx<length ; byte_idx++) {
+		crc ^= (data[byte_idx] << 8);
+		for (bit_idx=0 ; bit_idx<8 ; bit_idx++) {
+			crc = (crc & 0x8000) ? ((crc << 1) ^ NVM_CRC16_POLYNOMIAL) : (crc << 1);
+		}
+	}
+	return crc;
+}
+
+/* BUILD A JOURNAL RECORD.
+ * @param field:	Field index.
+ * @param sequence:	Record sequence number.
+ * @param value:	Field value.
+ * @return record:	Journal record word.
+ */
+static unsigned int NVM_JournalEncode(unsigned char field, unsigned char sequence, unsigned short value) {
+	unsigned char header[3];
+	// Field ID 0 is reserved to detect blank records.
+	header[0] = ((field + 1) << 4) | (sequence & NVM_JOURNAL_SEQUENCE_MASK);
+	header[1] = (value >> 8) & 0xFF;
+	header[2] = (value >> 0) & 0xFF;
+	return ((((unsigned int) header[0]) << NVM_JOURNAL_SEQUENCE_SHIFT) | (((unsigned int) value) << NVM_JOURNAL_VALUE_SHIFT) | NVM_ComputeCrc8(header, 3));
+}
+
+/* BUILD THE COMMIT WORD OF A JOURNAL RECORD.
+ * @param record:	Journal record word.
+ * @return commit:	Commit word.
+ */
+static unsigned int NVM_JournalEncodeCommit(unsigned int record) {
+	unsigned char record_bytes[4];
+	unsigned short crc = 0;
+	record_bytes[0] = (record >> 24) & 0xFF;
+	record_bytes[1] = (record >> 16) & 0xFF;
+	record_bytes[2] = (record >> 8) & 0xFF;
+	record_bytes[3] = (record >> 0) & 0xFF;
+	crc = NVM_ComputeCrc16(0xFFFF, record_bytes, 4);
+	return ((((unsigned int) crc) << 16) | ((~crc) & 0xFFFF));
+}
+
+/* CHECK AND PARSE A JOURNAL RECORD.
+ * @param record:	Journal record word.
+ * @param commit:	Journal commit word.
+ * @param field:	Pointer to byte that will contain the field index.
+ * @param sequence:	Pointer to byte that will contain the record sequence number.
+ * @param value:	Pointer to short that will contain the field value.
+ * @return valid:	1 if the record is valid (blank or partially written records are rejected), 0 otherwise.
+ */
+static unsigned char NVM_JournalDecode(unsigned int record, unsigned int commit, unsigned char* field, unsigned char* sequence, unsigned short* value) {
+	unsigned char header[3];
+	unsigned char field_id = (record >> NVM_JOURNAL_FIELD_ID_SHIFT) & 0x0F;
+	header[0] = (record >> 24) & 0xFF;
+	header[1] = (record >> 16) & 0xFF;
+	header[2] = (record >> 8) & 0xFF;
+	// Check CRCs and field ID.
+	if ((NVM_ComputeCrc8(header, 3) != (record & 0xFF)) || (NVM_JournalEncodeCommit(record) != commit) || (field_id == 0) || (field_id > NVM_JOURNAL_FIELD_LAST)) {
+		return 0;
+	}
+	(*field) = field_id - 1;
+	(*sequence) = (record >> NVM_JOURNAL_SEQUENCE_SHIFT) & NVM_JOURNAL_SEQUENCE_MASK;
+	(*value) = (record >> NVM_JOURNAL_VALUE_SHIFT) & 0xFFFF;
+	return 1;
+}
+
+/* READ A JOURNAL RECORD.
+ * @param record_idx:	Record index in journal.
+ * @param field:		Pointer to byte that will contain the field index.
+ * @param sequence:		Pointer to byte that will contain the record sequence number.
+ * @param value:		Pointer to short that will contain the field value.
+ * @return valid:		1 if the record is valid, 0 otherwise.
+ */
+static unsigned char NVM_JournalReadRecord(unsigned short record_idx, unsigned char* field, unsigned char* sequence, unsigned short* value) {
+	unsigned short address_offset = NVM_JOURNAL_START_ADDRESS_OFFSET + (record_idx * NVM_JOURNAL_RECORD_SIZE_BYTES);
+	return NVM_JournalDecode(NVM_ReadWord(address_offset), NVM_ReadWord(address_offset + NVM_JOURNAL_COMMIT_OFFSET_BYTES), field, sequence, value);
+}
+
+/* APPEND A RECORD AT JOURNAL HEAD.
+ * @param field:	Field index.
+ * @param value:	Field value.
+ * @return:			None.
+ */
+static void NVM_JournalAppend(unsigned char field, unsigned short value) {
+	unsigned short address_offset = NVM_JOURNAL_START_ADDRESS_OFFSET + (nvm_ctx.nvm_journal_head_idx * NVM_JOURNAL_RECORD_SIZE_BYTES);
+	unsigned int record = NVM_JournalEncode(field, nvm_ctx.nvm_journal_sequence, value);
+	// Program data word then commit word (record is valid only once both are complete).
+	NVM_WriteWord(address_offset, record);
+	NVM_WriteWord((address_offset + NVM_JOURNAL_COMMIT_OFFSET_BYTES), NVM_JournalEncodeCommit(record));
+	// Update RAM copy.
+	nvm_ctx.nvm_journal_value[field] = value;
+	nvm_ctx.nvm_journal_record_idx[field] = nvm_ctx.nvm_journal_head_idx;
+	// Move head.
+	nvm_ctx.nvm_journal_head_idx = (nvm_ctx.nvm_journal_head_idx + 1) % NVM_JOURNAL_SIZE_RECORDS;
+	nvm_ctx.nvm_journal_sequence = (nvm_ctx.nvm_journal_sequence + 1) & NVM_JOURNAL_SEQUENCE_MASK;
+}
+
+/* COPY THE FIELDS STORED IN THE OLDEST RECORDS AT JOURNAL HEAD.
+ * @param:	None.
+ * @return:	None.
+ */
+static void NVM_JournalRecycle(void) {
+	unsigned char field = 0;
+	unsigned short distance = 0;
+	while (field < NVM_JOURNAL_FIELD_LAST) {
+		if (nvm_ctx.nvm_journal_record_idx[field] != NVM_JOURNAL_RECORD_INDEX_NONE) {
+			// Compute record age (0 is the oldest record, which will be overwritten by the next append).
+			distance = (nvm_ctx.nvm_journal_record_idx[field] + NVM_JOURNAL_SIZE_RECORDS - nvm_ctx.nvm_journal_head_idx) % NVM_JOURNAL_SIZE_RECORDS;
+			if (distance < NVM_JOURNAL_RESERVED_RECORDS) {
+				// Last value is copied before being overwritten, the original record remains valid until then.
+				NVM_JournalAppend(field, nvm_ctx.nvm_journal_value[field]);
+				// Head moved: restart scan.
+				field = 0;
+				continue;
+			}
+		}
+		field++;
+	}
+}
+
+/* SEARCH JOURNAL HEAD AND RETRIEVE THE LAST VALUE OF ALL JOURNAL FIELDS.
+ * @param:	None.
+ * @return:	None.
+ */
+static void NVM_JournalScan(void) {
+	// Local variables.
+	unsigned short record_idx = 0;
+	unsigned char field = 0;
+	unsigned char sequence = 0;
+	unsigned char previous_sequence = 0;
+	unsigned short value = 0;
+	unsigned char byte_idx = 0;
+	unsigned char nvm_byte = 0;
+	// Init context.
+	for (field=0 ; field<NVM_FIELD_LAST ; field++) {
+		if (nvm_fields[field].nvm_storage != NVM_STORAGE_JOURNAL) continue;
+		nvm_ctx.nvm_journal_value[nvm_fields[field].nvm_index] = nvm_fields[field].nvm_default_value;
+		nvm_ctx.nvm_journal_record_idx[nvm_fields[field].nvm_index] = NVM_JOURNAL_RECORD_INDEX_NONE;
+	}
+	nvm_ctx.nvm_journal_head_idx = 0;
+	nvm_ctx.nvm_journal_sequence = 0;
+	// Search head: first invalid record or sequence number discontinuity.
+	if (NVM_JournalReadRecord(0, &field, &previous_sequence, &value) != 0) {
+		for (record_idx=1 ; record_idx<NVM_JOURNAL_SIZE_RECORDS ; record_idx++) {
+			if ((NVM_JournalReadRecord(record_idx, &field, &sequence, &value) == 0) || (sequence != ((previous_sequence + 1) & NVM_JOURNAL_SEQUENCE_MASK))) break;
+			previous_sequence = sequence;
+		}
+		nvm_ctx.nvm_journal_head_idx = (record_idx % NVM_JOURNAL_SIZE_RECORDS);
+		nvm_ctx.nvm_journal_sequence = ((previous_sequence + 1) & NVM_JOURNAL_SEQUENCE_MASK);
+	}
+	else {
+		if (NVM_JournalReadRecord((NVM_JOURNAL_SIZE_RECORDS - 1), &field, &previous_sequence, &value) == 0) {
+			// Blank journal: import fields from their fixed address.
+			for (field=0 ; field<NVM_FIELD_LAST ; field++) {
+				if (nvm_fields[field].nvm_storage != NVM_STORAGE_JOURNAL) continue;
+				value = nvm_fields[field].nvm_default_value;
+				if (nvm_fields[field].nvm_legacy_address_offset != NVM_LEGACY_ADDRESS_OFFSET_NONE) {
+					value = 0;
+					for (byte_idx=0 ; byte_idx<nvm_fields[field].nvm_width_bytes ; byte_idx++) {
+						NVM_ReadByte((nvm_fields[field].nvm_legacy_address_offset + byte_idx), &nvm_byte);
+						value = (value << 8) | nvm_byte;
+					}
+				}
+				NVM_JournalAppend(nvm_fields[field].nvm_index, value);
+			}
+			return;
+		}
+		// First record of a new cycle was interrupted.
+		nvm_ctx.nvm_journal_sequence = ((previous_sequence + 1) & NVM_JOURNAL_SEQUENCE_MASK);
+	}
+	// Replay records from the oldest to the newest.
+	for (record_idx=0 ; record_idx<NVM_JOURNAL_SIZE_RECORDS ; record_idx++) {
+		if (NVM_JournalReadRecord(((nvm_ctx.nvm_journal_head_idx + record_idx) % NVM_JOURNAL_SIZE_RECORDS), &field, &sequence, &value) != 0) {
+			nvm_ctx.nvm_journal_value[field] = value;
+			nvm_ctx.nvm_journal_record_idx[field] = ((nvm_ctx.nvm_journal_head_idx + record_idx) % NVM_JOURNAL_SIZE_RECORDS);
+		}
+	}
+	// Complete any copy interrupted by a reset.
+	NVM_JournalRecycle();
+}
+
+/* WRITE A JOURNAL FIELD.
+ * @param field:	Journal field to write.
+ * @param value:	New field value.
+ * @return:			None.
+ */
+static void NVM_JournalWrite(NVM_JournalField field, unsigned short value) {
+	// Program a new record only if the value changed.
+	if ((nvm_ctx.nvm_journal_record_idx[field] == NVM_JOURNAL_RECORD_INDEX_NONE) || (nvm_ctx.nvm_journal_value[field] != value)) {
+		NVM_JournalAppend(field, value);
+		NVM_JournalRecycle();
+	}
+}
+
+/* READ AND CHECK ONE COPY OF A RECORD.
+ * @param record:		Record to read.
+ * @param copy_idx:		Copy index.
+ * @param sequence:		Pointer to byte that will contain the copy sequence number.
+ * @param data:			Byte array that will contain the record data.
+ * @return valid:		1 if the copy is complete and its CRC is correct, 0 otherwise.
+ */
+static unsigned char NVM_RecordReadCopy(NVM_Record record, unsigned char copy_idx, unsigned char* sequence, unsigned char* data) {
+	// Local variables.
+	unsigned short address_offset = nvm_records[record].nvm_address_offset + (copy_idx * (NVM_RECORD_HEADER_SIZE_BYTES + nvm_records[record].nvm_size_bytes));
+	unsigned int header = NVM_ReadWord(address_offset);
+	unsigned int word = 0;
+	unsigned char byte_idx = 0;
+	unsigned char header_bytes[2];
+	unsigned short crc = 0;
+	// Read data.
+	for (byte_idx=0 ; byte_idx<nvm_records[record].nvm_size_bytes ; byte_idx++) {
+		if ((byte_idx % 4) == 0) {
+			word = NVM_ReadWord(address_offset + NVM_RECORD_HEADER_SIZE_BYTES + byte_idx);
+		}
+		data[byte_idx] = (word >> (8 * (byte_idx % 4))) & 0xFF;
+	}
+	// Check version and CRC.
+	header_bytes[0] = (header >> 0) & 0xFF;
+	header_bytes[1] = (header >> 8) & 0xFF;
+	crc = NVM_ComputeCrc16(0xFFFF, header_bytes, 2);
+	crc = NVM_ComputeCrc16(crc, data, nvm_records[record].nvm_size_bytes);
+	if ((header_bytes[0] != NVM_RECORD_VERSION) || (crc != ((header >> 16) & 0xFFFF))) {
+		return 0;
+	}
+	(*sequence) = header_bytes[1];
+	return 1;
+}
+
+/* SEARCH THE LAST VALID COPY OF A RECORD.
+ * @param record:	Record to scan.
+ * @return:			None.
+ */
+static void NVM_RecordScan(NVM_Record record) {
+	// Local variables.
+	unsigned char copy_idx = 0;
+	unsigned char sequence = 0;
+	unsigned char data[NVM_RECORD_DATA_MAX_SIZE_BYTES];
+	unsigned char byte_idx = 0;
+	NVM_Field field = 0;
+	// Keep the copy with the highest sequence number (copies are written in turn, so sequence numbers never differ by more than the number of copies).
+	nvm_ctx.nvm_record_copy_idx[record] = NVM_RECORD_COPY_INDEX_NONE;
+	for (copy_idx=0 ; copy_idx<nvm_records[record].nvm_number_of_copies ; copy_idx++) {
+		if (NVM_RecordReadCopy(record, copy_idx, &sequence, data) != 0) {
+			if ((nvm_ctx.nvm_record_copy_idx[record] == NVM_RECORD_COPY_INDEX_NONE) || (((signed char) (sequence - nvm_ctx.nvm_record_sequence[record])) > 0)) {
+				nvm_ctx.nvm_record_copy_idx[record] = copy_idx;
+				nvm_ctx.nvm_record_sequence[record] = sequence;
+				for (byte_idx=0 ; byte_idx<nvm_records[record].nvm_size_bytes ; byte_idx++) {
+					nvm_ctx.nvm_record_data[record][byte_idx] = data[byte_idx];
+				}
+			}
+		}
+	}
+	// Import data from fixed address if no valid copy was found.
+	if (nvm_ctx.nvm_record_copy_idx[record] == NVM_RECORD_COPY_INDEX_NONE) {
+		for (byte_idx=0 ; byte_idx<nvm_records[record].nvm_size_bytes ; byte_idx++) {
+			data[byte_idx] = 0;
+			if (byte_idx < nvm_records[record].nvm_legacy_size_bytes) {
+				NVM_ReadByte((nvm_records[record].nvm_legacy_address_offset + byte_idx), &(data[byte_idx]));
+			}
+		}
+		// Configuration fields created after the fixed address layout start from their default value.
+		if (record == NVM_RECORD_CONFIG) {
+			for (field=0 ; field<NVM_FIELD_LAST ; field++) {
+				if ((nvm_fields[field].nvm_storage != NVM_STORAGE_CONFIG_RECORD) || (nvm_fields[field].nvm_legacy_address_offset != NVM_LEGACY_ADDRESS_OFFSET_NONE)) continue;
+				data[nvm_fields[field].nvm_index] = (unsigned char) nvm_fields[field].nvm_default_value;
+			}
+		}
+		NVM_RecordWrite(record, data);
+	}
+}
+
+/* READ THE HEADER OF A BACKLOG ENTRY.
+ * @param entry_idx:	Entry index.
+ * @param sequence:		Pointer to byte that will contain the entry sequence number.
+ * @param data:			Byte array that will contain the entry data.
+ * @return status:		NVM_BACKLOG_STATUS_PENDING, NVM_BACKLOG_STATUS_SENT or 0 if the entry is blank or corrupted.
+ */
+static unsigned char NVM_BacklogReadEntry(unsigned char entry_idx, unsigned char* sequence, unsigned char* data) {
+	// Local variables.
+	unsigned short address_offset = NVM_BACKLOG_ADDRESS_OFFSET + (entry_idx * (NVM_BACKLOG_HEADER_SIZE_BYTES + NVM_BACKLOG_DATA_SIZE_BYTES));
+	unsigned int header = NVM_ReadWord(address_offset);
+	unsigned int word = 0;
+	unsigned char byte_idx = 0;
+	unsigned char status = (header >> 8) & 0xFF;
+	// Read data.
+	for (byte_idx=0 ; byte_idx<NVM_BACKLOG_DATA_SIZE_BYTES ; byte_idx++) {
+		if ((byte_idx % 4) == 0) {
+			word = NVM_ReadWord(address_offset + NVM_BACKLOG_HEADER_SIZE_BYTES + byte_idx);
+		}
+		data[byte_idx] = (word >> (8 * (byte_idx % 4))) & 0xFF;
+	}
+	// Check status and CRC (computed on sequence number and data, the status can be updated afterwards).
+	(*sequence) = (header >> 0) & 0xFF;
+	if (((status != NVM_BACKLOG_STATUS_PENDING) && (status != NVM_BACKLOG_STATUS_SENT)) ||
+		(NVM_ComputeCrc16(NVM_ComputeCrc16(0xFFFF, sequence, 1), data, NVM_BACKLOG_DATA_SIZE_BYTES) != ((header >> 16) & 0xFFFF))) {
+		return 0;
+	}
+	return status;
+}
+
+/* SEARCH THE OLDEST PENDING ENTRY OF THE BACKLOG.
+ * @param data:		Byte array that will contain the entry data.
+ * @return idx:		Entry index or NVM_BACKLOG_ENTRY_INDEX_NONE if the backlog is empty.
+ */
+static unsigned char NVM_BacklogSearchOldest(unsigned char* data) {
+	unsigned char entry_idx = 0;
+	unsigned char sequence = 0;
+	// Entries are stored from the oldest (head) to the newest (head - 1).
+	for (entry_idx=0 ; entry_idx<NVM_BACKLOG_SIZE_ENTRIES ; entry_idx++) {
+		if (NVM_BacklogReadEntry(((nvm_ctx.nvm_backlog_head_idx + entry_idx) % NVM_BACKLOG_SIZE_ENTRIES), &sequence, data) == NVM_BACKLOG_STATUS_PENDING) {
+			return ((nvm_ctx.nvm_backlog_head_idx + entry_idx) % NVM_BACKLOG_SIZE_ENTRIES);
+		}
+	}
+	return NVM_BACKLOG_ENTRY_INDEX_NONE;
+}
+
+/* SEARCH BACKLOG HEAD AND COUNT PENDING ENTRIES.
+ * @param:	None.
+ * @return:	None.
+ */
+static void NVM_BacklogScan(void) {
+	// Local variables.
+	unsigned char entry_idx = 0;
+	unsigned char sequence = 0;
+	unsigned char status = 0;
+	unsigned char newest_found = 0;
+	unsigned char data[NVM_BACKLOG_DATA_SIZE_BYTES];
+	// Head is located after the entry with the highest sequence number.
+	nvm_ctx.nvm_backlog_head_idx = 0;
+	nvm_ctx.nvm_backlog_sequence = 0;
+	nvm_ctx.nvm_backlog_count = 0;
+	for (entry_idx=0 ; entry_idx<NVM_BACKLOG_SIZE_ENTRIES ; entry_idx++) {
+		status = NVM_BacklogReadEntry(entry_idx, &sequence, data);
+		if (status == 0) continue;
+		if (status == NVM_BACKLOG_STATUS_PENDING) {
+			nvm_ctx.nvm_backlog_count++;
+		}
+		if ((newest_found == 0) || (((signed char) (sequence - nvm_ctx.nvm_backlog_sequence)) >= 0)) {
+			nvm_ctx.nvm_backlog_head_idx = (entry_idx + 1) % NVM_BACKLOG_SIZE_ENTRIES;
+			nvm_ctx.nvm_backlog_sequence = sequence + 1;
+			newest_found = 1;
+		}
+	}
+}
+
 /*** NVM functions ***/
 
 /* ENABLE NVM INTERFACE.
@@ -85,6 +619,7 @@ void NVM_WriteByte(unsigned short address_offset, unsigned char byte_to_store) {
 	// Check if address is in EEPROM range.
 	if (address_offset < EEPROM_SIZE) {
 		(*((unsigned char*) (EEPROM_START_ADDRESS+address_offset))) = byte_to_store; // Write byte to requested address.
+		nvm_ctx.nvm_program_count[NVM_GetArea(address_offset)]++;
 	}
 	// Wait end of operation.
 	while (((FLASH -> SR) & (0b1 << 0)) != 0); // Wait till BSY='1'.
@@ -97,26 +632,325 @@ void NVM_WriteByte(unsigned short address_offset, unsigned char byte_to_store) {
  * @return:	None.
  */
 void NVM_ResetDefault(void) {
+	// Local variables.
+	unsigned char field = 0;
+	unsigned char byte_idx = 0;
+	unsigned char sigfox_data[NVM_RECORD_SIGFOX_SIZE_BYTES] = {0x00};
+	unsigned char config_data[NVM_RECORD_CONFIG_SIZE_BYTES] = {0x00};
 	// Sigfox parameters.
-	NVM_WriteByte((NVM_SIGFOX_PN_ADDRESS_OFFSET + 0), 0x00);
-	NVM_WriteByte((NVM_SIGFOX_PN_ADDRESS_OFFSET + 1), 0x00);
-	NVM_WriteByte((NVM_SIGFOX_SEQ_ADDRESS_OFFSET + 0), 0x00);
-	NVM_WriteByte((NVM_SIGFOX_SEQ_ADDRESS_OFFSET + 1), 0x00);
-	NVM_WriteByte((NVM_SIGFOX_FH_ADDRESS_OFFSET + 0), 0x00);
-	NVM_WriteByte((NVM_SIGFOX_FH_ADDRESS_OFFSET + 1), 0x00);
-	NVM_WriteByte(NVM_SIGFOX_RL_ADDRESS_OFFSET, 0x00);
-	// Device configuration (mapped on downlink frame).
-	NVM_WriteByte(NVM_CONFIG_LOCAL_UTC_OFFSET_ADDRESS_OFFSET, 0x01);
-	NVM_WriteByte(NVM_CONFIG_UPLINK_FRAMES_ADDRESS_OFFSET, 0x00);
-	NVM_WriteByte(NVM_CONFIG_GPS_TIMEOUT_ADDRESS_OFFSET, 0x78);
-	// Period management and status.
-	NVM_WriteByte(NVM_DAY_COUNT_ADDRESS_OFFSET, 0x01);
-	NVM_WriteByte(NVM_HOURS_COUNT_ADDRESS_OFFSET, 0x01);
-	NVM_WriteByte(NVM_MONITORING_STATUS_BYTE_ADDRESS_OFFSET, 0x00);
-	// RTC.
-	NVM_WriteByte((NVM_RTC_PWKUP_YEAR_ADDRESS_OFFSET + 0), 0x00);
-	NVM_WriteByte((NVM_RTC_PWKUP_YEAR_ADDRESS_OFFSET + 1), 0x00);
-	NVM_WriteByte(NVM_RTC_PWKUP_MONTH_ADDRESS_OFFSET, 0x00);
-	NVM_WriteByte(NVM_RTC_PWKUP_DATE_ADDRESS_OFFSET, 0x00);
-	NVM_WriteByte(NVM_RTC_PWKUP_HOURS_ADDRESS_OFFSET, 0x00);
+	NVM_RecordWrite(NVM_RECORD_SIGFOX, sigfox_data);
+	// Build default configuration in RAM and commit it in a single record write.
+	for (field=0 ; field<NVM_FIELD_LAST ; field++) {
+		if (nvm_fields[field].nvm_storage != NVM_STORAGE_CONFIG_RECORD) continue;
+		for (byte_idx=0 ; byte_idx<nvm_fields[field].nvm_width_bytes ; byte_idx++) {
+			config_data[nvm_fields[field].nvm_index + byte_idx] = (nvm_fields[field].nvm_default_value >> (8 * (nvm_fields[field].nvm_width_bytes - byte_idx - 1))) & 0xFF;
+		}
+	}
+	NVM_RecordWrite(NVM_RECORD_CONFIG, config_data);
+	// Journal fields (one record per field, only if the value changed).
+	for (field=0 ; field<NVM_FIELD_LAST ; field++) {
+		if (nvm_fields[field].nvm_storage != NVM_STORAGE_JOURNAL) continue;
+		NVM_JournalWrite(nvm_fields[field].nvm_index, nvm_fields[field].nvm_default_value);
+	}
+}
+
+/* LOAD AND CHECK ALL NVM DATA (TO BE CALLED ONCE AT START-UP).
+ * @param:	None.
+ * @return:	None.
+ */
+void NVM_Init(void) {
+	// Local variables.
+	unsigned char record = 0;
+	unsigned char field = 0;
+	unsigned short value = 0;
+	unsigned char byte_idx = 0;
+	// Records.
+	for (record=0 ; record<NVM_RECORD_LAST ; record++) {
+		NVM_RecordScan(record);
+	}
+	// Backlog.
+	NVM_BacklogScan();
+	// Journal.
+	NVM_JournalScan();
+	// Restore default value of out of range fields.
+	for (field=0 ; field<NVM_FIELD_LAST ; field++) {
+		NVM_ReadField(field, &value);
+		if ((value < nvm_fields[field].nvm_min_value) || (value > nvm_fields[field].nvm_max_value)) {
+			NVM_WriteField(field, nvm_fields[field].nvm_default_value);
+		}
+	}
+	// Sigfox credentials.
+	for (byte_idx=0 ; byte_idx<NVM_SIGFOX_ID_LENGTH_BYTES ; byte_idx++) {
+		NVM_ReadByte((NVM_SIGFOX_ID_ADDRESS_OFFSET + byte_idx), &(nvm_ctx.nvm_sigfox_id[byte_idx]));
+	}
+	for (byte_idx=0 ; byte_idx<NVM_SIGFOX_KEY_LENGTH_BYTES ; byte_idx++) {
+		NVM_ReadByte((NVM_SIGFOX_KEY_ADDRESS_OFFSET + byte_idx), &(nvm_ctx.nvm_sigfox_key[byte_idx]));
+	}
+}
+
+/* READ A FIELD (FROM RAM COPY).
+ * @param field:	Field to read.
+ * @param value:	Pointer to short that will contain the field value.
+ * @return:			None.
+ */
+void NVM_ReadField(NVM_Field field, unsigned short* value) {
+	unsigned char byte_idx = 0;
+	if (field >= NVM_FIELD_LAST) return;
+	switch (nvm_fields[field].nvm_storage) {
+	case NVM_STORAGE_CONFIG_RECORD:
+		(*value) = 0;
+		for (byte_idx=0 ; byte_idx<nvm_fields[field].nvm_width_bytes ; byte_idx++) {
+			(*value) = ((*value) << 8) | nvm_ctx.nvm_record_data[NVM_RECORD_CONFIG][nvm_fields[field].nvm_index + byte_idx];
+		}
+		break;
+	case NVM_STORAGE_JOURNAL:
+		(*value) = nvm_ctx.nvm_journal_value[nvm_fields[field].nvm_index];
+		break;
+	default:
+		break;
+	}
+}
+
+/* WRITE A FIELD.
+ * @param field:	Field to write.
+ * @param value:	New field value.
+ * @return status:	1 in case of success, 0 if the value is out of the field range.
+ */
+unsigned char NVM_WriteField(NVM_Field field, unsigned short value) {
+	// Local variables.
+	unsigned char config_data[NVM_RECORD_CONFIG_SIZE_BYTES];
+	unsigned char byte_idx = 0;
+	// Check parameters.
+	if ((field >= NVM_FIELD_LAST) || (value < nvm_fields[field].nvm_min_value) || (value > nvm_fields[field].nvm_max_value)) {
+		return 0;
+	}
+	switch (nvm_fields[field].nvm_storage) {
+	case NVM_STORAGE_CONFIG_RECORD:
+		// Update RAM copy and write the whole record.
+		for (byte_idx=0 ; byte_idx<NVM_RECORD_CONFIG_SIZE_BYTES ; byte_idx++) {
+			config_data[byte_idx] = nvm_ctx.nvm_record_data[NVM_RECORD_CONFIG][byte_idx];
+		}
+		for (byte_idx=0 ; byte_idx<nvm_fields[field].nvm_width_bytes ; byte_idx++) {
+			config_data[nvm_fields[field].nvm_index + byte_idx] = (value >> (8 * (nvm_fields[field].nvm_width_bytes - byte_idx - 1))) & 0xFF;
+		}
+		NVM_RecordWrite(NVM_RECORD_CONFIG, config_data);
+		break;
+	case NVM_STORAGE_JOURNAL:
+		NVM_JournalWrite(nvm_fields[field].nvm_index, value);
+		break;
+	default:
+		break;
+	}
+	return 1;
+}
+
+/* TYPED FIELD ACCESSORS (GETTERS READ THE RAM COPY LOADED BY NVM_Init).
+ * @param value:	New field value (setters only).
+ * @return:			Field value (getters) or 1 in case of success, 0 if the value is out of the field range (setters).
+ */
+#define NVM_TYPED_FIELD(name, field, type) \
+type NVM_Get##name(void) { \
+	unsigned short value = 0; \
+	NVM_ReadField(field, &value); \
+	return ((type) value); \
+} \
+unsigned char NVM_Set##name(type value) { \
+	return NVM_WriteField(field, value); \
+}
+NVM_TYPED_FIELDS
+#undef NVM_TYPED_FIELD
+
+/* READ SIGFOX DEVICE ID (FROM RAM COPY).
+ * @param id:	Byte array that will contain the device ID (NVM order).
+ * @return:		None.
+ */
+void NVM_ReadSigfoxId(unsigned char id[NVM_SIGFOX_ID_LENGTH_BYTES]) {
+	unsigned char byte_idx = 0;
+	for (byte_idx=0 ; byte_idx<NVM_SIGFOX_ID_LENGTH_BYTES ; byte_idx++) {
+		id[byte_idx] = nvm_ctx.nvm_sigfox_id[byte_idx];
+	}
+}
+
+/* WRITE SIGFOX DEVICE ID.
+ * @param id:	Device ID to store (NVM order).
+ * @return:		None.
+ */
+void NVM_WriteSigfoxId(unsigned char id[NVM_SIGFOX_ID_LENGTH_BYTES]) {
+	unsigned char byte_idx = 0;
+	for (byte_idx=0 ; byte_idx<NVM_SIGFOX_ID_LENGTH_BYTES ; byte_idx++) {
+		NVM_WriteByte((NVM_SIGFOX_ID_ADDRESS_OFFSET + byte_idx), id[byte_idx]);
+		nvm_ctx.nvm_sigfox_id[byte_idx] = id[byte_idx];
+	}
+}
+
+/* READ SIGFOX DEVICE KEY (FROM RAM COPY).
+ * @param key:	Byte array that will contain the device key.
+ * @return:		None.
+ */
+void NVM_ReadSigfoxKey(unsigned char key[NVM_SIGFOX_KEY_LENGTH_BYTES]) {
+	unsigned char byte_idx = 0;
+	for (byte_idx=0 ; byte_idx<NVM_SIGFOX_KEY_LENGTH_BYTES ; byte_idx++) {
+		key[byte_idx] = nvm_ctx.nvm_sigfox_key[byte_idx];
+	}
+}
+
+/* WRITE SIGFOX DEVICE KEY.
+ * @param key:	Device key to store.
+ * @return:		None.
+ */
+void NVM_WriteSigfoxKey(unsigned char key[NVM_SIGFOX_KEY_LENGTH_BYTES]) {
+	unsigned char byte_idx = 0;
+	for (byte_idx=0 ; byte_idx<NVM_SIGFOX_KEY_LENGTH_BYTES ; byte_idx++) {
+		NVM_WriteByte((NVM_SIGFOX_KEY_ADDRESS_OFFSET + byte_idx), key[byte_idx]);
+		nvm_ctx.nvm_sigfox_key[byte_idx] = key[byte_idx];
+	}
+}
+
+/* READ THE LAST VALID DATA OF A RECORD (FROM RAM COPY).
+ * @param record:	Record to read.
+ * @param data:		Byte array that will contain the record data.
+ * @return valid:	1 if the data is valid, 0 otherwise.
+ */
+unsigned char NVM_RecordRead(NVM_Record record, unsigned char* data) {
+	unsigned char byte_idx = 0;
+	if ((record >= NVM_RECORD_LAST) || (nvm_ctx.nvm_record_copy_idx[record] == NVM_RECORD_COPY_INDEX_NONE)) {
+		return 0;
+	}
+	for (byte_idx=0 ; byte_idx<nvm_records[record].nvm_size_bytes ; byte_idx++) {
+		data[byte_idx] = nvm_ctx.nvm_record_data[record][byte_idx];
+	}
+	return 1;
+}
+
+/* WRITE A RECORD.
+ * @param record:	Record to write.
+ * @param data:		Record data.
+ * @return:			None.
+ */
+void NVM_RecordWrite(NVM_Record record, unsigned char* data) {
+	// Local variables.
+	unsigned char copy_idx = 0;
+	unsigned char sequence = 0;
+	unsigned char header_bytes[2];
+	unsigned short address_offset = 0;
+	unsigned short crc = 0;
+	unsigned int word = 0;
+	unsigned char byte_idx = 0;
+	if (record >= NVM_RECORD_LAST) return;
+	// Skip programming if data did not change.
+	if (nvm_ctx.nvm_record_copy_idx[record] != NVM_RECORD_COPY_INDEX_NONE) {
+		for (byte_idx=0 ; byte_idx<nvm_records[record].nvm_size_bytes ; byte_idx++) {
+			if (nvm_ctx.nvm_record_data[record][byte_idx] != data[byte_idx]) break;
+		}
+		if (byte_idx >= nvm_records[record].nvm_size_bytes) return;
+	}
+	// Select the oldest copy (the last valid copy is never overwritten).
+	if (nvm_ctx.nvm_record_copy_idx[record] != NVM_RECORD_COPY_INDEX_NONE) {
+		copy_idx = (nvm_ctx.nvm_record_copy_idx[record] + 1) % nvm_records[record].nvm_number_of_copies;
+		sequence = nvm_ctx.nvm_record_sequence[record] + 1;
+	}
+	address_offset = nvm_records[record].nvm_address_offset + (copy_idx * (NVM_RECORD_HEADER_SIZE_BYTES + nvm_records[record].nvm_size_bytes));
+	// Program data.
+	for (byte_idx=0 ; byte_idx<nvm_records[record].nvm_size_bytes ; byte_idx++) {
+		word |= (((unsigned int) data[byte_idx]) << (8 * (byte_idx % 4)));
+		if ((byte_idx % 4) == 3) {
+			NVM_WriteWord((address_offset + NVM_RECORD_HEADER_SIZE_BYTES + byte_idx - 3), word);
+			word = 0;
+		}
+	}
+	// Program header last: the copy becomes valid only once fully written.
+	header_bytes[0] = NVM_RECORD_VERSION;
+	header_bytes[1] = sequence;
+	crc = NVM_ComputeCrc16(0xFFFF, header_bytes, 2);
+	crc = NVM_ComputeCrc16(crc, data, nvm_records[record].nvm_size_bytes);
+	NVM_WriteWord(address_offset, (header_bytes[0] | (header_bytes[1] << 8) | (((unsigned int) crc) << 16)));
+	// Update context.
+	nvm_ctx.nvm_record_copy_idx[record] = copy_idx;
+	nvm_ctx.nvm_record_sequence[record] = sequence;
+	for (byte_idx=0 ; byte_idx<nvm_records[record].nvm_size_bytes ; byte_idx++) {
+		nvm_ctx.nvm_record_data[record][byte_idx] = data[byte_idx];
+	}
+}
+
+/* APPEND AN ENTRY TO THE BACKLOG (THE OLDEST ENTRY IS OVERWRITTEN WHEN FULL).
+ * @param data:	Entry data (NVM_BACKLOG_DATA_SIZE_BYTES bytes).
+ * @return:		None.
+ */
+void NVM_BacklogPush(unsigned char* data) {
+	// Local variables.
+	unsigned short address_offset = NVM_BACKLOG_ADDRESS_OFFSET + (nvm_ctx.nvm_backlog_head_idx * (NVM_BACKLOG_HEADER_SIZE_BYTES + NVM_BACKLOG_DATA_SIZE_BYTES));
+	unsigned char current_data[NVM_BACKLOG_DATA_SIZE_BYTES];
+	unsigned char sequence = 0;
+	unsigned short crc = 0;
+	unsigned int word = 0;
+	unsigned char byte_idx = 0;
+	// Update pending count if a pending entry is overwritten.
+	if (NVM_BacklogReadEntry(nvm_ctx.nvm_backlog_head_idx, &sequence, current_data) == NVM_BACKLOG_STATUS_PENDING) {
+		nvm_ctx.nvm_backlog_count--;
+	}
+	// Program data.
+	for (byte_idx=0 ; byte_idx<NVM_BACKLOG_DATA_SIZE_BYTES ; byte_idx++) {
+		word |= (((unsigned int) data[byte_idx]) << (8 * (byte_idx % 4)));
+		if ((byte_idx % 4) == 3) {
+			NVM_WriteWord((address_offset + NVM_BACKLOG_HEADER_SIZE_BYTES + byte_idx - 3), word);
+			word = 0;
+		}
+	}
+	// Program header last: the entry becomes valid only once fully written.
+	crc = NVM_ComputeCrc16(NVM_ComputeCrc16(0xFFFF, &nvm_ctx.nvm_backlog_sequence, 1), data, NVM_BACKLOG_DATA_SIZE_BYTES);
+	NVM_WriteWord(address_offset, (nvm_ctx.nvm_backlog_sequence | (NVM_BACKLOG_STATUS_PENDING << 8) | (((unsigned int) crc) << 16)));
+	// Update context.
+	nvm_ctx.nvm_backlog_head_idx = (nvm_ctx.nvm_backlog_head_idx + 1) % NVM_BACKLOG_SIZE_ENTRIES;
+	nvm_ctx.nvm_backlog_sequence++;
+	nvm_ctx.nvm_backlog_count++;
+}
+
+/* READ THE OLDEST PENDING ENTRY OF THE BACKLOG.
+ * @param data:		Byte array that will contain the entry data (NVM_BACKLOG_DATA_SIZE_BYTES bytes).
+ * @return pending:	1 if an entry was found, 0 if the backlog is empty.
+ */
+unsigned char NVM_BacklogPeek(unsigned char* data) {
+	if (nvm_ctx.nvm_backlog_count == 0) {
+		return 0;
+	}
+	return (NVM_BacklogSearchOldest(data) != NVM_BACKLOG_ENTRY_INDEX_NONE);
+}
+
+/* MARK THE OLDEST PENDING ENTRY OF THE BACKLOG AS SENT.
+ * @param:	None.
+ * @return:	None.
+ */
+void NVM_BacklogPop(void) {
+	// Local variables.
+	unsigned char data[NVM_BACKLOG_DATA_SIZE_BYTES];
+	unsigned char entry_idx = NVM_BacklogSearchOldest(data);
+	unsigned short address_offset = NVM_BACKLOG_ADDRESS_OFFSET + (entry_idx * (NVM_BACKLOG_HEADER_SIZE_BYTES + NVM_BACKLOG_DATA_SIZE_BYTES));
+	unsigned int header = 0;
+	if (entry_idx == NVM_BACKLOG_ENTRY_INDEX_NONE) return;
+	// Update status byte only (single word operation, sequence number is kept to locate the head).
+	header = NVM_ReadWord(address_offset);
+	header &= ~(0xFF << 8);
+	header |= (NVM_BACKLOG_STATUS_SENT << 8);
+	NVM_WriteWord(address_offset, header);
+	nvm_ctx.nvm_backlog_count--;
+}
+
+/* GET THE NUMBER OF PENDING ENTRIES IN THE BACKLOG.
+ * @param:			None.
+ * @return count:	Number of pending entries.
+ */
+unsigned char NVM_BacklogGetCount(void) {
+	return nvm_ctx.nvm_backlog_count;
+}
+
+/* GET THE NUMBER OF PROGRAM OPERATIONS PERFORMED IN AN EEPROM AREA SINCE START-UP.
+ * @param area:		Area to read.
+ * @return count:	Number of byte or word program operations.
+ */
+unsigned int NVM_GetProgramCount(NVM_Area area) {
+	unsigned int count = 0;
+	if (area < NVM_AREA_LAST) {
+		count = nvm_ctx.nvm_program_count[area];
+	}
+	return count;
 }
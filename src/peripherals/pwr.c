@@ -39,6 +39,18 @@ void PWR_Init(void) {
 	SCB -> SCR &= ~(0b1 << 1); // SLEEPONEXIT='0'.
 }
 
+/* FUNCTION TO ENTER SLEEP MODE (MAIN REGULATOR KEPT ON, ALLOWED WHATEVER THE SYSTEM CLOCK FREQUENCY).
+ * @param:	None.
+ * @return:	None.
+ */
+void PWR_EnterSleepMode(void) {
+	// Regulator in main mode.
+	PWR -> CR &= ~(0b1 << 0); // LPSDSR='0'.
+	// Enter sleep mode.
+	SCB -> SCR &= ~(0b1 << 2); // SLEEPDEEP='0'.
+	__asm volatile ("wfi"); // Wait For Interrupt core instruction.
+}
+
 /* FUNCTION TO ENTER LOW POWER SLEEP MODE.
  * @param:	None.
  * @return:	None.
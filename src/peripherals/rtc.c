@@ -235,6 +235,27 @@ void RTC_GetTimestamp(Timestamp* rtc_timestamp) {
 	rtc_timestamp -> seconds = ((tr_value & (0b111 << 4)) >> 4) * 10 + (tr_value & 0b1111);
 }
 
+/* GET CURRENT RTC TIME OF DAY WITH SUB-SECOND RESOLUTION.
+ * @param:	None.
+ * @return:	Number of milliseconds elapsed since midnight.
+ */
+unsigned int RTC_GetTimeOfDayMilliseconds(void) {
+	// Read registers (shadow registers are bypassed: read again if a second elapsed in between).
+	unsigned int tr_value = 0;
+	unsigned int ssr_value = 0;
+	do {
+		tr_value = (RTC -> TR) & 0x007F7F7F; // Mask reserved bits.
+		ssr_value = (RTC -> SSR) & 0x0000FFFF;
+	}
+	while (tr_value != ((RTC -> TR) & 0x007F7F7F));
+	unsigned int prediv_s = (RTC -> PRER) & 0x00007FFF;
+	// Convert to milliseconds (sub-second counter is decremented from PREDIV_S).
+	unsigned int seconds = (((tr_value & (0b11 << 20)) >> 20) * 10 + ((tr_value & (0b1111 << 16)) >> 16)) * 3600;
+	seconds += (((tr_value & (0b111 << 12)) >> 12) * 10 + ((tr_value & (0b1111 << 8)) >> 8)) * 60;
+	seconds += ((tr_value & (0b111 << 4)) >> 4) * 10 + (tr_value & 0b1111);
+	return ((seconds * 1000) + (((prediv_s - ssr_value) * 1000) / (prediv_s + 1)));
+}
+
 /* ENABLE RTC ALARM A INTERRUPT.
  * @param:	None.
  * @return:	None.
@@ -7,15 +7,25 @@
 
 #include "spi.h"
 
+#include "dma.h"
 #include "gpio.h"
 #include "lptim.h"
 #include "mapping.h"
+#include "pwr.h"
 #include "rcc_reg.h"
 #include "spi_reg.h"
+#include "systick.h"
 
 /*** SPI local macros ***/
 
-#define SPI_ACCESS_TIMEOUT_COUNT	1000000
+#define SPI_ACCESS_TIMEOUT_COUNT			1000000
+// DMA transfers end with a transfer complete or transfer error interrupt, SysTick bounds the wait otherwise.
+// SPI1 clock is SYSCLK/4 so a byte lasts 32 processor cycles whatever the clock source (4 times margin).
+#define SPI1_DMA_TIMEOUT_CYCLES_PER_BYTE	128
+#define SPI1_DMA_TIMEOUT_CYCLES_OFFSET		1000
+// Shorter transfers are polled (DMA setup cost and use in interrupt context).
+#define SPI1_DMA_TRANSFER_LENGTH_MIN		8
+#define SPI1_DUMMY_BYTE						0xFF
 
 /*** SPI functions ***/
 
@@ -211,6 +221,64 @@ unsigned char SPI1_ReadByte(unsigned char tx_data, unsigned char* rx_data) {
 	return 1;
 }
 
+/* TRANSFER A BLOCK OF BYTES THROUGH SPI1.
+ * @param tx_data:	Bytes to send (dummy bytes are sent if null).
+ * @param rx_data:	Byte array that will contain the received bytes (ignored if null).
+ * @param length:	Number of bytes to transfer.
+ * @return:			1 in case of success, 0 in case of failure.
+ */
+unsigned char SPI1_TransferBytes(unsigned char* tx_data, unsigned char* rx_data, unsigned char length) {
+	// Local variables.
+	unsigned char byte_idx = 0;
+	unsigned char dummy_tx = SPI1_DUMMY_BYTE;
+	unsigned char dummy_rx = 0;
+	unsigned int loop_count = 0;
+	DMA_Status dma_status = DMA_STATUS_RUNNING;
+	// Short transfers are done by CPU (mandatory in interrupt context since CPU can not sleep).
+	if (length < SPI1_DMA_TRANSFER_LENGTH_MIN) {
+		for (byte_idx=0 ; byte_idx<length ; byte_idx++) {
+			if (SPI1_ReadByte(((tx_data != 0) ? tx_data[byte_idx] : SPI1_DUMMY_BYTE), ((rx_data != 0) ? &(rx_data[byte_idx]) : &dummy_rx)) == 0) return 0;
+		}
+		return 1;
+	}
+#ifdef HW1_0
+	// Set data length to 8-bits.
+	SPI1 -> CR1 &= ~(0b1 << 11); // DFF='0'.
+#endif
+	// Wait for end of previous accesses and flush RX register.
+	while ((((SPI1 -> SR) & (0b1 << 1)) == 0) || (((SPI1 -> SR) & (0b1 << 7)) != 0)) {
+		// Wait for TXE='1' and BSY='0' or timeout.
+		loop_count++;
+		if (loop_count > SPI_ACCESS_TIMEOUT_COUNT) return 0;
+	}
+	dummy_rx = *((volatile unsigned char*) &(SPI1 -> DR));
+	// Configure and start DMA (RX request must be enabled before TX request).
+	DMA1_InitChannels2_3();
+	DMA1_StartChannels2_3(((tx_data != 0) ? (unsigned int) tx_data : (unsigned int) &dummy_tx), (tx_data != 0), ((rx_data != 0) ? (unsigned int) rx_data : (unsigned int) &dummy_rx), (rx_data != 0), length);
+	SPI1 -> CR2 |= (0b1 << 0); // RXDMAEN='1'.
+	SPI1 -> CR2 |= (0b1 << 1); // TXDMAEN='1'.
+	// Enter sleep mode until the last byte is received, a transfer error occurs or timeout expires.
+	SYSTICK_StartTimeout(SPI1_DMA_TIMEOUT_CYCLES_OFFSET + (length * SPI1_DMA_TIMEOUT_CYCLES_PER_BYTE));
+	while (1) {
+		// Mask interrupts between status check and WFI, otherwise the last interrupt could be serviced in between and never wake the CPU up.
+		__asm volatile ("cpsid i");
+		dma_status = DMA1_GetChannels2_3Status();
+		if ((dma_status != DMA_STATUS_RUNNING) || (SYSTICK_GetTimeoutFlag() != 0)) {
+			__asm volatile ("cpsie i");
+			break;
+		}
+		// WFI exits on a pending interrupt even if it is masked, handlers are executed once interrupts are unmasked.
+		PWR_EnterSleepMode();
+		__asm volatile ("cpsie i");
+	}
+	SYSTICK_StopTimeout();
+	// Release DMA.
+	SPI1 -> CR2 &= ~(0b11 << 0); // RXDMAEN='0' and TXDMAEN='0'.
+	DMA1_StopChannels2_3();
+	DMA1_Disable();
+	return (dma_status == DMA_STATUS_COMPLETE);
+}
+
 #ifdef HW1_0
 /* SEND A SHORT THROUGH SPI1.
  * @param tx_data:	Data to send (16-bits).
@@ -0,0 +1,68 @@
+/*
+ * systick.c
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "systick.h"
+
+#include "systick_reg.h"
+
+/*** SYSTICK functions ***/
+
+/* START COUNTING CPU CYCLES WITH SYSTEM TICK TIMER (CORTEX-M0+ HAS NO DWT CYCLE COUNTER).
+ * @param:	None.
+ * @return:	None.
+ */
+void SYSTICK_StartCycleCount(void) {
+	// Configure free running counter on processor clock without interrupt.
+	SYSTICK -> CSR = 0;
+	SYSTICK -> RVR = SYSTICK_CYCLE_COUNT_MAX;
+	SYSTICK -> CVR = 0; // Any write clears the counter and COUNTFLAG.
+	SYSTICK -> CSR |= (0b1 << 2) | (0b1 << 0); // CLKSOURCE='1' and ENABLE='1'.
+}
+
+/* STOP COUNTING CPU CYCLES.
+ * @param:	None.
+ * @return:	Number of cycles since start (saturated to SYSTICK_CYCLE_COUNT_MAX).
+ */
+unsigned int SYSTICK_StopCycleCount(void) {
+	// Read counter before stopping it.
+	unsigned int current_value = (SYSTICK -> CVR) & SYSTICK_CYCLE_COUNT_MAX;
+	unsigned int count_flag = ((SYSTICK -> CSR) & (0b1 << 16)); // COUNTFLAG.
+	SYSTICK -> CSR = 0;
+	// Counter wrapped: duration is greater than the counter range.
+	if (count_flag != 0) {
+		return SYSTICK_CYCLE_COUNT_MAX;
+	}
+	return (SYSTICK_CYCLE_COUNT_MAX - current_value);
+}
+
+/* START A TIMEOUT WITH SYSTEM TICK TIMER (ITS INTERRUPT WAKES THE CPU UP FROM SLEEP MODE WHEN IT EXPIRES).
+ * @param timeout_cycles:	Timeout in processor clock cycles (saturated to SYSTICK_CYCLE_COUNT_MAX).
+ * @return:					None.
+ */
+void SYSTICK_StartTimeout(unsigned int timeout_cycles) {
+	// Configure counter on processor clock with interrupt (SysTick handler does nothing, it only wakes the CPU up).
+	SYSTICK -> CSR = 0;
+	SYSTICK -> RVR = (timeout_cycles > SYSTICK_CYCLE_COUNT_MAX) ? SYSTICK_CYCLE_COUNT_MAX : timeout_cycles;
+	SYSTICK -> CVR = 0; // Any write clears the counter and COUNTFLAG.
+	SYSTICK -> CSR |= (0b1 << 2) | (0b1 << 1) | (0b1 << 0); // CLKSOURCE='1', TICKINT='1' and ENABLE='1'.
+}
+
+/* CHECK IF TIMEOUT EXPIRED.
+ * @param:	None.
+ * @return:	1 if the timeout expired since the last call, 0 otherwise (COUNTFLAG is cleared by reading).
+ */
+unsigned char SYSTICK_GetTimeoutFlag(void) {
+	return ((((SYSTICK -> CSR) & (0b1 << 16)) != 0) ? 1 : 0);
+}
+
+/* STOP TIMEOUT.
+ * @param:	None.
+ * @return:	None.
+ */
+void SYSTICK_StopTimeout(void) {
+	SYSTICK -> CSR = 0;
+}
@@ -121,6 +121,7 @@ void TIM21_Disable(void) {
 void TIM2_Init(unsigned short timings[TIM2_TIMINGS_ARRAY_LENGTH]) {
 	// Enable peripheral clock.
 	RCC -> APB1ENR |= (0b1 << 0); // TIM2EN='1'.
+	RCC -> APB1SMENR |= (0b1 << 0); // Enable clock in sleep mode (symbols are generated while CPU is sleeping).
 	// Reset timer before configuration.
 	TIM2 -> CR1 &= 0xFFFFFE00; // Disable TIM2 (CEN='0').
 	TIM2 -> CNT &= 0xFFFF0000; // Reset counter.
@@ -9,25 +9,42 @@
 
 #include "adc.h"
 #include "aes.h"
+#include "crypto.h"
 #include "exti.h"
 #include "iwdg.h"
 #include "lptim.h"
 #include "mode.h"
 #include "nvm.h"
 #include "pwr.h"
+#include "radio.h"
+#include "rf_api.h"
 #include "rtc.h"
 #include "sigfox_types.h"
+#include "sx1232.h"
+#include "systick.h"
 #include "usart.h"
 
 /*** MCU API local macros ***/
 
 #define MCU_API_MALLOC_BUFFER_SIZE		200
+#define MCU_API_AES_DMA_BLOCKS_MIN		4 // Under this number of blocks, DMA configuration costs more than CPU transfers.
+#define MCU_API_MEASUREMENT_FRESHNESS_MS	3600000 // Internal ADC measurements are reused during one measurement period.
+// Inter-frame delays (lower bounds allowed by the library, which selects the delay type from the RC spectrum access).
+#define MCU_API_DELAY_INTER_FRAME_TRX_MS	500 // Fixed: FH uplink (RC2, RC4) and bidirectional sequences.
+#define MCU_API_DELAY_INTER_FRAME_TX_MS		0 // 0 to 2s: uplink only sequences in DC and LBT zones.
+#define MCU_API_DELAY_OOB_ACK_MS			1400 // 1.4s to 4s.
+#define MCU_API_DELAY_CS_SLEEP_MS			1000 // Not bounded by the protocol: back-off between carrier sense attempts (RC3C, RC5).
 
 /*** MCU API local structures ***/
 
 typedef struct {
 	sfx_u8 mcu_api_malloc_buffer[MCU_API_MALLOC_BUFFER_SIZE];
 	sfx_u32 mcu_api_timer_duration_seconds;
+	// AES backend and benchmark.
+	MCU_API_AesBackend mcu_api_aes_backend;
+	sfx_u32 mcu_api_aes_calls_count;
+	sfx_u8 mcu_api_aes_number_of_blocks;
+	sfx_u32 mcu_api_aes_cycle_count;
 } MCU_API_Context;
 
 /*** MCU API local global variables ***/
@@ -95,10 +112,13 @@ sfx_u8 MCU_API_free(sfx_u8* ptr) {
  * \retval MCU_ERR_API_VOLT_TEMP:                Get voltage/temperature error
  *******************************************************************/
 sfx_u8 MCU_API_get_voltage_temperature(sfx_u16* voltage_idle, sfx_u16* voltage_tx, sfx_s16* temperature) {
-	// Perform measurements.
-	ADC1_Init();
-	ADC1_PerformAllMeasurements();
-	ADC1_Disable();
+	// Perform measurements only if the last ones are missing or too old.
+	unsigned int measurement_age_ms = 0;
+	if ((ADC1_GetMeasurementAge(&measurement_age_ms) == 0) || (measurement_age_ms > MCU_API_MEASUREMENT_FRESHNESS_MS)) {
+		ADC1_Init();
+		ADC1_PerformAllMeasurements();
+		ADC1_Disable();
+	}
 	// Get MCU supply voltage.
 	unsigned int mcu_supply_voltage_mv = 0;
 	ADC1_GetMcuVoltage(&mcu_supply_voltage_mv);
@@ -126,26 +146,38 @@ sfx_u8 MCU_API_get_voltage_temperature(sfx_u16* voltage_idle, sfx_u16* voltage_t
  * \retval MCU_ERR_API_DLY:                      Delay error
  *******************************************************************/
 sfx_u8 MCU_API_delay(sfx_delay_t delay_type) {
+	// Get minimum delay.
+	unsigned int delay_ms = 0;
 	switch (delay_type) {
 	case SFX_DLY_INTER_FRAME_TX:
 		// 0 to 2s in Uplink DC.
-		LPTIM1_DelayMilliseconds(500, 1);
+		delay_ms = MCU_API_DELAY_INTER_FRAME_TX_MS;
 		break;
 	case SFX_DLY_INTER_FRAME_TRX:
 		// 500 ms in Uplink/Downlink FH & Downlink DC.
-		LPTIM1_DelayMilliseconds(500, 1);
+		delay_ms = MCU_API_DELAY_INTER_FRAME_TRX_MS;
 		break;
 	case SFX_DLY_OOB_ACK:
 		// 1.4s to 4s for Downlink OOB.
-		LPTIM1_DelayMilliseconds(2000, 1);
+		delay_ms = MCU_API_DELAY_OOB_ACK_MS;
 		break;
 	case SFX_DLY_CS_SLEEP:
 		// Delay between several trials of Carrier Sense (for the first frame only).
-		LPTIM1_DelayMilliseconds(1000, 1);
+		delay_ms = MCU_API_DELAY_CS_SLEEP_MS;
 		break;
 	default:
 		break;
 	}
+	if (delay_ms == 0) return SFX_ERR_NONE;
+	// Radio is switched off by RF_API_stop after each frame: switch TCXO on before the end of the gap so that the next RF_API_init finds it warm.
+	if (delay_ms > SX1232_TCXO_WARM_UP_MS) {
+		LPTIM1_DelayMilliseconds((delay_ms - SX1232_TCXO_WARM_UP_MS), 1);
+		delay_ms = SX1232_TCXO_WARM_UP_MS;
+	}
+	if (RADIO_GetState() == RADIO_STATE_OFF) {
+		RADIO_SetState(RADIO_STATE_TCXO_WARM);
+	}
+	LPTIM1_DelayMilliseconds(delay_ms, 1);
 	return SFX_ERR_NONE;
 }
 
@@ -170,21 +202,15 @@ sfx_u8 MCU_API_aes_128_cbc_encrypt(sfx_u8* encrypted_data, sfx_u8* data_to_encry
 	unsigned char byte_idx = 0;
 	unsigned char local_key[AES_BLOCK_SIZE] = {0};
 	unsigned char init_vector[AES_BLOCK_SIZE] = {0};
-	unsigned char data_in[AES_BLOCK_SIZE] = {0};
-	unsigned char data_out[AES_BLOCK_SIZE] = {0};
 	unsigned char number_of_blocks = aes_block_len / AES_BLOCK_SIZE;
-	unsigned char block_idx;
-	unsigned char key_byte = 0;
+	sfx_u8 status = SFX_ERR_NONE;
+	// Start benchmark.
+	SYSTICK_StartCycleCount();
 	// Get accurate key.
 	switch (use_key) {
 		case CREDENTIALS_PRIVATE_KEY:
-			// Retrieve device key from NVM.
-			for (byte_idx=0 ; byte_idx<AES_BLOCK_SIZE ; byte_idx++) {
-				NVM_Enable();
-				NVM_ReadByte(NVM_SIGFOX_KEY_ADDRESS_OFFSET+byte_idx, &key_byte);
-				NVM_Disable();
-				local_key[byte_idx] = key_byte;
-			}
+			// Retrieve device key from NVM RAM copy.
+			NVM_ReadSigfoxKey(local_key);
 			break;
 		case CREDENTIALS_KEY_IN_ARGUMENT:
 			// Use key in argument.
@@ -195,19 +221,24 @@ sfx_u8 MCU_API_aes_128_cbc_encrypt(sfx_u8* encrypted_data, sfx_u8* data_to_encry
 		default:
 			break;
 	}
-	// Perform encryption.
-	AES_Init();
-	for (block_idx=0; block_idx<number_of_blocks ; block_idx++) {
-		// Fill input data and initialization vector with previous result.
-		for (byte_idx=0 ; byte_idx<AES_BLOCK_SIZE; byte_idx++) data_in[byte_idx] = data_to_encrypt[(block_idx * AES_BLOCK_SIZE) + byte_idx];
-		for (byte_idx=0 ; byte_idx<AES_BLOCK_SIZE; byte_idx++) init_vector[byte_idx] = data_out[byte_idx];
-		// Run algorithme.
-		AES_EncodeCbc(data_in, data_out, init_vector, local_key);
-		// Fill output data.
-		for (byte_idx=0 ; byte_idx<AES_BLOCK_SIZE; byte_idx++) encrypted_data[(block_idx * AES_BLOCK_SIZE) + byte_idx] = data_out[byte_idx];
+	// Perform encryption (key and null initialization vector are loaded once for the whole buffer).
+	switch (mcu_api_ctx.mcu_api_aes_backend) {
+		case MCU_API_AES_BACKEND_SOFTWARE:
+			CRYPTO_AesEncodeCbc(data_to_encrypt, encrypted_data, number_of_blocks, init_vector, local_key);
+			break;
+		default:
+			AES_Init();
+			if (AES_EncodeCbcBuffer(data_to_encrypt, encrypted_data, number_of_blocks, init_vector, local_key, ((number_of_blocks < MCU_API_AES_DMA_BLOCKS_MIN) ? AES_TRANSFER_CPU : AES_TRANSFER_DMA)) == AES_TRANSFER_ERROR) {
+				status = MCU_ERR_API_AES;
+			}
+			AES_Disable();
+			break;
 	}
-	AES_Disable();
-	return SFX_ERR_NONE;
+	// Update benchmark.
+	mcu_api_ctx.mcu_api_aes_cycle_count = SYSTICK_StopCycleCount();
+	mcu_api_ctx.mcu_api_aes_number_of_blocks = number_of_blocks;
+	mcu_api_ctx.mcu_api_aes_calls_count++;
+	return status;
 }
 
 /*!******************************************************************
@@ -234,19 +265,18 @@ sfx_u8 MCU_API_get_nv_mem(sfx_u8 read_data[SFX_NVMEM_BLOCK_SIZE]) {
 	// |  PN  |  SEQ  |  FH  |  RL  |
 	// |______|_______|______|______|
 
-	// PN.
+	// Read last valid copy of the Sigfox record (same layout).
+	sfx_u8 nvm_data[NVM_RECORD_SIGFOX_SIZE_BYTES];
+	sfx_u8 idx = 0;
 	NVM_Enable();
-	NVM_ReadByte(NVM_SIGFOX_PN_ADDRESS_OFFSET, &(read_data[SFX_NVMEM_PN]));
-	NVM_ReadByte(NVM_SIGFOX_PN_ADDRESS_OFFSET+1, &(read_data[SFX_NVMEM_PN + 1]));
-	// Sequence number.
-	NVM_ReadByte(NVM_SIGFOX_SEQ_ADDRESS_OFFSET, &(read_data[SFX_NVMEM_MSG_COUNTER]));
-	NVM_ReadByte(NVM_SIGFOX_SEQ_ADDRESS_OFFSET+1, &(read_data[SFX_NVMEM_MSG_COUNTER + 1]));
-	// FH.
-	NVM_ReadByte(NVM_SIGFOX_FH_ADDRESS_OFFSET, &(read_data[SFX_NVMEM_FH]));
-	NVM_ReadByte(NVM_SIGFOX_FH_ADDRESS_OFFSET+1, &(read_data[SFX_NVMEM_FH + 1]));
-	// RL.
-	NVM_ReadByte(NVM_SIGFOX_RL_ADDRESS_OFFSET, &(read_data[SFX_NVMEM_RL]));
+	sfx_u8 valid = NVM_RecordRead(NVM_RECORD_SIGFOX, nvm_data);
 	NVM_Disable();
+	if (valid == 0) {
+		return MCU_ERR_API_GETNVMEM;
+	}
+	for (idx=0 ; idx<SFX_NVMEM_BLOCK_SIZE ; idx++) {
+		read_data[idx] = nvm_data[idx];
+	}
 	return SFX_ERR_NONE;
 }
 
@@ -275,18 +305,14 @@ sfx_u8 MCU_API_set_nv_mem(sfx_u8 data_to_write[SFX_NVMEM_BLOCK_SIZE]) {
 	// |  PN  |  SEQ  |  FH  |  RL  |
 	// |______|_______|______|______|
 
-	// PN.
+	// Write Sigfox record (power-fail atomic, same layout).
+	sfx_u8 nvm_data[NVM_RECORD_SIGFOX_SIZE_BYTES] = {0x00};
+	sfx_u8 idx = 0;
+	for (idx=0 ; idx<SFX_NVMEM_BLOCK_SIZE ; idx++) {
+		nvm_data[idx] = data_to_write[idx];
+	}
 	NVM_Enable();
-	NVM_WriteByte(NVM_SIGFOX_PN_ADDRESS_OFFSET, data_to_write[SFX_NVMEM_PN]);
-	NVM_WriteByte(NVM_SIGFOX_PN_ADDRESS_OFFSET+1, data_to_write[SFX_NVMEM_PN + 1]);
-	// Sequence number.
-	NVM_WriteByte(NVM_SIGFOX_SEQ_ADDRESS_OFFSET, data_to_write[SFX_NVMEM_MSG_COUNTER]);
-	NVM_WriteByte(NVM_SIGFOX_SEQ_ADDRESS_OFFSET+1, data_to_write[SFX_NVMEM_MSG_COUNTER + 1]);
-	// FH.
-	NVM_WriteByte(NVM_SIGFOX_FH_ADDRESS_OFFSET, data_to_write[SFX_NVMEM_FH]);
-	NVM_WriteByte(NVM_SIGFOX_FH_ADDRESS_OFFSET+1, data_to_write[SFX_NVMEM_FH + 1]);
-	// RL.
-	NVM_WriteByte(NVM_SIGFOX_RL_ADDRESS_OFFSET, data_to_write[SFX_NVMEM_RL]);
+	NVM_RecordWrite(NVM_RECORD_SIGFOX, nvm_data);
 	NVM_Disable();
 	return SFX_ERR_NONE;
 }
@@ -303,6 +329,8 @@ sfx_u8 MCU_API_set_nv_mem(sfx_u8 data_to_write[SFX_NVMEM_BLOCK_SIZE]) {
  * \retval MCU_ERR_API_TIMER_START_CS:           Start CS timer error
  *******************************************************************/
 sfx_u8 MCU_API_timer_start_carrier_sense(sfx_u16 time_duration_in_ms) {
+	// Carrier sense window is managed by RF_API_wait_for_clear_channel (LPTIM delays).
+	RF_API_SetCarrierSenseWindow(time_duration_in_ms);
 	return SFX_ERR_NONE;
 }
 
@@ -443,13 +471,8 @@ sfx_u8 MCU_API_get_version(sfx_u8** version, sfx_u8* size) {
  * \retval MCU_ERR_API_GET_ID_PAYLOAD_ENCR_FLAG: Error when getting device ID or payload encryption flag
  *******************************************************************/
 sfx_u8 MCU_API_get_device_id_and_payload_encryption_flag(sfx_u8 dev_id[ID_LENGTH], sfx_bool* payload_encryption_enabled) {
-	// Get device ID.
-	unsigned char byte_idx = 0;
-	for (byte_idx=0 ; byte_idx<ID_LENGTH ; byte_idx++) {
-		NVM_Enable();
-		NVM_ReadByte(NVM_SIGFOX_ID_ADDRESS_OFFSET+byte_idx, &(dev_id[byte_idx]));
-		NVM_Disable();
-	}
+	// Get device ID from NVM RAM copy.
+	NVM_ReadSigfoxId(dev_id);
 	// No payload encryption.
 	(*payload_encryption_enabled) = SFX_FALSE;
 	return SFX_ERR_NONE;
@@ -485,3 +508,35 @@ sfx_u8 MCU_API_get_msg_counter_rollover(e_sfx_msg_counter_rollover* msgCounterRo
 sfx_u8 MCU_API_get_initial_pac(sfx_u8 initial_pac[PAC_LENGTH]) {
 	return SFX_ERR_NONE;
 }
+
+/*!******************************************************************
+ * \fn void MCU_API_GetAesStatistics(sfx_u32* calls_count, sfx_u8* number_of_blocks, sfx_u32* cycle_count)
+ * \brief Get the benchmark of the last MCU_API_aes_128_cbc_encrypt call.
+ *
+ * \param[in] none
+ * \param[out] sfx_u32* calls_count             Number of encryptions performed since start-up
+ * \param[out] sfx_u8* number_of_blocks         Number of blocks encrypted during the last call
+ * \param[out] sfx_u32* cycle_count             Duration of the last call in CPU cycles
+ *
+ * \retval none
+ *******************************************************************/
+void MCU_API_GetAesStatistics(sfx_u32* calls_count, sfx_u8* number_of_blocks, sfx_u32* cycle_count) {
+	(*calls_count) = mcu_api_ctx.mcu_api_aes_calls_count;
+	(*number_of_blocks) = mcu_api_ctx.mcu_api_aes_number_of_blocks;
+	(*cycle_count) = mcu_api_ctx.mcu_api_aes_cycle_count;
+}
+
+/*!******************************************************************
+ * \fn void MCU_API_SetAesBackend(MCU_API_AesBackend aes_backend)
+ * \brief Select the AES-128 implementation used by MCU_API_aes_128_cbc_encrypt.
+ *
+ * \param[in] MCU_API_AesBackend aes_backend    Hardware peripheral (default) or software implementation
+ * \param[out] none
+ *
+ * \retval none
+ *******************************************************************/
+void MCU_API_SetAesBackend(MCU_API_AesBackend aes_backend) {
+	if (aes_backend < MCU_API_AES_BACKEND_LAST) {
+		mcu_api_ctx.mcu_api_aes_backend = aes_backend;
+	}
+}
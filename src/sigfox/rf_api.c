@@ -7,17 +7,19 @@
 
 #include "rf_api.h"
 
+#include "airtime.h"
 #include "gpio.h"
 #include "iwdg.h"
 #include "lptim.h"
 #include "mapping.h"
 #include "mode.h"
 #include "nvic.h"
+#include "nvm.h"
+#include "pwr.h"
+#include "radio.h"
 #include "rtc.h"
 #include "sigfox_api.h"
 #include "sigfox_types.h"
-#include "sky13317.h"
-#include "spi.h"
 #include "sx1232.h"
 #include "tim.h"
 #include "tim_reg.h"
@@ -28,104 +30,333 @@
 #ifdef ATM
 // If defined, print the Sigfox bit stream on UART.
 //#define RF_API_LOG_FRAME
+// If defined, record the actions performed by TIM2 interrupt, check them against the bit stream and print timing margins on UART.
+//#define RF_API_CHECK_WAVEFORM
 #endif
 // Uplink parameters.
 #define RF_API_UPLINK_OUTPUT_POWER_ETSI		14
 #define RF_API_UPLINK_OUTPUT_POWER_FCC		20
+#define RF_API_UPLINK_FRAME_LENGTH_BYTES_MAX	26 // Maximum stream length in Sigfox V1 protocol.
+// Symbol table (2 bits per symbol: one per stream bit + last ramp-down).
+#define RF_API_SYMBOL_ACTION_SIZE_BITS		2
+#define RF_API_SYMBOL_ACTION_MASK			0x03
+#define RF_API_SYMBOL_TABLE_LENGTH_BYTES	((((8 * RF_API_UPLINK_FRAME_LENGTH_BYTES_MAX) + 1) * RF_API_SYMBOL_ACTION_SIZE_BITS + 7) / 8)
+// TIM2 interrupts enabled during a symbol (ARR and CCR1 to CCR3 for phase shift).
+#define RF_API_TIM2_DIER_SYMBOL				(0b1 << TIM2_TIMINGS_ARRAY_ARR_IDX)
+#define RF_API_TIM2_DIER_PHASE_SHIFT		((0b1 << TIM2_TIMINGS_ARRAY_ARR_IDX) | (0b1 << TIM2_TIMINGS_ARRAY_CCR1_IDX) | (0b1 << TIM2_TIMINGS_ARRAY_CCR2_IDX) | (0b1 << TIM2_TIMINGS_ARRAY_CCR3_IDX))
+#define RF_API_TIM2_SR_MASK					0x0000001F
+// Frequency registers table (indexed by symbol action: nominal, low shifted and high shifted frequency).
+#define RF_API_FRF_TABLE_SIZE				3
+#ifdef RF_API_CHECK_WAVEFORM
+// Waveform check (4 bits per symbol: one per event performed in TIM2 interrupt).
+#define RF_API_CHECK_EVENT_SIGNAL_OFF		(0b1 << 0) // CCR1.
+#define RF_API_CHECK_EVENT_SHIFT_LOW		(0b1 << 1) // CCR2.
+#define RF_API_CHECK_EVENT_SHIFT_HIGH		(0b1 << 2) // CCR2.
+#define RF_API_CHECK_EVENT_SIGNAL_ON		(0b1 << 3) // CCR3.
+#define RF_API_CHECK_EVENT_SIZE_BITS		4
+#define RF_API_CHECK_EVENT_TABLE_LENGTH_BYTES	((((8 * RF_API_UPLINK_FRAME_LENGTH_BYTES_MAX) + 1) * RF_API_CHECK_EVENT_SIZE_BITS + 7) / 8)
+#define RF_API_CHECK_LATENCY_ARRAY_LENGTH	4 // ARR and CCR1 to CCR3.
+#endif
 // Downlink parameters.
 #define RF_API_DOWNLINK_FRAME_LENGTH_BYTES	15
 #define RF_API_DOWNLINK_TIMEOUT_SECONDS		25
 #define RF_API_WAIT_FRAME_CALLS_MAX			100
+// Adaptive uplink output power (reduction from maximum power driven by the daily downlink).
+#define RF_API_OUTPUT_POWER_BACKOFF_STEP_DB		2
+#define RF_API_OUTPUT_POWER_RSSI_HIGH_DBM		(-95) // Downlink RSSI above which output power is decreased.
+#define RF_API_OUTPUT_POWER_RSSI_LOW_DBM		(-110) // Downlink RSSI under which output power is increased.
+// Downlink sniffing (preamble lasts 60ms at 600bps). RX slot covers RX start-up from sleep and 1 byte preamble detection.
+// A preamble starting just too late to be detected in a slot must be detected in the next one: sleep + start-up + 2 * detection <= preamble.
+#define RF_API_SNIFF_PREAMBLE_MS				60
+#define RF_API_SNIFF_RX_STARTUP_MS				16
+#define RF_API_SNIFF_PREAMBLE_DETECTION_MS		14
+#define RF_API_SNIFF_RX_SLOT_MS_MIN				(RF_API_SNIFF_RX_STARTUP_MS + RF_API_SNIFF_PREAMBLE_DETECTION_MS)
+#define RF_API_SNIFF_SLEEP_SLOT_MS_MAX			(RF_API_SNIFF_PREAMBLE_MS - RF_API_SNIFF_RX_STARTUP_MS - (2 * RF_API_SNIFF_PREAMBLE_DETECTION_MS))
+#define RF_API_SNIFF_RX_SLOT_MS_DEFAULT			RF_API_SNIFF_RX_SLOT_MS_MIN
+#define RF_API_SNIFF_SLEEP_SLOT_MS_DEFAULT		0 // Continuous RX unless sniffing is enabled with RF_API_SetDownlinkSniffing.
+#define RF_API_SNIFF_EXTENSION_MS				500 // Remaining preamble, sync word and payload at 600bps.
+#define RF_API_SNIFF_EXTENSION_STEP_MS			10
+#define RF_API_SNIFF_IRQ_FLAGS_MASK				0x0300 // PreambleDetect and SyncAddressMatch (IRQFLAGS1 bits 1-0).
+// Carrier sense.
+#define RF_API_CARRIER_SENSE_SAMPLING_PERIOD_MS	1
+#define RF_API_CARRIER_SENSE_RX_STARTUP_MS		1 // Covers TS_FS=60us and TS_RE=1.6ms at 200kHz RX bandwidth (RSSI sampling included).
+#define RF_API_DAY_DURATION_MS					86400000
+// Transceiver configuration images (one per sfx_rf_mode_t value).
+#define RF_API_RF_MODE_NUMBER					4
 
 /*** RF API local structures ***/
 
+// Action performed during a symbol period.
+typedef enum {
+	RF_API_SYMBOL_ACTION_NONE, // Bit '1': signal is kept.
+	RF_API_SYMBOL_ACTION_SHIFT_LOW, // Bit '0': phase inversion through a lower frequency.
+	RF_API_SYMBOL_ACTION_SHIFT_HIGH, // Bit '0': phase inversion through a higher frequency.
+	RF_API_SYMBOL_ACTION_RAMP_DOWN // End of frame.
+} RF_API_SymbolAction;
+
 // Sigfox uplink modulation parameters.
 typedef struct {
 	// Uplink message frequency.
 	unsigned int rf_api_rf_frequency_hz;
 	// Modulation parameters.
 	unsigned short rf_api_symbol_duration_us;
-	volatile unsigned char rf_api_tim2_arr_flag;
 	unsigned short rf_api_ramp_duration_us;
-	volatile unsigned char rf_api_phase_shift_required;
 	unsigned int rf_api_frequency_shift_hz;
-	volatile unsigned char rf_api_frequency_shift_direction;
+	unsigned char rf_api_frf[RF_API_FRF_TABLE_SIZE][SX1232_FRF_SIZE_BYTES];
+	unsigned short rf_api_shift_end_us[RF_API_FRF_TABLE_SIZE]; // CCR3 value of each shift direction.
+	// Symbol table (built before transmission and processed in TIM2 interrupt).
+	unsigned char rf_api_symbol_table[RF_API_SYMBOL_TABLE_LENGTH_BYTES];
+	unsigned short rf_api_symbol_table_size;
+	volatile unsigned short rf_api_symbol_idx;
+	volatile unsigned char rf_api_symbol_action;
+	volatile unsigned char rf_api_frame_end_flag;
+	// TX residency when PA was switched on (airtime measurement).
+	unsigned int rf_api_tx_start_residency_ms;
+#ifdef RF_API_CHECK_WAVEFORM
+	// Events performed for each symbol and maximum interrupt latency of each compare event.
+	unsigned char rf_api_check_event_table[RF_API_CHECK_EVENT_TABLE_LENGTH_BYTES];
+	unsigned short rf_api_check_latency_max_us[RF_API_CHECK_LATENCY_ARRAY_LENGTH];
+#endif
 	// Output power range.
 	signed char rf_api_output_power_min;
 	signed char rf_api_output_power_max;
 	// Downlink.
 	unsigned int rf_api_wait_frame_calls_count;
+	signed short rf_api_downlink_rssi;
+	unsigned char rf_api_downlink_rssi_retrieved;
+	unsigned short rf_api_sniff_rx_slot_ms;
+	unsigned short rf_api_sniff_sleep_slot_ms;
+	// Carrier sense.
+	unsigned short rf_api_carrier_sense_window_ms;
+	unsigned int rf_api_carrier_sense_count;
+	unsigned int rf_api_carrier_sense_last_duration_ms;
+	unsigned int rf_api_carrier_sense_total_duration_ms;
+	// Transceiver configuration images and last configuration benchmark.
+	unsigned char rf_api_configuration_image[RF_API_RF_MODE_NUMBER][SX1232_CONFIGURATION_IMAGE_SIZE];
+	unsigned char rf_api_configuration_image_valid[RF_API_RF_MODE_NUMBER];
+	unsigned char rf_api_configuration_restored;
+	unsigned char rf_api_configuration_registers_written;
+	unsigned short rf_api_configuration_duration_us;
 } RF_API_Context;
 
 /*** RF API local global variables ***/
 
 static RF_API_Context rf_api_ctx;
+static const unsigned int rf_api_tim2_dier[] = {RF_API_TIM2_DIER_SYMBOL, RF_API_TIM2_DIER_PHASE_SHIFT, RF_API_TIM2_DIER_PHASE_SHIFT, RF_API_TIM2_DIER_SYMBOL};
 
 /*** RF API local functions ***/
 
+#ifdef RF_API_CHECK_WAVEFORM
+/* RECORD AN EVENT PERFORMED IN TIM2 INTERRUPT.
+ * @param timing_idx:	Compare event which triggered the interrupt (TIM2_TIMINGS_ARRAY_xxx_IDX).
+ * @param event:		Action performed on the current symbol (RF_API_CHECK_EVENT_xxx mask, 0 for none).
+ * @return:				None.
+ */
+static void RF_API_CheckRecordEvent(unsigned char timing_idx, unsigned char event) {
+	// Symbol index was incremented on ARR event.
+	unsigned short symbol_idx = rf_api_ctx.rf_api_symbol_idx - 1;
+	// Compute latency (counter is reset on ARR event).
+	unsigned short latency_us = (TIM2 -> CNT);
+	if (timing_idx == TIM2_TIMINGS_ARRAY_CCR1_IDX) latency_us -= (TIM2 -> CCR1);
+	if (timing_idx == TIM2_TIMINGS_ARRAY_CCR2_IDX) latency_us -= (TIM2 -> CCR2);
+	if (timing_idx == TIM2_TIMINGS_ARRAY_CCR3_IDX) latency_us -= (TIM2 -> CCR3);
+	if (latency_us > rf_api_ctx.rf_api_check_latency_max_us[timing_idx]) {
+		rf_api_ctx.rf_api_check_latency_max_us[timing_idx] = latency_us;
+	}
+	// Store event.
+	if (symbol_idx < rf_api_ctx.rf_api_symbol_table_size) {
+		rf_api_ctx.rf_api_check_event_table[symbol_idx >> 1] |= (event << ((symbol_idx & 0x01) * RF_API_CHECK_EVENT_SIZE_BITS));
+	}
+}
+#endif
+
 /* TIM2 INTERRUPT HANDLER.
  * @param:	None.
  * @return:	None.
  */
  void __attribute__((optimize("-O0"))) TIM2_IRQHandler(void) {
+	// Read status once.
+	unsigned int tim2_sr = (TIM2 -> SR);
 	// ARR = symbol rate.
-	if (((TIM2 -> SR) & (0b1 << TIM2_TIMINGS_ARRAY_ARR_IDX)) != 0) {
-		// Update ARR flag.
-		rf_api_ctx.rf_api_tim2_arr_flag = 1;
-		// Clear flag.
-		TIM2 -> SR &= ~(0b1 << TIM2_TIMINGS_ARRAY_ARR_IDX);
-	}
-	// CCR1 = ramp down start.
-	else if (((TIM2 -> SR) & (0b1 << TIM2_TIMINGS_ARRAY_CCR1_IDX)) != 0) {
-		// Update ARR flag.
-		rf_api_ctx.rf_api_tim2_arr_flag = 0;
-		// Clear flag.
+	if ((tim2_sr & (0b1 << TIM2_TIMINGS_ARRAY_ARR_IDX)) != 0) {
+		// Clear all flags (compare events of the previous symbol may not have been enabled).
+		TIM2 -> SR &= ~(RF_API_TIM2_SR_MASK);
+		if (rf_api_ctx.rf_api_symbol_idx < rf_api_ctx.rf_api_symbol_table_size) {
+			// Load next symbol action and enable the required compare interrupts.
+			rf_api_ctx.rf_api_symbol_action = (rf_api_ctx.rf_api_symbol_table[rf_api_ctx.rf_api_symbol_idx >> 2] >> ((rf_api_ctx.rf_api_symbol_idx & 0x03) * RF_API_SYMBOL_ACTION_SIZE_BITS)) & RF_API_SYMBOL_ACTION_MASK;
+			TIM2 -> DIER = rf_api_tim2_dier[rf_api_ctx.rf_api_symbol_action];
+			rf_api_ctx.rf_api_symbol_idx++;
+			if (rf_api_ctx.rf_api_symbol_action == RF_API_SYMBOL_ACTION_RAMP_DOWN) {
+				// Turn signal off.
+				GPIO_Write(&GPIO_SX1232_DIO2, 0);
+			}
+#ifdef RF_API_CHECK_WAVEFORM
+			RF_API_CheckRecordEvent(TIM2_TIMINGS_ARRAY_ARR_IDX, 0);
+#endif
+		}
+		else {
+			// Wake-up main context.
+			rf_api_ctx.rf_api_frame_end_flag = 1;
+		}
+	}
+	// CCR1 = ramp down start (only enabled for phase shift symbols).
+	else if ((tim2_sr & (0b1 << TIM2_TIMINGS_ARRAY_CCR1_IDX)) != 0) {
+		// Turn signal off (ramp down is done by the transceiver OOK modulation shaping).
+		GPIO_Write(&GPIO_SX1232_DIO2, 0);
+#ifdef RF_API_CHECK_WAVEFORM
+		RF_API_CheckRecordEvent(TIM2_TIMINGS_ARRAY_CCR1_IDX, RF_API_CHECK_EVENT_SIGNAL_OFF);
+#endif
 		TIM2 -> SR &= ~(0b1 << TIM2_TIMINGS_ARRAY_CCR1_IDX);
-		if (rf_api_ctx.rf_api_phase_shift_required != 0) {
-			// Turn signal off (ramp down is done by the transceiver OOK modulation shaping).
-			GPIO_Write(&GPIO_SX1232_DIO2, 0);
+	}
+	// CCR2 = ramp down end + frequency shift start (only enabled for phase shift symbols).
+	else if ((tim2_sr & (0b1 << TIM2_TIMINGS_ARRAY_CCR2_IDX)) != 0) {
+		// Change frequency (shift end depends on the effective frequency step of each direction).
+		TIM2 -> CCR3 = rf_api_ctx.rf_api_shift_end_us[rf_api_ctx.rf_api_symbol_action];
+		SX1232_WriteFrf(rf_api_ctx.rf_api_frf[rf_api_ctx.rf_api_symbol_action]);
+#ifdef RF_API_CHECK_WAVEFORM
+		RF_API_CheckRecordEvent(TIM2_TIMINGS_ARRAY_CCR2_IDX, ((rf_api_ctx.rf_api_symbol_action == RF_API_SYMBOL_ACTION_SHIFT_LOW) ? RF_API_CHECK_EVENT_SHIFT_LOW : RF_API_CHECK_EVENT_SHIFT_HIGH));
+#endif
+		TIM2 -> SR &= ~(0b1 << TIM2_TIMINGS_ARRAY_CCR2_IDX);
+	}
+	// CCR3 = frequency shift end + ramp-up start (only enabled for phase shift symbols).
+	else if ((tim2_sr & (0b1 << TIM2_TIMINGS_ARRAY_CCR3_IDX)) != 0) {
+		// Come back to uplink frequency.
+		SX1232_WriteFrf(rf_api_ctx.rf_api_frf[RF_API_SYMBOL_ACTION_NONE]);
+		// Turn signal on (ramp up is done by the transceiver OOK modulation shaping).
+		GPIO_Write(&GPIO_SX1232_DIO2, 1);
+#ifdef RF_API_CHECK_WAVEFORM
+		RF_API_CheckRecordEvent(TIM2_TIMINGS_ARRAY_CCR3_IDX, RF_API_CHECK_EVENT_SIGNAL_ON);
+#endif
+		TIM2 -> SR &= ~(0b1 << TIM2_TIMINGS_ARRAY_CCR3_IDX);
+	}
+	else {
+		// Unexpected event.
+		TIM2 -> SR &= ~(tim2_sr & RF_API_TIM2_SR_MASK);
+	}
+}
+
+/* BUILD THE SYMBOL TABLE OF A FRAME.
+ * @param stream:	Bit stream to transmit.
+ * @param size:		Stream length in bytes.
+ * @return:			None.
+ */
+static void RF_API_BuildSymbolTable(sfx_u8* stream, sfx_u8 size) {
+	// Local variables.
+	unsigned short symbol_idx = 0;
+	unsigned char symbol_action = RF_API_SYMBOL_ACTION_NONE;
+	unsigned char next_shift_action = RF_API_SYMBOL_ACTION_SHIFT_LOW;
+	// Reset table.
+	for (symbol_idx=0 ; symbol_idx<RF_API_SYMBOL_TABLE_LENGTH_BYTES ; symbol_idx++) {
+		rf_api_ctx.rf_api_symbol_table[symbol_idx] = 0;
+	}
+	// One symbol per bit followed by last ramp down.
+	rf_api_ctx.rf_api_symbol_table_size = (8 * size) + 1;
+	for (symbol_idx=0 ; symbol_idx<rf_api_ctx.rf_api_symbol_table_size ; symbol_idx++) {
+		if (symbol_idx >= (8 * size)) {
+			symbol_action = RF_API_SYMBOL_ACTION_RAMP_DOWN;
 		}
+		else if ((stream[symbol_idx >> 3] & (0b1 << (7 - (symbol_idx & 0x07)))) == 0) {
+			// Phase shift required if bit is '0' (shift direction is alternated to keep average frequency).
+			symbol_action = next_shift_action;
+			next_shift_action = (next_shift_action == RF_API_SYMBOL_ACTION_SHIFT_LOW) ? RF_API_SYMBOL_ACTION_SHIFT_HIGH : RF_API_SYMBOL_ACTION_SHIFT_LOW;
+		}
+		else {
+			symbol_action = RF_API_SYMBOL_ACTION_NONE;
+		}
+		rf_api_ctx.rf_api_symbol_table[symbol_idx >> 2] |= (symbol_action << ((symbol_idx & 0x03) * RF_API_SYMBOL_ACTION_SIZE_BITS));
 	}
-	// CCR2 = ramp down end + frequency shift start.
-	else if (((TIM2 -> SR) & (0b1 << TIM2_TIMINGS_ARRAY_CCR2_IDX)) != 0) {
-		if (rf_api_ctx.rf_api_phase_shift_required != 0) {
-			// Change frequency.
-			if (rf_api_ctx.rf_api_frequency_shift_direction == 0) {
-				// Decrease frequency.
-				SX1232_SetRfFrequency(rf_api_ctx.rf_api_rf_frequency_hz - rf_api_ctx.rf_api_frequency_shift_hz);
-				rf_api_ctx.rf_api_frequency_shift_direction = 1;
-			}
-			else {
-				// Increase frequency.
-				SX1232_SetRfFrequency(rf_api_ctx.rf_api_rf_frequency_hz + rf_api_ctx.rf_api_frequency_shift_hz);
-				rf_api_ctx.rf_api_frequency_shift_direction = 0;
+	rf_api_ctx.rf_api_symbol_idx = 0;
+	rf_api_ctx.rf_api_symbol_action = RF_API_SYMBOL_ACTION_NONE;
+	rf_api_ctx.rf_api_frame_end_flag = 0;
+#ifdef RF_API_CHECK_WAVEFORM
+	// Reset waveform check.
+	for (symbol_idx=0 ; symbol_idx<RF_API_CHECK_EVENT_TABLE_LENGTH_BYTES ; symbol_idx++) {
+		rf_api_ctx.rf_api_check_event_table[symbol_idx] = 0;
+	}
+	for (symbol_idx=0 ; symbol_idx<RF_API_CHECK_LATENCY_ARRAY_LENGTH ; symbol_idx++) {
+		rf_api_ctx.rf_api_check_latency_max_us[symbol_idx] = 0;
+	}
+#endif
+}
+
+#ifdef RF_API_CHECK_WAVEFORM
+/* CHECK THE EVENTS PERFORMED DURING A FRAME AGAINST THE BIT STREAM AND PRINT RESULT ON UART.
+ * @param stream:			Bit stream which was transmitted.
+ * @param size:				Stream length in bytes.
+ * @param dbpsk_timings:	Timer configuration used during the frame.
+ * @return:					None.
+ */
+static void RF_API_CheckWaveform(sfx_u8* stream, sfx_u8 size, unsigned short dbpsk_timings[TIM2_TIMINGS_ARRAY_LENGTH]) {
+	// Local variables.
+	unsigned short symbol_idx = 0;
+	unsigned char event = 0;
+	unsigned char expected_event = 0;
+	unsigned char next_shift_event = RF_API_CHECK_EVENT_SHIFT_LOW;
+	unsigned short error_count = 0;
+	unsigned short first_error_idx = 0;
+	unsigned char timing_idx = 0;
+	signed int margin_us = 0;
+	// Each '0' bit must be a complete phase inversion (signal off, shift in alternated direction, signal on) and each '1' bit must be left untouched.
+	for (symbol_idx=0 ; symbol_idx<(8 * size) ; symbol_idx++) {
+		event = (rf_api_ctx.rf_api_check_event_table[symbol_idx >> 1] >> ((symbol_idx & 0x01) * RF_API_CHECK_EVENT_SIZE_BITS)) & 0x0F;
+		expected_event = 0;
+		if ((stream[symbol_idx >> 3] & (0b1 << (7 - (symbol_idx & 0x07)))) == 0) {
+			expected_event = (RF_API_CHECK_EVENT_SIGNAL_OFF | next_shift_event | RF_API_CHECK_EVENT_SIGNAL_ON);
+			next_shift_event = (next_shift_event == RF_API_CHECK_EVENT_SHIFT_LOW) ? RF_API_CHECK_EVENT_SHIFT_HIGH : RF_API_CHECK_EVENT_SHIFT_LOW;
+		}
+		if (event != expected_event) {
+			if (error_count == 0) {
+				first_error_idx = symbol_idx;
 			}
+			error_count++;
 		}
-		// Update ARR flag.
-		rf_api_ctx.rf_api_tim2_arr_flag = 0;
-		// Clear flag.
-		TIM2 -> SR &= ~(0b1 << TIM2_TIMINGS_ARRAY_CCR2_IDX);
 	}
-	// CCR3 = frequency shift end + ramp-up start.
-	else if (((TIM2 -> SR) & (0b1 << TIM2_TIMINGS_ARRAY_CCR3_IDX)) != 0) {
-		if (rf_api_ctx.rf_api_phase_shift_required != 0){
-			// Come back to uplink frequency.
-			SX1232_SetRfFrequency(rf_api_ctx.rf_api_rf_frequency_hz);
-			// Turn signal on (ramp up is done by the transceiver OOK modulation shaping).
-			GPIO_Write(&GPIO_SX1232_DIO2, 1);
+	// Print result.
+	USARTx_SendString("DBPSK check: symbols=");
+	USARTx_SendValue((8 * size), USART_FORMAT_DECIMAL, 0);
+	USARTx_SendString(" errors=");
+	USARTx_SendValue(error_count, USART_FORMAT_DECIMAL, 0);
+	if (error_count != 0) {
+		USARTx_SendString(" first_error_symbol=");
+		USARTx_SendValue(first_error_idx, USART_FORMAT_DECIMAL, 0);
+	}
+	// Margin = time between an event and the next one minus the worst interrupt latency.
+	USARTx_SendString("\nDBPSK latency_max_us/margin_us:");
+	for (timing_idx=0 ; timing_idx<RF_API_CHECK_LATENCY_ARRAY_LENGTH ; timing_idx++) {
+		margin_us = ((timing_idx == TIM2_TIMINGS_ARRAY_ARR_IDX) ? 0 : (signed int) dbpsk_timings[timing_idx]);
+		margin_us = ((timing_idx < TIM2_TIMINGS_ARRAY_CCR3_IDX) ? (signed int) dbpsk_timings[timing_idx + 1] : (signed int) dbpsk_timings[TIM2_TIMINGS_ARRAY_ARR_IDX]) - margin_us;
+		margin_us -= (signed int) rf_api_ctx.rf_api_check_latency_max_us[timing_idx];
+		USARTx_SendString(" ");
+		USARTx_SendValue(rf_api_ctx.rf_api_check_latency_max_us[timing_idx], USART_FORMAT_DECIMAL, 0);
+		USARTx_SendString("/");
+		if (margin_us < 0) {
+			USARTx_SendString("-");
+			margin_us = (-margin_us);
 		}
-		// Update ARR flag.
-		rf_api_ctx.rf_api_tim2_arr_flag = 0;
-		// Clear flag.
-		TIM2 -> SR &= ~(0b1 << TIM2_TIMINGS_ARRAY_CCR3_IDX);
+		USARTx_SendValue(margin_us, USART_FORMAT_DECIMAL, 0);
 	}
-	// CCR4 = ramp-up end.
-	else if (((TIM2 -> SR) & (0b1 << TIM2_TIMINGS_ARRAY_CCR4_IDX)) != 0) {
-		// Update ARR flag.
-		rf_api_ctx.rf_api_tim2_arr_flag = 0;
-		// Clear flag.
-		TIM2 -> SR &= ~(0b1 << TIM2_TIMINGS_ARRAY_CCR4_IDX);
+	USARTx_SendString("\n");
+}
+#endif
+
+/* COMPUTE UPLINK OUTPUT POWER.
+ * @param:	None.
+ * @return:	Output power in dBm (maximum power of the current modulation minus stored reduction).
+ */
+static signed char RF_API_GetOutputPower(void) {
+	// Local variables.
+	unsigned char output_power_backoff_db = NVM_GetTxPowerBackoff();
+	signed char output_power_dbm = 0;
+	// Check reduction.
+	if (output_power_backoff_db > NVM_TX_POWER_BACKOFF_MAX_DB) {
+		output_power_backoff_db = NVM_TX_POWER_BACKOFF_MAX_DB;
 	}
+	// Compute power.
+	output_power_dbm = rf_api_ctx.rf_api_output_power_max - ((signed char) output_power_backoff_db);
+	if (output_power_dbm < rf_api_ctx.rf_api_output_power_min) {
+		output_power_dbm = rf_api_ctx.rf_api_output_power_min;
+	}
+	return output_power_dbm;
 }
 
 /* UPDATE PARAMETERS ACCORDING TO MODULATION TYPE.
@@ -134,8 +365,6 @@ static RF_API_Context rf_api_ctx;
  */
 static void RF_API_SetTxModulationParameters(sfx_modulation_type_t modulation) {
 	// Init common parameters.
-	rf_api_ctx.rf_api_phase_shift_required = 0;
-	rf_api_ctx.rf_api_frequency_shift_direction = 0;
 	rf_api_ctx.rf_api_output_power_min = SX1232_OUTPUT_POWER_PABOOST_MIN;
 	// Init timings.
 	switch (modulation) {
@@ -158,64 +387,54 @@ static void RF_API_SetTxModulationParameters(sfx_modulation_type_t modulation) {
 
 }
 
-/* SELECT RF PATH ACCORDING TO RF MODE AND SIGFOX RADIO CONFIGURAION.
+/* START CONTINUOUS WAVE OUTPUT.
  * @param:	None.
- * @return:	None.
+ * @return:	1 in case of success, 0 if the transceiver did not reach TX mode.
+ */
+static unsigned char RF_API_StartCw(void) {
+	// Start data signal and radio.
+	GPIO_Write(&GPIO_SX1232_DIO2, 1);
+	rf_api_ctx.rf_api_tx_start_residency_ms = RADIO_GetResidency(RADIO_STATE_TX);
+	return RADIO_SetState(RADIO_STATE_TX);
+}
+
+/* STOP CONTINUOUS WAVE OUTPUT.
+ * @param:	None.
+ * @return:	1 in case of success, 0 if the transceiver did not reach standby mode.
+ */
+static unsigned char RF_API_StopCw(void) {
+	// Stop data signal and radio.
+	GPIO_Write(&GPIO_SX1232_DIO2, 0);
+	LPTIM1_DelayMilliseconds(2, 1); // Wait ramp down.
+	unsigned char status = RADIO_SetState(RADIO_STATE_STANDBY);
+	// Feed duty cycle ledger with effective PA on time.
+	AIRTIME_Record(RADIO_GetResidency(RADIO_STATE_TX) - rf_api_ctx.rf_api_tx_start_residency_ms);
+	return status;
+}
+
+/* CONFIGURE RSSI MEASUREMENT FOR A GIVEN RF MODE.
+ * @param rf_mode:	RF mode to configure.
+ * @return:			None.
  */
-static void RF_API_SetRfPath(sfx_rf_mode_t rf_mode) {
-	// Select TX / RX.
+static void RF_API_ConfigureRssi(sfx_rf_mode_t rf_mode) {
 	switch (rf_mode) {
-	case SFX_RF_MODE_TX:
-		// Select TX path.
-		SX1232_SelectRfOutputPin(SX1232_RF_OUTPUT_PIN_PABOOST);
-#ifdef HW1_0
-		SKY13317_SetChannel(SKY13317_CHANNEL_RF1);
-#endif
-#ifdef HW2_0
-		SKY13317_SetChannel(SKY13317_CHANNEL_RF2);
-#endif
-		break;
 	case SFX_RF_MODE_RX:
-		// Activate LNA path.
-#ifdef HW1_0
-		SKY13317_SetChannel(SKY13317_CHANNEL_RF2);
-#endif
-#ifdef HW2_0
-		SKY13317_SetChannel(SKY13317_CHANNEL_RF3);
-#endif
+		SX1232_ConfigureRssi(SX1232_RSSI_OFFSET_DB, SX1232_RSSI_SAMPLING_32);
+		break;
+	case SFX_RF_MODE_CS200K_RX:
+	case SFX_RF_MODE_CS300K_RX:
+		SX1232_ConfigureRssi(SX1232_RSSI_OFFSET_DB, SX1232_RSSI_SAMPLING_8);
 		break;
 	default:
-		// Disable every channel.
-		SKY13317_SetChannel(SKY13317_CHANNEL_NONE);
 		break;
 	}
 }
 
-/*** RF API functions ***/
-
-/*!******************************************************************
- * \fn sfx_u8 RF_API_init(sfx_rf_mode_t rf_mode)
- * \brief Init and configure Radio link in RX/TX
- *
- * [RX Configuration]
- * To receive Sigfox Frame on your device, program the following:
- *  - Preamble  : 0xAAAAAAAAA
- *  - Sync Word : 0xB227
- *  - Packet of the Sigfox frame is 15 bytes length.
- *
- * \param[in] sfx_rf_mode_t rf_mode         Init Radio link in Tx or RX
- * \param[out] none
- *
- * \retval SFX_ERR_NONE:             No error
- * \retval RF_ERR_API_INIT:          Init Radio link error
- *******************************************************************/
-sfx_u8 RF_API_init(sfx_rf_mode_t rf_mode) {
-	// Switch RF on and init transceiver.
-	SPI1_PowerOn();
-	SX1232_SetOscillator(SX1232_OSCILLATOR_TCXO);
-	// Configure switch.
-	RF_API_SetRfPath(rf_mode);
-	// Configure transceiver.
+/* CONFIGURE TRANSCEIVER FOR A GIVEN RF MODE.
+ * @param rf_mode:	RF mode to configure.
+ * @return:			None.
+ */
+static void RF_API_Configure(sfx_rf_mode_t rf_mode) {
 	unsigned char downlink_sync_word[2] = {0xB2, 0x27};
 	switch (rf_mode) {
 	// Uplink.
@@ -229,24 +448,181 @@ sfx_u8 RF_API_init(sfx_rf_mode_t rf_mode) {
 		break;
 	// Downlink.
 	case SFX_RF_MODE_RX:
-		// Reset call counter.
-		rf_api_ctx.rf_api_wait_frame_calls_count = 0;
 		// Prepare transceiver for downlink operation (GFSK 800Hz 600bps).
 		SX1232_SetModulation(SX1232_MODULATION_FSK, SX1232_MODULATION_SHAPING_FSK_BT_1);
 		SX1232_SetFskDeviation(800);
 		SX1232_SetBitRate(600);
 		SX1232_SetRxBandwidth(SX1232_RXBW_MANTISSA_24, SX1232_RXBW_EXPONENT_MAX);
 		SX1232_EnableLnaBoost(1);
-		SX1232_ConfigureRssi(SX1232_RSSI_OFFSET_DB, SX1232_RSSI_SAMPLING_32);
+		RF_API_ConfigureRssi(rf_mode);
 		SX1232_SetPreambleDetector(1, 0);
 		SX1232_SetSyncWord(downlink_sync_word, 2);
 		SX1232_SetDataLength(RF_API_DOWNLINK_FRAME_LENGTH_BYTES);
 		SX1232_SetDioMapping(0, 0); // Map payload ready interrupt on DIO0.
+		SX1232_SetDioMapping(2, 3); // Map sync address interrupt on DIO2.
 		SX1232_SetDataMode(SX1232_DATA_MODE_PACKET);
 		break;
+	// Carrier sense.
+	case SFX_RF_MODE_CS200K_RX:
+	case SFX_RF_MODE_CS300K_RX:
+		// Prepare transceiver for RSSI measurement only (RXBW=200kHz or 333kHz).
+		SX1232_SetModulation(SX1232_MODULATION_FSK, SX1232_MODULATION_SHAPING_NONE);
+		if (rf_mode == SFX_RF_MODE_CS200K_RX) {
+			SX1232_SetRxBandwidth(SX1232_RXBW_MANTISSA_20, 1);
+		}
+		else {
+			SX1232_SetRxBandwidth(SX1232_RXBW_MANTISSA_24, 0);
+		}
+		SX1232_EnableLnaBoost(1);
+		RF_API_ConfigureRssi(rf_mode);
+		SX1232_SetDataMode(SX1232_DATA_MODE_CONTINUOUS);
+		break;
 	default:
 		break;
 	}
+}
+
+/* WAIT FOR DOWNLINK FRAME IN CONTINUOUS RX.
+ * @param rssi:				Pointer that will contain the RSSI of the frame.
+ * @param rssi_retrieved:	Pointer set to 1 if RSSI was read on sync word detection.
+ * @return:					1 in case of success, 0 if the transceiver did not reach RX mode.
+ */
+static unsigned char RF_API_ListenDownlink(sfx_s16* rssi, unsigned char* rssi_retrieved) {
+	// Go to RX state.
+	if (RADIO_SetState(RADIO_STATE_RX) == 0) return 0;
+	// Wait for external interrupts (sync address on DIO2 and payload ready on DIO0).
+	SX1232_EnableDioInterrupts();
+	unsigned int remaining_delay = RF_API_DOWNLINK_TIMEOUT_SECONDS;
+	unsigned int sub_delay = 0;
+	while ((remaining_delay > 0) && (SX1232_GetDio0Flag() == 0) && (GPIO_Read(&GPIO_SX1232_DIO0) == 0)) {
+		// Compute sub-delay.
+		sub_delay = (remaining_delay > IWDG_REFRESH_PERIOD_SECONDS) ? (IWDG_REFRESH_PERIOD_SECONDS) : (remaining_delay);
+		remaining_delay -= sub_delay;
+		// Start wake-up timer.
+		RTC_StartWakeUpTimer(sub_delay);
+		while ((RTC_GetWakeUpTimerFlag() == 0) && (SX1232_GetDio0Flag() == 0)) {
+			// Enter stop mode until next transceiver event or sub-delay expiration.
+			PWR_EnterStopMode();
+			// Get RSSI when sync word is found.
+			if ((SX1232_GetDio2Flag() != 0) && ((*rssi_retrieved) == 0)) {
+				(*rssi) = (sfx_s16) ((-1) * SX1232_GetRssi());
+				(*rssi_retrieved) = 1;
+			}
+		}
+		// Sub-delay reached: clear watchdog and flags.
+		IWDG_Reload();
+		RTC_ClearWakeUpTimerFlag();
+	}
+	// Stop timer and interrupts.
+	RTC_StopWakeUpTimer();
+	RTC_ClearWakeUpTimerFlag();
+	SX1232_DisableDioInterrupts();
+	return 1;
+}
+
+/* WAIT FOR DOWNLINK FRAME WITH DUTY-CYCLED RX (RX SLOTS ALTERNATED WITH TRANSCEIVER SLEEP).
+ * @param rssi:				Pointer that will contain the RSSI of the frame.
+ * @param rssi_retrieved:	Pointer set to 1 if RSSI was read on sync word detection.
+ * @return:					1 in case of success, 0 if the transceiver did not reach RX mode.
+ */
+static unsigned char RF_API_SniffDownlink(sfx_s16* rssi, unsigned char* rssi_retrieved) {
+	unsigned int elapsed_ms = 0;
+	unsigned short extension_ms = 0;
+	unsigned char status = 1;
+	// DIO2 is driven by the transceiver during all RX slots.
+	SX1232_EnableDioInterrupts();
+	while ((elapsed_ms < (RF_API_DOWNLINK_TIMEOUT_SECONDS * 1000)) && (GPIO_Read(&GPIO_SX1232_DIO0) == 0)) {
+		// Listen during RX slot.
+		status = RADIO_SetState(RADIO_STATE_RX);
+		if (status == 0) break;
+		LPTIM1_DelayMilliseconds(rf_api_ctx.rf_api_sniff_rx_slot_ms, 1);
+		elapsed_ms += rf_api_ctx.rf_api_sniff_rx_slot_ms;
+		if ((SX1232_GetIrqFlags() & RF_API_SNIFF_IRQ_FLAGS_MASK) != 0) {
+			// Preamble detected: extend RX until payload ready or extension expiration.
+			SX1232_EnableDioInterrupts();
+			extension_ms = 0;
+			while ((extension_ms < RF_API_SNIFF_EXTENSION_MS) && (GPIO_Read(&GPIO_SX1232_DIO0) == 0)) {
+				LPTIM1_DelayMilliseconds(RF_API_SNIFF_EXTENSION_STEP_MS, 1);
+				extension_ms += RF_API_SNIFF_EXTENSION_STEP_MS;
+				// Get RSSI when sync word is found.
+				if ((SX1232_GetDio2Flag() != 0) && ((*rssi_retrieved) == 0)) {
+					(*rssi) = (sfx_s16) ((-1) * SX1232_GetRssi());
+					(*rssi_retrieved) = 1;
+				}
+			}
+			elapsed_ms += extension_ms;
+		}
+		if (GPIO_Read(&GPIO_SX1232_DIO0) == 0) {
+			// Nothing received: transceiver sleeps until next RX slot (leaving RX also clears preamble and sync address flags of a failed extension).
+			RADIO_SetState(RADIO_STATE_SLEEP);
+			(*rssi_retrieved) = 0; // RSSI of a frame which was not received is not relevant.
+			LPTIM1_DelayMilliseconds(rf_api_ctx.rf_api_sniff_sleep_slot_ms, 1);
+			elapsed_ms += rf_api_ctx.rf_api_sniff_sleep_slot_ms;
+		}
+		IWDG_Reload();
+	}
+	SX1232_DisableDioInterrupts();
+	return status;
+}
+
+/*** RF API functions ***/
+
+/*!******************************************************************
+ * \fn sfx_u8 RF_API_init(sfx_rf_mode_t rf_mode)
+ * \brief Init and configure Radio link in RX/TX
+ *
+ * [RX Configuration]
+ * To receive Sigfox Frame on your device, program the following:
+ *  - Preamble  : 0xAAAAAAAAA
+ *  - Sync Word : 0xB227
+ *  - Packet of the Sigfox frame is 15 bytes length.
+ *
+ * \param[in] sfx_rf_mode_t rf_mode         Init Radio link in Tx or RX
+ * \param[out] none
+ *
+ * \retval SFX_ERR_NONE:             No error
+ * \retval RF_ERR_API_INIT:          Init Radio link error
+ *******************************************************************/
+sfx_u8 RF_API_init(sfx_rf_mode_t rf_mode) {
+	// Switch RF on and init transceiver (TCXO input is selected by the radio power manager).
+	if (RADIO_SetState(RADIO_STATE_STANDBY) == 0) return RF_ERR_API_INIT;
+	// Select PA output.
+	if (rf_mode == SFX_RF_MODE_TX) {
+		SX1232_SelectRfOutputPin(SX1232_RF_OUTPUT_PIN_PABOOST);
+	}
+	// Reset downlink call counter.
+	if (rf_mode == SFX_RF_MODE_RX) {
+		rf_api_ctx.rf_api_wait_frame_calls_count = 0;
+		rf_api_ctx.rf_api_downlink_rssi_retrieved = 0;
+		// Use default duty ratio if not configured.
+		if (rf_api_ctx.rf_api_sniff_rx_slot_ms == 0) {
+			rf_api_ctx.rf_api_sniff_rx_slot_ms = RF_API_SNIFF_RX_SLOT_MS_DEFAULT;
+			rf_api_ctx.rf_api_sniff_sleep_slot_ms = RF_API_SNIFF_SLEEP_SLOT_MS_DEFAULT;
+		}
+	}
+	// Configure transceiver (duration is measured with TIM2 which is free before the frame).
+	unsigned short configuration_timings[TIM2_TIMINGS_ARRAY_LENGTH] = {0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF};
+	TIM2_Init(configuration_timings);
+	TIM2_Start();
+	if (rf_mode < RF_API_RF_MODE_NUMBER) {
+		if (rf_api_ctx.rf_api_configuration_image_valid[rf_mode] != 0) {
+			// Restore validated image (only registers which differ are written).
+			rf_api_ctx.rf_api_configuration_registers_written = SX1232_RestoreConfiguration(rf_api_ctx.rf_api_configuration_image[rf_mode]);
+			rf_api_ctx.rf_api_configuration_restored = 1;
+			// RSSI offset is a driver setting (reset by SX1232_Init) which is not part of the image.
+			RF_API_ConfigureRssi(rf_mode);
+		}
+		else {
+			// First configuration of this mode: program all parameters and save image.
+			RF_API_Configure(rf_mode);
+			SX1232_SaveConfiguration(rf_api_ctx.rf_api_configuration_image[rf_mode]);
+			rf_api_ctx.rf_api_configuration_image_valid[rf_mode] = 1;
+			rf_api_ctx.rf_api_configuration_registers_written = 0;
+			rf_api_ctx.rf_api_configuration_restored = 0;
+		}
+	}
+	rf_api_ctx.rf_api_configuration_duration_us = TIM2_GetCounter();
+	TIM2_Disable();
 	return SFX_ERR_NONE;
 }
 
@@ -261,11 +637,8 @@ sfx_u8 RF_API_init(sfx_rf_mode_t rf_mode) {
  * \retval RF_ERR_API_STOP:           Close Radio link error
  *******************************************************************/
 sfx_u8 RF_API_stop(void) {
-	// Disable all switch channels.
-	SKY13317_SetChannel(SKY13317_CHANNEL_NONE);
-	// Power transceiver down.
-	SX1232_SetMode(SX1232_MODE_STANDBY);
-	SPI1_PowerOff();
+	// Power transceiver, TCXO and RF switch down.
+	if (RADIO_SetState(RADIO_STATE_OFF) == 0) return RF_ERR_API_STOP;
 	return SFX_ERR_NONE;
 }
 
@@ -287,6 +660,9 @@ sfx_u8 RF_API_stop(void) {
  * \retval RF_ERR_API_SEND:                 Send data stream error
  *******************************************************************/
 sfx_u8 RF_API_send(sfx_u8 *stream, sfx_modulation_type_t type, sfx_u8 size) {
+	// Check parameters.
+	if (size > RF_API_UPLINK_FRAME_LENGTH_BYTES_MAX) return RF_ERR_API_SEND;
+	sfx_error_t sfx_err = SFX_ERR_NONE;
 	// Disable all interrupts.
 #ifdef ATM
 #ifdef HW1_0
@@ -301,22 +677,23 @@ sfx_u8 RF_API_send(sfx_u8 *stream, sfx_modulation_type_t type, sfx_u8 size) {
 	NVIC_DisableInterrupt(NVIC_IT_DMA1_CH_4_7);
 	NVIC_DisableInterrupt(NVIC_IT_EXTI_4_15);
 	NVIC_DisableInterrupt(NVIC_IT_LPUART1);
-	// Set modulation parameters.
+	// Set modulation parameters and build symbol table.
 	RF_API_SetTxModulationParameters(type);
-	// Init common variables.
-	unsigned char stream_byte_idx = 0;
-	unsigned char stream_bit_idx = 0;
+	RF_API_BuildSymbolTable(stream, size);
 #ifdef RF_API_LOG_FRAME
-	// Frame buffer (maximum length is 26 bytes in Sigfox V1 protocol).
-	unsigned char sfx_frame[26] = {0x00};
+	unsigned char stream_byte_idx = 0;
 #endif
+	// Precompute frequency registers used during the frame.
+	SX1232_ComputeFrf(rf_api_ctx.rf_api_rf_frequency_hz, rf_api_ctx.rf_api_frf[RF_API_SYMBOL_ACTION_NONE]);
+	SX1232_ComputeFrf((rf_api_ctx.rf_api_rf_frequency_hz - rf_api_ctx.rf_api_frequency_shift_hz), rf_api_ctx.rf_api_frf[RF_API_SYMBOL_ACTION_SHIFT_LOW]);
+	SX1232_ComputeFrf((rf_api_ctx.rf_api_rf_frequency_hz + rf_api_ctx.rf_api_frequency_shift_hz), rf_api_ctx.rf_api_frf[RF_API_SYMBOL_ACTION_SHIFT_HIGH]);
 	// Compute frequency shift duration required to invert signal phase.
 	// Compensate transceiver synthetizer step by programming and reading effective frequencies.
-	SX1232_SetRfFrequency(rf_api_ctx.rf_api_rf_frequency_hz);
+	SX1232_WriteFrf(rf_api_ctx.rf_api_frf[RF_API_SYMBOL_ACTION_NONE]);
 	unsigned int effective_uplink_frequency_hz = SX1232_GetRfFrequency();
-	SX1232_SetRfFrequency(rf_api_ctx.rf_api_rf_frequency_hz + rf_api_ctx.rf_api_frequency_shift_hz);
+	SX1232_WriteFrf(rf_api_ctx.rf_api_frf[RF_API_SYMBOL_ACTION_SHIFT_HIGH]);
 	unsigned int effective_high_shifted_frequency_hz = SX1232_GetRfFrequency();
-	SX1232_SetRfFrequency(rf_api_ctx.rf_api_rf_frequency_hz - rf_api_ctx.rf_api_frequency_shift_hz);
+	SX1232_WriteFrf(rf_api_ctx.rf_api_frf[RF_API_SYMBOL_ACTION_SHIFT_LOW]);
 	unsigned int effective_low_shifted_frequency_hz = SX1232_GetRfFrequency();
 	// Compute average durations = 1 / (2 * delta_f).
 	unsigned short high_shifted_frequency_duration_us = (1000000) / (2 * (effective_high_shifted_frequency_hz - effective_uplink_frequency_hz));
@@ -333,50 +710,37 @@ sfx_u8 RF_API_send(sfx_u8 *stream, sfx_modulation_type_t type, sfx_u8 size) {
 	dbpsk_timings[TIM2_TIMINGS_ARRAY_CCR2_IDX] = dbpsk_timings[1] + rf_api_ctx.rf_api_ramp_duration_us;
 	dbpsk_timings[TIM2_TIMINGS_ARRAY_CCR3_IDX] = dbpsk_timings[2] + frequency_shift_duration_us;
 	dbpsk_timings[TIM2_TIMINGS_ARRAY_CCR4_IDX] = dbpsk_timings[3] + rf_api_ctx.rf_api_ramp_duration_us;
+	// Synthetizer steps are not symmetric around the uplink frequency: each direction keeps its own shift duration.
+	rf_api_ctx.rf_api_shift_end_us[RF_API_SYMBOL_ACTION_NONE] = dbpsk_timings[TIM2_TIMINGS_ARRAY_CCR3_IDX];
+	rf_api_ctx.rf_api_shift_end_us[RF_API_SYMBOL_ACTION_SHIFT_LOW] = dbpsk_timings[TIM2_TIMINGS_ARRAY_CCR2_IDX] + low_shifted_frequency_duration_us;
+	rf_api_ctx.rf_api_shift_end_us[RF_API_SYMBOL_ACTION_SHIFT_HIGH] = dbpsk_timings[TIM2_TIMINGS_ARRAY_CCR2_IDX] + high_shifted_frequency_duration_us;
 	TIM2_Init(dbpsk_timings);
 	TIM2_Enable();
+	TIM2 -> DIER = RF_API_TIM2_DIER_SYMBOL; // First ramp-up.
 	NVIC_EnableInterrupt(NVIC_IT_TIM2);
-	rf_api_ctx.rf_api_tim2_arr_flag = 0;
 	// Start CW.
-	SX1232_SetRfFrequency(rf_api_ctx.rf_api_rf_frequency_hz);
-	SX1232_SetRfOutputPower(rf_api_ctx.rf_api_output_power_max);
-	SX1232_StartCw();
-	// First ramp-up.
-	rf_api_ctx.rf_api_tim2_arr_flag = 0;
-	rf_api_ctx.rf_api_phase_shift_required = 0;
-	TIM2_Start();
-	while (rf_api_ctx.rf_api_tim2_arr_flag == 0);
-	// Data transmission.
-	// Byte loop.
-	for (stream_byte_idx=0 ; stream_byte_idx<size ; stream_byte_idx++) {
-#ifdef RF_API_LOG_FRAME
-		// Store byte.
-		sfx_frame[stream_byte_idx] = stream[stream_byte_idx];
-#endif
-		// Bit loop.
-		for (stream_bit_idx=0 ; stream_bit_idx<8 ; stream_bit_idx++) {
-			// Clear ARR flag.
-			rf_api_ctx.rf_api_tim2_arr_flag = 0;
-			// Phase shift required is bit is '0'.
-			if ((stream[stream_byte_idx] & (0b1 << (7-stream_bit_idx))) == 0) {
-				rf_api_ctx.rf_api_phase_shift_required = 1;
-			}
-			else {
-				rf_api_ctx.rf_api_phase_shift_required = 0;
-			}
-			// Wait the end of symbol period.
-			while (rf_api_ctx.rf_api_tim2_arr_flag == 0);
+	SX1232_WriteFrf(rf_api_ctx.rf_api_frf[RF_API_SYMBOL_ACTION_NONE]);
+	SX1232_SetRfOutputPower(RF_API_GetOutputPower());
+	if (RF_API_StartCw() != 0) {
+		// First ramp-up.
+		TIM2_Start();
+		// Data transmission is performed in TIM2 interrupt: enter sleep mode until the end of the frame.
+		while (rf_api_ctx.rf_api_frame_end_flag == 0) {
+			PWR_EnterSleepMode();
 		}
 	}
-	// Last ramp down.
-	rf_api_ctx.rf_api_tim2_arr_flag = 0;
-	rf_api_ctx.rf_api_phase_shift_required = 0;
-	GPIO_Write(&GPIO_SX1232_DIO2, 0);
-	while (rf_api_ctx.rf_api_tim2_arr_flag == 0);
+	else {
+		sfx_err = RF_ERR_API_SEND;
+	}
 	// Stop CW.
-	SX1232_StopCw();
+	if (RF_API_StopCw() == 0) {
+		sfx_err = RF_ERR_API_SEND;
+	}
 	TIM2_Stop();
 	TIM2_Disable();
+#ifdef RF_API_CHECK_WAVEFORM
+	RF_API_CheckWaveform(stream, size, dbpsk_timings);
+#endif
 	// Re-enable all interrupts.
 	NVIC_EnableInterrupt(NVIC_IT_RTC);
 #ifdef ATM
@@ -391,14 +755,14 @@ sfx_u8 RF_API_send(sfx_u8 *stream, sfx_modulation_type_t type, sfx_u8 size) {
 	// Print frame on UART.
 	USARTx_SendString("Uplink frame = [");
 	for (stream_byte_idx=0 ; stream_byte_idx<size ; stream_byte_idx++) {
-		USARTx_SendValue(sfx_frame[stream_byte_idx], USART_FORMAT_HEXADECIMAL, 1);
+		USARTx_SendValue(stream[stream_byte_idx], USART_FORMAT_HEXADECIMAL, 1);
 		if (stream_byte_idx < (size - 1)) {
 			USARTx_SendString(" ");
 		}
 	}
 	USARTx_SendString("]\n");
 #endif
-	return SFX_ERR_NONE;
+	return sfx_err;
 }
 
 /*!******************************************************************
@@ -414,7 +778,7 @@ sfx_u8 RF_API_send(sfx_u8 *stream, sfx_modulation_type_t type, sfx_u8 size) {
 sfx_u8 RF_API_start_continuous_transmission (sfx_modulation_type_t type) {
 	// Start CW.
 	SX1232_SetRfOutputPower(rf_api_ctx.rf_api_output_power_max);
-	SX1232_StartCw();
+	if (RF_API_StartCw() == 0) return RF_ERR_API_START_CONTINUOUS_TRANSMISSION;
 	return SFX_ERR_NONE;
 }
 
@@ -427,7 +791,7 @@ sfx_u8 RF_API_start_continuous_transmission (sfx_modulation_type_t type) {
  *******************************************************************/
 sfx_u8 RF_API_stop_continuous_transmission (void) {
 	// Stop CW.
-	SX1232_StopCw();
+	if (RF_API_StopCw() == 0) return RF_ERR_API_STOP_CONTINUOUS_TRANSMISSION;
 	return SFX_ERR_NONE;
 }
 
@@ -472,6 +836,7 @@ sfx_u8 RF_API_change_frequency(sfx_u32 frequency) {
  *                                            if a frame has been received, as defined in sigfox_api.h file.
  *
  * \retval SFX_ERR_NONE:                      No error
+ * \retval RF_ERR_API_WAIT_FRAME:             Timeout or transceiver did not reach RX mode
  *******************************************************************/
 sfx_u8 RF_API_wait_frame(sfx_u8 *frame, sfx_s16 *rssi, sfx_rx_state_enum_t * state) {
 	// Init state.
@@ -480,40 +845,26 @@ sfx_u8 RF_API_wait_frame(sfx_u8 *frame, sfx_s16 *rssi, sfx_rx_state_enum_t * sta
 	// Manage call count.
 	rf_api_ctx.rf_api_wait_frame_calls_count++;
 	if (rf_api_ctx.rf_api_wait_frame_calls_count < RF_API_WAIT_FRAME_CALLS_MAX) {
-		// Go to TX state.
-		SX1232_SetMode(SX1232_MODE_FSRX);
-		LPTIM1_DelayMilliseconds(5, 1); // Wait TS_FS=60us typical.
-		SX1232_SetMode(SX1232_MODE_RX);
-		LPTIM1_DelayMilliseconds(5, 1); // Wait TS_TR=120us typical.
-		// Wait for external interrupt (payload ready on DIO0).
+		// Listen until downlink frame is received or window expires.
 		unsigned char rssi_retrieved = 0;
-		unsigned int remaining_delay = RF_API_DOWNLINK_TIMEOUT_SECONDS;
-		unsigned int sub_delay = 0;
-		while ((remaining_delay > 0) && (GPIO_Read(&GPIO_SX1232_DIO0) == 0)) {
-			// Compute sub-delay.
-			sub_delay = (remaining_delay > IWDG_REFRESH_PERIOD_SECONDS) ? (IWDG_REFRESH_PERIOD_SECONDS) : (remaining_delay);
-			remaining_delay -= sub_delay;
-			// Start wake-up timer.
-			RTC_StartWakeUpTimer(sub_delay);
-			while (RTC_GetWakeUpTimerFlag() == 0) {
-				// Get RSSI when preamble is found.
-				if (((SX1232_GetIrqFlags() & 0x0200) != 0) && (rssi_retrieved == 0)) {
-					(*rssi) = (sfx_s16) ((-1) * SX1232_GetRssi());
-					rssi_retrieved = 1;
-				}
-			}
-			// Sub-delay reached: clear watchdog and flags.
-			IWDG_Reload();
-			RTC_ClearWakeUpTimerFlag();
+		unsigned char radio_status = 0;
+		if (rf_api_ctx.rf_api_sniff_sleep_slot_ms == 0) {
+			radio_status = RF_API_ListenDownlink(rssi, &rssi_retrieved);
+		}
+		else {
+			radio_status = RF_API_SniffDownlink(rssi, &rssi_retrieved);
 		}
-		// Stop timer.
-		RTC_StopWakeUpTimer();
 		// Check GPIO.
-		if (GPIO_Read(&GPIO_SX1232_DIO0) != 0) {
+		if ((radio_status != 0) && (GPIO_Read(&GPIO_SX1232_DIO0) != 0)) {
 			// Downlink frame received.
 			(*state) = DL_PASSED;
 			sfx_err = SFX_ERR_NONE;
 			SX1232_ReadFifo(frame, RF_API_DOWNLINK_FRAME_LENGTH_BYTES);
+			if (rssi_retrieved != 0) {
+				// Output power is updated once the frame is authenticated (see RF_API_UpdateOutputPower).
+				rf_api_ctx.rf_api_downlink_rssi = (*rssi);
+				rf_api_ctx.rf_api_downlink_rssi_retrieved = 1;
+			}
 #ifdef RF_API_LOG_FRAME
 		// Print frame on UART.
 		USARTx_SendString("Downlink frame = [");
@@ -551,9 +902,50 @@ sfx_u8 RF_API_wait_frame(sfx_u8 *frame, sfx_s16 *rssi, sfx_rx_state_enum_t * sta
  *                                            as per defined in sigfox_api.h file.
  *
  * \retval SFX_ERR_NONE:                      No error
+ * \retval RF_ERR_API_WAIT_CLEAR_CHANNEL:     Transceiver did not reach RX or standby mode
  *******************************************************************/
 sfx_u8 RF_API_wait_for_clear_channel(sfx_u8 cs_min, sfx_s8 cs_threshold, sfx_rx_state_enum_t * state) {
-	return SFX_ERR_NONE;
+	// Local variables.
+	unsigned short window_ms = rf_api_ctx.rf_api_carrier_sense_window_ms;
+	unsigned int start_time_ms = 0;
+	unsigned int elapsed_ms = 0;
+	unsigned short clear_duration_ms = 0;
+	signed short rssi_dbm = 0;
+	// Init state.
+	(*state) = DL_TIMEOUT;
+	if (window_ms < cs_min) {
+		window_ms = cs_min;
+	}
+	// Go to RX state.
+	if (RADIO_SetState(RADIO_STATE_RX) == 0) return RF_ERR_API_WAIT_CLEAR_CHANNEL;
+	LPTIM1_DelayMilliseconds(RF_API_CARRIER_SENSE_RX_STARTUP_MS, 1);
+	// Window is measured with RTC (each sampling period also includes stop mode wake-up and SPI access).
+	start_time_ms = RTC_GetTimeOfDayMilliseconds();
+	// Sample RSSI until the channel has been clear during cs_min or the window expires (transceiver keeps sampling while MCU is in stop mode).
+	while (elapsed_ms < window_ms) {
+		rssi_dbm = (sfx_s16) ((-1) * SX1232_GetRssi());
+		if (rssi_dbm < cs_threshold) {
+			if (clear_duration_ms >= cs_min) {
+				(*state) = DL_PASSED;
+				break;
+			}
+			// Clear duration is counted in sampling periods, which never exceeds the real duration.
+			clear_duration_ms += RF_API_CARRIER_SENSE_SAMPLING_PERIOD_MS;
+		}
+		else {
+			clear_duration_ms = 0;
+		}
+		LPTIM1_DelayMilliseconds(RF_API_CARRIER_SENSE_SAMPLING_PERIOD_MS, 1);
+		elapsed_ms = (RTC_GetTimeOfDayMilliseconds() + RF_API_DAY_DURATION_MS - start_time_ms) % RF_API_DAY_DURATION_MS;
+	}
+	// Leave RX state as soon as possible.
+	unsigned char radio_status = RADIO_SetState(RADIO_STATE_STANDBY);
+	elapsed_ms = (RTC_GetTimeOfDayMilliseconds() + RF_API_DAY_DURATION_MS - start_time_ms) % RF_API_DAY_DURATION_MS;
+	// Update statistics.
+	rf_api_ctx.rf_api_carrier_sense_count++;
+	rf_api_ctx.rf_api_carrier_sense_last_duration_ms = (RF_API_CARRIER_SENSE_RX_STARTUP_MS + elapsed_ms);
+	rf_api_ctx.rf_api_carrier_sense_total_duration_ms += rf_api_ctx.rf_api_carrier_sense_last_duration_ms;
+	return ((radio_status != 0) ? SFX_ERR_NONE : RF_ERR_API_WAIT_CLEAR_CHANNEL);
 }
 
 /*!******************************************************************
@@ -569,3 +961,129 @@ sfx_u8 RF_API_wait_for_clear_channel(sfx_u8 cs_min, sfx_s8 cs_threshold, sfx_rx_
 sfx_u8 RF_API_get_version(sfx_u8 **version, sfx_u8 *size) {
 	return SFX_ERR_NONE;
 }
+
+/*!******************************************************************
+ * \fn void RF_API_SetCarrierSenseWindow(sfx_u16 window_ms)
+ * \brief Set maximum carrier sense window used by RF_API_wait_for_clear_channel.
+ *
+ * \param[in] sfx_u16 window_ms                 Window duration in milliseconds
+ * \param[out] none
+ *
+ * \retval none
+ *******************************************************************/
+void RF_API_SetCarrierSenseWindow(sfx_u16 window_ms) {
+	rf_api_ctx.rf_api_carrier_sense_window_ms = window_ms;
+}
+
+/*!******************************************************************
+ * \fn void RF_API_GetCarrierSenseStatistics(sfx_u32* check_count, sfx_u32* last_duration_ms, sfx_u32* total_duration_ms)
+ * \brief Get the time spent in RX for clear channel assessment since start-up.
+ *
+ * \param[in] none
+ * \param[out] sfx_u32* check_count             Number of clear channel assessments
+ * \param[out] sfx_u32* last_duration_ms        Duration of the last assessment in milliseconds
+ * \param[out] sfx_u32* total_duration_ms       Cumulated duration of all assessments in milliseconds
+ *
+ * \retval none
+ *******************************************************************/
+void RF_API_GetCarrierSenseStatistics(sfx_u32* check_count, sfx_u32* last_duration_ms, sfx_u32* total_duration_ms) {
+	(*check_count) = rf_api_ctx.rf_api_carrier_sense_count;
+	(*last_duration_ms) = rf_api_ctx.rf_api_carrier_sense_last_duration_ms;
+	(*total_duration_ms) = rf_api_ctx.rf_api_carrier_sense_total_duration_ms;
+}
+
+/*!******************************************************************
+ * \fn void RF_API_GetConfigurationStatistics(sfx_u8* image_restored, sfx_u8* registers_written, sfx_u16* duration_us)
+ * \brief Get the benchmark of the last transceiver configuration performed by RF_API_init.
+ *
+ * \param[in] none
+ * \param[out] sfx_u8* image_restored          0 if all parameters were programmed, 1 if the cached register image was restored
+ * \param[out] sfx_u8* registers_written       Number of registers written during the restore
+ * \param[out] sfx_u16* duration_us            Configuration duration in microseconds
+ *
+ * \retval none
+ *******************************************************************/
+void RF_API_GetConfigurationStatistics(sfx_u8* image_restored, sfx_u8* registers_written, sfx_u16* duration_us) {
+	(*image_restored) = rf_api_ctx.rf_api_configuration_restored;
+	(*registers_written) = rf_api_ctx.rf_api_configuration_registers_written;
+	(*duration_us) = rf_api_ctx.rf_api_configuration_duration_us;
+}
+
+/*!******************************************************************
+ * \fn void RF_API_SetDownlinkSniffing(sfx_u16 rx_slot_ms, sfx_u16 sleep_slot_ms)
+ * \brief Set duty ratio of the transceiver during the downlink window.
+ *
+ * \param[in] sfx_u16 rx_slot_ms                RX slot duration in milliseconds (30ms minimum: RX start-up and preamble detection)
+ * \param[in] sfx_u16 sleep_slot_ms             Sleep slot duration in milliseconds (16ms maximum to catch the preamble, 0 to listen continuously)
+ * \param[out] none
+ *
+ * \retval none
+ *******************************************************************/
+void RF_API_SetDownlinkSniffing(sfx_u16 rx_slot_ms, sfx_u16 sleep_slot_ms) {
+	rf_api_ctx.rf_api_sniff_rx_slot_ms = (rx_slot_ms < RF_API_SNIFF_RX_SLOT_MS_MIN) ? RF_API_SNIFF_RX_SLOT_MS_MIN : rx_slot_ms;
+	rf_api_ctx.rf_api_sniff_sleep_slot_ms = (sleep_slot_ms > RF_API_SNIFF_SLEEP_SLOT_MS_MAX) ? RF_API_SNIFF_SLEEP_SLOT_MS_MAX : sleep_slot_ms;
+}
+
+/*!******************************************************************
+ * \fn void RF_API_GetDownlinkRssi(sfx_u8* rssi_retrieved, sfx_s16* rssi)
+ * \brief Get the RSSI of the frame received during the last downlink window.
+ *
+ * \param[in] none
+ * \param[out] sfx_u8* rssi_retrieved          1 if a frame was received with a valid RSSI, 0 otherwise
+ * \param[out] sfx_s16* rssi                   RSSI in dBm
+ *
+ * \retval none
+ *******************************************************************/
+void RF_API_GetDownlinkRssi(sfx_u8* rssi_retrieved, sfx_s16* rssi) {
+	(*rssi_retrieved) = rf_api_ctx.rf_api_downlink_rssi_retrieved;
+	(*rssi) = rf_api_ctx.rf_api_downlink_rssi;
+}
+
+/*!******************************************************************
+ * \fn void RF_API_UpdateOutputPower(sfx_u8 downlink_received)
+ * \brief Update the uplink output power reduction stored in NVM according to
+ * the result of the last downlink. Must be called once the Sigfox library has
+ * returned, so that only authenticated frames decrease the output power.
+ *
+ * \param[in] sfx_u8 downlink_received          1 if the downlink frame was authenticated, 0 if it was lost
+ * \param[out] none
+ *
+ * \retval none
+ *******************************************************************/
+void RF_API_UpdateOutputPower(sfx_u8 downlink_received) {
+	// Local variables.
+	unsigned char output_power_backoff_db = NVM_GetTxPowerBackoff();
+	unsigned char new_output_power_backoff_db = 0;
+	signed short rssi = rf_api_ctx.rf_api_downlink_rssi;
+	// Step from the reduction effectively applied.
+	if (output_power_backoff_db > NVM_TX_POWER_BACKOFF_MAX_DB) {
+		output_power_backoff_db = NVM_TX_POWER_BACKOFF_MAX_DB;
+	}
+	new_output_power_backoff_db = output_power_backoff_db;
+	// Compute new reduction.
+	if (downlink_received != 0) {
+		// Keep current power if RSSI of the frame is unknown.
+		if (rf_api_ctx.rf_api_downlink_rssi_retrieved == 0) return;
+		if ((rssi >= RF_API_OUTPUT_POWER_RSSI_HIGH_DBM) && (output_power_backoff_db < NVM_TX_POWER_BACKOFF_MAX_DB)) {
+			// Comfortable margin: decrease output power.
+			new_output_power_backoff_db = output_power_backoff_db + RF_API_OUTPUT_POWER_BACKOFF_STEP_DB;
+			if (new_output_power_backoff_db > NVM_TX_POWER_BACKOFF_MAX_DB) {
+				new_output_power_backoff_db = NVM_TX_POWER_BACKOFF_MAX_DB;
+			}
+		}
+		if (rssi < RF_API_OUTPUT_POWER_RSSI_LOW_DBM) {
+			// Weak link: increase output power.
+			new_output_power_backoff_db = (output_power_backoff_db > RF_API_OUTPUT_POWER_BACKOFF_STEP_DB) ? (output_power_backoff_db - RF_API_OUTPUT_POWER_BACKOFF_STEP_DB) : 0;
+		}
+	}
+	else {
+		// Downlink lost: come back to maximum power.
+		new_output_power_backoff_db = 0;
+	}
+	// Store new value.
+	if (new_output_power_backoff_db != output_power_backoff_db) {
+		NVM_Enable();
+		NVM_SetTxPowerBackoff(new_output_power_backoff_db);
+		NVM_Disable();
+	}
+}